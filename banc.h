@@ -0,0 +1,272 @@
+/**
+* @file banc.h
+* @brief Mesures de performance comparées à une référence enregistrée
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Chaque mesure a un nom, un temps par opération, un nombre d'opérations par
+* seconde et un nombre d'allocations par opération. Une série de mesures
+* s'écrit dans un fichier texte, une mesure par ligne, champs séparés par des
+* tabulations :
+*     nom	ns_par_op	ops_par_s	allocations_par_op
+* Les lignes qui commencent par '#' sont des commentaires.
+*
+* Une série relue sert de référence : une mesure plus lente que la référence
+* de plus de la tolérance, ou qui alloue davantage, est une régression. Les
+* temps dépendent de la machine, les allocations non.
+*
+* Les allocations ne sont comptées que si BANC_ALLOCATIONS est défini à la
+* compilation (gcc -DBANC_ALLOCATIONS, version de mesure du programme) :
+* malloc, calloc et realloc sont alors remplacés par des fonctions qui
+* comptent. Ce fichier doit être inclus après les en-têtes système et avant
+* les autres en-têtes du programme, dont seules les allocations sont comptées
+* (pas celles de la bibliothèque C, comme le tampon d'un fopen). Sans
+* BANC_ALLOCATIONS, rien n'est remplacé et banc_allocations vaut toujours 0.
+*/
+
+#ifndef BANC_H
+#define BANC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define BANC_NOM 48 // longueur maximale d'un nom de mesure
+#define BANC_TOLERANCE 20 // écart de temps toléré par défaut, en pour cent
+
+//Définition d'une mesure
+typedef struct{
+	char nom[BANC_NOM]; // nom de la mesure (ex: "rejeu/niveau3")
+	double nsOp; // nanosecondes par opération
+	double opsSeconde; // opérations par seconde
+	double allocations; // allocations par opération
+} t_mesure;
+
+//Définition d'une série de mesures
+typedef struct{
+	t_mesure *mesures; // mesures dans l'ordre où elles ont été faites
+	int nb; // nombre de mesures
+	int capacite; // taille allouée du tableau
+} t_releve;
+
+static atomic_long banc_nbAllocations = 0; // allocations depuis le lancement
+static volatile int banc_puits; // reçoit les résultats mesurés : le compilateur garde la boucle
+
+#ifdef BANC_ALLOCATIONS
+#define BANC_COMPTE true // les allocations sont comptées
+
+/**
+* @brief malloc qui compte l'allocation
+* @param taille type : entier, entrée, nombre d'octets
+* @return résultat : adresse de la mémoire, NULL si elle manque
+*/
+
+static inline void *banc_malloc(size_t taille){
+	atomic_fetch_add_explicit(&banc_nbAllocations, 1, memory_order_relaxed);
+	return malloc(taille);
+}
+
+/**
+* @brief calloc qui compte l'allocation
+* @param nb type : entier, entrée, nombre d'éléments
+* @param taille type : entier, entrée, octets par élément
+* @return résultat : adresse de la mémoire mise à zéro, NULL si elle manque
+*/
+
+static inline void *banc_calloc(size_t nb, size_t taille){
+	atomic_fetch_add_explicit(&banc_nbAllocations, 1, memory_order_relaxed);
+	return calloc(nb, taille);
+}
+
+/**
+* @brief realloc qui compte l'allocation
+* @param p type : pointeur, entrée, mémoire à agrandir (NULL : nouvelle)
+* @param taille type : entier, entrée, nouvelle taille en octets
+* @return résultat : adresse de la mémoire, NULL si elle manque
+*/
+
+static inline void *banc_realloc(void *p, size_t taille){
+	atomic_fetch_add_explicit(&banc_nbAllocations, 1, memory_order_relaxed);
+	return realloc(p, taille);
+}
+
+#define malloc(taille) banc_malloc(taille)
+#define calloc(nb, taille) banc_calloc(nb, taille)
+#define realloc(p, taille) banc_realloc(p, taille)
+#else
+#define BANC_COMPTE false
+#endif
+
+/**
+* @brief donne le nombre d'allocations faites depuis le lancement
+* @return résultat : compteur d'allocations (0 sans BANC_ALLOCATIONS)
+*/
+
+static inline long banc_allocations(){
+	return atomic_load_explicit(&banc_nbAllocations, memory_order_relaxed);
+}
+
+/**
+* @brief initialise une série vide
+* @param s type : structure, sortie, série
+* @return résultat : série vide
+*/
+
+static inline void banc_init(t_releve *s){
+	s->mesures = NULL;
+	s->nb = 0;
+	s->capacite = 0;
+}
+
+/**
+* @brief libère une série
+* @param s type : structure, entrée/sortie, série
+* @return résultat : série vide
+*/
+
+static inline void banc_liberer(t_releve *s){
+	free(s->mesures);
+	banc_init(s);
+}
+
+/**
+* @brief ajoute une mesure à une série
+* @param s type : structure, entrée/sortie, série
+* @param nom type : chaine, entrée, nom de la mesure (sans espace ni tabulation)
+* @param nsOp type : réel, entrée, nanosecondes par opération
+* @param opsSeconde type : réel, entrée, opérations par seconde
+* @param allocations type : réel, entrée, allocations par opération
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool banc_ajouter(t_releve *s, const char *nom, double nsOp, double opsSeconde, double allocations){
+	t_mesure *mesures;
+	t_mesure *m;
+
+	if (s->nb == s->capacite) {
+		s->capacite = (s->capacite == 0) ? 32 : 2 * s->capacite;
+		mesures = realloc(s->mesures, s->capacite * sizeof(t_mesure));
+		if (mesures == NULL) {
+			return false;
+		}
+		s->mesures = mesures;
+	}
+	m = &s->mesures[s->nb++];
+	snprintf(m->nom, BANC_NOM, "%s", nom);
+	m->nsOp = nsOp;
+	m->opsSeconde = opsSeconde;
+	m->allocations = allocations;
+	return true;
+}
+
+/**
+* @brief cherche une mesure par son nom
+* @param s type : structure, entrée, série
+* @param nom type : chaine, entrée, nom cherché
+* @return résultat : la mesure, NULL si la série ne la contient pas
+*/
+
+static inline const t_mesure *banc_chercher(const t_releve *s, const char *nom){
+	for (int i = 0; i < s->nb; i++) {
+		if (strcmp(s->mesures[i].nom, nom) == 0) {
+			return &s->mesures[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+* @brief écrit une série, une mesure par ligne
+* @param s type : structure, entrée, série
+* @param f type : fichier, entrée/sortie, fichier ouvert en écriture
+* @return résultat : série écrite
+*/
+
+static inline void banc_ecrire(const t_releve *s, FILE *f){
+	fprintf(f, "# nom\tns_par_op\tops_par_s\tallocations_par_op\n");
+	for (int i = 0; i < s->nb; i++) {
+		fprintf(f, "%s\t%.3f\t%.1f\t%.3f\n", s->mesures[i].nom, s->mesures[i].nsOp,
+			s->mesures[i].opsSeconde, s->mesures[i].allocations);
+	}
+}
+
+/**
+* @brief relit une série écrite par banc_ecrire
+* @param s type : structure, sortie, série (initialisée par la fonction)
+* @param fichier type : chaine, entrée, fichier de référence
+* @return résultat : faux si le fichier est absent ou si la mémoire manque
+*/
+
+static inline bool banc_lire(t_releve *s, const char fichier[]){
+	FILE *f = fopen(fichier, "r");
+	char ligne[256];
+	char nom[BANC_NOM];
+	double nsOp;
+	double opsSeconde;
+	double allocations;
+	bool ok = true;
+
+	banc_init(s);
+	if (f == NULL) {
+		return false;
+	}
+	while (ok && fgets(ligne, sizeof(ligne), f) != NULL) {
+		if (ligne[0] != '#' &&
+			sscanf(ligne, "%47s %lf %lf %lf", nom, &nsOp, &opsSeconde, &allocations) == 4) {
+			ok = banc_ajouter(s, nom, nsOp, opsSeconde, allocations);
+		}
+	}
+	fclose(f);
+	return ok;
+}
+
+/**
+* @brief compare une série à sa référence et écrit une ligne par mesure :
+*     nom	ns_par_op	ns_reference	ecart_pour_cent	allocations	allocations_reference	statut
+* le statut est OK, REGRESSION, AMELIORATION ou NOUVELLE (absente de la
+* référence)
+* @param s type : structure, entrée, série mesurée
+* @param reference type : structure, entrée, série de référence
+* @param tolerance type : réel, entrée, écart de temps toléré en pour cent
+* @param f type : fichier, entrée/sortie, fichier ouvert en écriture
+* @return résultat : nombre de régressions
+*/
+
+static inline int banc_comparer(const t_releve *s, const t_releve *reference, double tolerance, FILE *f){
+	const t_mesure *m;
+	const t_mesure *r;
+	const char *statut;
+	double ecart;
+	int nbRegressions = 0;
+
+	fprintf(f, "# nom\tns_par_op\tns_reference\tecart_pour_cent\tallocations\tallocations_reference\tstatut\n");
+	for (int i = 0; i < s->nb; i++) {
+		m = &s->mesures[i];
+		r = banc_chercher(reference, m->nom);
+		if (r == NULL) {
+			fprintf(f, "%s\t%.3f\t-\t-\t%.3f\t-\tNOUVELLE\n", m->nom, m->nsOp, m->allocations);
+			continue;
+		}
+		ecart = (r->nsOp > 0) ? 100.0 * (m->nsOp - r->nsOp) / r->nsOp : 0.0;
+		// une allocation de plus par opération ne dépend pas de la machine
+		if (ecart > tolerance || m->allocations > r->allocations + 1e-3) {
+			statut = "REGRESSION";
+			nbRegressions++;
+		}
+		else if (ecart < -tolerance) {
+			statut = "AMELIORATION";
+		}
+		else {
+			statut = "OK";
+		}
+		fprintf(f, "%s\t%.3f\t%.3f\t%+.1f\t%.3f\t%.3f\t%s\n", m->nom, m->nsOp, r->nsOp, ecart,
+			m->allocations, r->allocations, statut);
+	}
+	fprintf(f, "# %d regression(s)\n", nbRegressions);
+	return nbRegressions;
+}
+
+#endif
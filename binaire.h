@@ -0,0 +1,451 @@
+/**
+* @file binaire.h
+* @brief Fichiers de déplacements binaires (.depb), 3 bits par coup
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Un fichier .dep range un caractère par coup alors qu'il n'y a que huit
+* coups possibles (g d h b G D H B) : le format binaire les range sur 3 bits,
+* ce qui divise la taille des solutions par près de trois.
+*
+* Contenu du fichier (entiers en petit boutiste) :
+*  - l'entête de BIN_ENTETE octets : "SOKB", la version, l'empreinte du niveau
+*    (0 : inconnue), le nombre de coups, de poussées et de séries d'autres
+*    caractères ;
+*  - les coups, 3 bits chacun, bits de poids faible en tête ;
+*  - les séries d'autres caractères ('u', fins de ligne...) : nombre de coups
+*    depuis la série précédente, caractère, longueur de la série (les deux
+*    nombres sur un à cinq octets de 7 bits).
+* Les séries rendent la conversion sans perte : un .dep relu est identique,
+* octet pour octet, au fichier d'origine.
+*
+* L'écriture et la lecture se font caractère par caractère avec un tampon de
+* BIN_TAMPON octets : seules les séries sont gardées en mémoire. L'entête est
+* réécrit à la fermeture et les séries, rangées à la fin, sont lues à
+* l'ouverture : le fichier doit pouvoir être parcouru avec fseek.
+*/
+
+#ifndef BINAIRE_H
+#define BINAIRE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "historique.h"
+
+#define BIN_VERSION 1
+#define BIN_ENTETE 25 // "SOKB", version, empreinte, coups, poussées, séries
+#define BIN_TAMPON 4096 // octets lus ou écrits à la fois
+#define BIN_EXTENSION ".depb"
+#define BIN_FIN -1 // plus de caractère à lire
+
+static const char bin_coups[] = "gdhbGDHB"; // caractère de chaque code de 3 bits
+
+//Définition d'une série de caractères qui ne sont pas des coups
+typedef struct{
+	uint32_t ecart; // coups depuis la série précédente
+	uint32_t longueur; // nombre de caractères de la série
+	unsigned char car; // caractère répété
+} t_serie;
+
+//Définition d'un fichier binaire ouvert en écriture ou en lecture
+typedef struct{
+	FILE *f; // fichier ouvert
+	uint64_t empreinte; // empreinte du niveau (0 : inconnue)
+	uint32_t nbCoups; // coups écrits ou annoncés par l'entête
+	uint32_t nbPoussees; // poussées parmi les coups
+	uint64_t mot; // bits en attente (écriture) ou pas encore rendus (lecture)
+	int nbBits; // nombre de bits dans mot
+	unsigned char tampon[BIN_TAMPON]; // octets de coups
+	int nbTampon; // octets du tampon écrits ou lus
+	int debutTampon; // prochain octet du tampon à rendre (lecture)
+	t_serie *series; // séries d'autres caractères
+	int nbSeries; // nombre de séries
+	int capacite; // taille allouée de series
+	int serie; // prochaine série à rendre (lecture)
+	uint32_t depuis; // coups depuis la série précédente
+	uint32_t reste; // caractères de la série en cours à rendre (lecture)
+	uint32_t lus; // coups rendus (lecture)
+	bool erreur; // mémoire ou écriture en défaut
+} t_binaire;
+
+/**
+* @brief calcule l'empreinte d'un niveau (FNV-1a 64 bits de ses dimensions et
+* de ses cases) ; elle relie un fichier binaire au niveau qu'il résout
+* @param plateau type : tableau, entrée, plateau tel que chargé
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @return résultat : empreinte, jamais 0
+*/
+
+static inline uint64_t bin_empreinte(char **plateau, int hauteur, int largeur){
+	uint64_t h = 1469598103934665603ull;
+
+	h = (h ^ (uint64_t)hauteur) * 1099511628211ull;
+	h = (h ^ (uint64_t)largeur) * 1099511628211ull;
+	for (int lig = 0; lig < hauteur; lig++) {
+		for (int col = 0; col < largeur; col++) {
+			h = (h ^ (unsigned char)plateau[lig][col]) * 1099511628211ull;
+		}
+	}
+	return h ? h : 1;
+}
+
+/**
+* @brief dit si un nom de fichier a l'extension du format binaire
+* @param fichier type : chaine, entrée, nom du fichier
+* @return résultat : vrai si le nom finit par BIN_EXTENSION
+*/
+
+static inline bool bin_extension(const char fichier[]){
+	size_t longueur = strlen(fichier);
+	size_t ext = strlen(BIN_EXTENSION);
+
+	return longueur > ext && strcmp(fichier + longueur - ext, BIN_EXTENSION) == 0;
+}
+
+/**
+* @brief écrit un entier en petit boutiste sur un nombre fixe d'octets
+* @param octets type : tableau, sortie, destination
+* @param valeur type : entier, entrée, valeur
+* @param nb type : entier, entrée, nombre d'octets
+* @return résultat : octets écrits
+*/
+
+static inline void bin_poser(unsigned char octets[], uint64_t valeur, int nb){
+	for (int i = 0; i < nb; i++) {
+		octets[i] = (unsigned char)(valeur >> (8 * i));
+	}
+}
+
+/**
+* @brief lit un entier en petit boutiste sur un nombre fixe d'octets
+* @param octets type : tableau, entrée, source
+* @param nb type : entier, entrée, nombre d'octets
+* @return résultat : valeur lue
+*/
+
+static inline uint64_t bin_prendre(const unsigned char octets[], int nb){
+	uint64_t valeur = 0;
+
+	for (int i = 0; i < nb; i++) {
+		valeur |= (uint64_t)octets[i] << (8 * i);
+	}
+	return valeur;
+}
+
+/**
+* @brief ajoute une série à la fin de la liste
+* @param b type : structure, entrée/sortie, fichier binaire
+* @param s type : structure, entrée, série
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool bin_ajouter_serie(t_binaire *b, t_serie s){
+	t_serie *series;
+
+	if (b->nbSeries == b->capacite) {
+		series = realloc(b->series, (b->capacite ? 2 * b->capacite : 16) * sizeof(t_serie));
+		if (series == NULL) {
+			return false;
+		}
+		b->series = series;
+		b->capacite = b->capacite ? 2 * b->capacite : 16;
+	}
+	b->series[b->nbSeries++] = s;
+	return true;
+}
+
+/**
+* @brief écrit l'entête à la position courante du fichier
+* @param b type : structure, entrée/sortie, fichier binaire
+* @return résultat : faux si l'écriture échoue
+*/
+
+static inline bool bin_ecrire_entete(t_binaire *b){
+	unsigned char entete[BIN_ENTETE];
+
+	memcpy(entete, "SOKB", 4);
+	entete[4] = BIN_VERSION;
+	bin_poser(&entete[5], b->empreinte, 8);
+	bin_poser(&entete[13], b->nbCoups, 4);
+	bin_poser(&entete[17], b->nbPoussees, 4);
+	bin_poser(&entete[21], b->nbSeries, 4);
+	return fwrite(entete, 1, BIN_ENTETE, b->f) == BIN_ENTETE;
+}
+
+/**
+* @brief crée un fichier binaire ; l'entête définitif est écrit à la fermeture
+* @param b type : structure, sortie, fichier binaire
+* @param fichier type : chaine, entrée, nom du fichier
+* @param empreinte type : entier, entrée, empreinte du niveau (0 : inconnue)
+* @return résultat : faux si le fichier n'a pas pu être créé
+*/
+
+static inline bool bin_creer(t_binaire *b, const char fichier[], uint64_t empreinte){
+	memset(b, 0, sizeof(t_binaire));
+	b->empreinte = empreinte;
+	b->f = fopen(fichier, "wb");
+	if (b->f == NULL) {
+		return false;
+	}
+	b->erreur = !bin_ecrire_entete(b); // réservé, réécrit par bin_fermer_ecriture
+	return !b->erreur;
+}
+
+/**
+* @brief écrit un caractère de déplacement : un coup est rangé sur 3 bits,
+* les autres caractères allongent la série en cours ou en commencent une
+* @param b type : structure, entrée/sortie, fichier créé par bin_creer
+* @param c type : caractère, entrée, caractère du fichier .dep
+* @return résultat : faux si la mémoire manque ou si l'écriture échoue
+*/
+
+static inline bool bin_ecrire(t_binaire *b, char c){
+	const char *code = c != '\0' ? strchr(bin_coups, c) : NULL;
+	t_serie *derniere = b->nbSeries > 0 ? &b->series[b->nbSeries - 1] : NULL;
+
+	if (code == NULL) {
+		if (b->depuis == 0 && derniere != NULL && derniere->car == (unsigned char)c) {
+			derniere->longueur++;
+		}
+		else if (!bin_ajouter_serie(b, (t_serie){b->depuis, 1, (unsigned char)c})) {
+			b->erreur = true;
+		}
+		b->depuis = 0;
+		return !b->erreur;
+	}
+	b->mot |= (uint64_t)(code - bin_coups) << b->nbBits;
+	b->nbBits += 3;
+	b->nbCoups++;
+	b->nbPoussees += (code - bin_coups) >= 4;
+	b->depuis++;
+	while (b->nbBits >= 8) {
+		b->tampon[b->nbTampon++] = (unsigned char)b->mot;
+		b->mot >>= 8;
+		b->nbBits -= 8;
+		if (b->nbTampon == BIN_TAMPON) {
+			b->erreur |= fwrite(b->tampon, 1, BIN_TAMPON, b->f) != BIN_TAMPON;
+			b->nbTampon = 0;
+		}
+	}
+	return !b->erreur;
+}
+
+/**
+* @brief écrit un nombre sur un à cinq octets de 7 bits (bit de poids fort :
+* un octet suit)
+* @param f type : fichier, entrée/sortie, fichier ouvert en écriture
+* @param valeur type : entier, entrée, nombre
+* @return résultat : faux si l'écriture échoue
+*/
+
+static inline bool bin_ecrire_nombre(FILE *f, uint32_t valeur){
+	while (valeur >= 0x80) {
+		if (fputc((int)(valeur & 0x7F) | 0x80, f) == EOF) {
+			return false;
+		}
+		valeur >>= 7;
+	}
+	return fputc((int)valeur, f) != EOF;
+}
+
+/**
+* @brief termine un fichier binaire : derniers bits, séries puis entête
+* @param b type : structure, entrée/sortie, fichier créé par bin_creer
+* @return résultat : faux si une écriture a échoué
+*/
+
+static inline bool bin_fermer_ecriture(t_binaire *b){
+	bool ok = !b->erreur;
+
+	if (b->nbBits > 0) {
+		b->tampon[b->nbTampon++] = (unsigned char)b->mot;
+	}
+	ok = ok && fwrite(b->tampon, 1, b->nbTampon, b->f) == (size_t)b->nbTampon;
+	for (int s = 0; ok && s < b->nbSeries; s++) {
+		ok = bin_ecrire_nombre(b->f, b->series[s].ecart) && fputc(b->series[s].car, b->f) != EOF &&
+			bin_ecrire_nombre(b->f, b->series[s].longueur);
+	}
+	ok = ok && fseek(b->f, 0, SEEK_SET) == 0 && bin_ecrire_entete(b);
+	ok = (fclose(b->f) == 0) && ok;
+	free(b->series);
+	b->series = NULL;
+	return ok;
+}
+
+/**
+* @brief lit un nombre écrit par bin_ecrire_nombre
+* @param f type : fichier, entrée/sortie, fichier ouvert en lecture
+* @param valeur type : entier, sortie, nombre lu
+* @return résultat : faux si le fichier est tronqué
+*/
+
+static inline bool bin_lire_nombre(FILE *f, uint32_t *valeur){
+	int octet;
+
+	*valeur = 0;
+	for (int decalage = 0; decalage < 35; decalage += 7) {
+		octet = fgetc(f);
+		if (octet == EOF) {
+			return false;
+		}
+		*valeur |= (uint32_t)(octet & 0x7F) << decalage;
+		if (octet < 0x80) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+* @brief ouvre un fichier binaire : lit l'entête et les séries, puis se
+* place au début des coups
+* @param b type : structure, sortie, fichier binaire
+* @param fichier type : chaine, entrée, nom du fichier
+* @return résultat : faux si le fichier est absent, n'est pas au format
+	binaire ou est tronqué (un .dep texte donne faux)
+*/
+
+static inline bool bin_ouvrir(t_binaire *b, const char fichier[]){
+	unsigned char entete[BIN_ENTETE];
+	uint32_t nbSeries;
+	t_serie s;
+	int car;
+	bool ok;
+
+	memset(b, 0, sizeof(t_binaire));
+	b->f = fopen(fichier, "rb");
+	if (b->f == NULL) {
+		return false;
+	}
+	ok = fread(entete, 1, BIN_ENTETE, b->f) == BIN_ENTETE && memcmp(entete, "SOKB", 4) == 0 &&
+		entete[4] == BIN_VERSION;
+	if (ok) {
+		b->empreinte = bin_prendre(&entete[5], 8);
+		b->nbCoups = bin_prendre(&entete[13], 4);
+		b->nbPoussees = bin_prendre(&entete[17], 4);
+		nbSeries = bin_prendre(&entete[21], 4);
+		ok = fseek(b->f, BIN_ENTETE + ((uint64_t)b->nbCoups * 3 + 7) / 8, SEEK_SET) == 0;
+		for (uint32_t i = 0; ok && i < nbSeries; i++) {
+			ok = bin_lire_nombre(b->f, &s.ecart) && (car = fgetc(b->f)) != EOF &&
+				bin_lire_nombre(b->f, &s.longueur);
+			s.car = (unsigned char)car;
+			ok = ok && bin_ajouter_serie(b, s);
+		}
+		ok = ok && fseek(b->f, BIN_ENTETE, SEEK_SET) == 0;
+	}
+	if (!ok) {
+		fclose(b->f);
+		free(b->series);
+		memset(b, 0, sizeof(t_binaire));
+	}
+	return ok;
+}
+
+/**
+* @brief rend le caractère suivant, dans l'ordre du fichier .dep d'origine
+* @param b type : structure, entrée/sortie, fichier ouvert par bin_ouvrir
+* @return résultat : le caractère, BIN_FIN à la fin ou si le fichier est tronqué
+*/
+
+static inline int bin_lire(t_binaire *b){
+	int code;
+
+	// série qui commence avant le coup suivant
+	if (b->reste == 0 && b->serie < b->nbSeries && b->series[b->serie].ecart == b->depuis) {
+		b->reste = b->series[b->serie].longueur;
+		b->serie++;
+		b->depuis = 0;
+	}
+	if (b->reste > 0) {
+		b->reste--;
+		return b->series[b->serie - 1].car;
+	}
+	if (b->lus == b->nbCoups) {
+		return BIN_FIN;
+	}
+	if (b->nbBits < 3) {
+		if (b->debutTampon == b->nbTampon) {
+			b->nbTampon = fread(b->tampon, 1, BIN_TAMPON, b->f);
+			b->debutTampon = 0;
+			if (b->nbTampon == 0) {
+				return BIN_FIN;
+			}
+		}
+		b->mot |= (uint64_t)b->tampon[b->debutTampon++] << b->nbBits;
+		b->nbBits += 8;
+	}
+	code = b->mot & 7;
+	b->mot >>= 3;
+	b->nbBits -= 3;
+	b->lus++;
+	b->depuis++;
+	return bin_coups[code];
+}
+
+/**
+* @brief ferme un fichier ouvert par bin_ouvrir
+* @param b type : structure, entrée/sortie, fichier binaire
+* @return résultat : fichier fermé, séries libérées
+*/
+
+static inline void bin_fermer_lecture(t_binaire *b){
+	fclose(b->f);
+	free(b->series);
+	memset(b, 0, sizeof(t_binaire));
+}
+
+/**
+* @brief écrit tout un historique dans un fichier binaire
+* @param h type : structure, entrée, historique des déplacements
+* @param fichier type : chaine, entrée, nom du fichier .depb
+* @param empreinte type : entier, entrée, empreinte du niveau (0 : inconnue)
+* @return résultat : faux si le fichier n'a pas pu être écrit
+*/
+
+static inline bool bin_enregistrer(const t_historique *h, const char fichier[], uint64_t empreinte){
+	t_binaire b;
+	bool ok = bin_creer(&b, fichier, empreinte);
+
+	if (b.f == NULL) {
+		return false;
+	}
+	for (int i = 0; ok && i < h->nb; i++) {
+		ok = bin_ecrire(&b, hist_lire(h, i));
+	}
+	return bin_fermer_ecriture(&b) && ok;
+}
+
+/**
+* @brief charge un fichier binaire dans un historique, sans passer par le texte
+* @param h type : structure, entrée/sortie, historique vidé puis rempli
+* @param fichier type : chaine, entrée, nom du fichier .depb
+* @param empreinte type : entier, sortie, empreinte du niveau lue dans l'entête
+* @return résultat : faux si le fichier n'est pas un fichier binaire lisible
+	ou si la mémoire manque
+*/
+
+static inline bool bin_charger(t_historique *h, const char fichier[], uint64_t *empreinte){
+	t_binaire b;
+	int c;
+	bool ok = true;
+
+	if (!bin_ouvrir(&b, fichier)) {
+		return false;
+	}
+	*empreinte = b.empreinte;
+	hist_vider(h);
+	while (ok && (c = bin_lire(&b)) != BIN_FIN) {
+		ok = hist_ajouter(h, (char)c);
+	}
+	// fichier tronqué : moins de coups que l'entête n'en annonce
+	ok = ok && b.lus == b.nbCoups && b.serie == b.nbSeries;
+	bin_fermer_lecture(&b);
+	return ok;
+}
+
+#endif
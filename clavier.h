@@ -0,0 +1,123 @@
+/**
+* @file clavier.h
+* @brief Lecture des touches sans attente active
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Le terminal passe une seule fois en mode brut (sans écho, touche par
+* touche) au début de la partie. Son réglage d'origine est remis à la sortie
+* du programme (atexit) et à la réception d'un signal d'arrêt, puis le signal
+* reprend son effet normal. Les touches sont attendues avec poll : le
+* programme dort tant que rien n'est tapé, avec un délai facultatif pour les
+* fonctions qui doivent avancer seules.
+*
+* Les questions posées avec scanf repassent le terminal en mode normal le
+* temps de la réponse (clavier_normal, puis clavier_brut).
+*/
+
+#ifndef CLAVIER_H
+#define CLAVIER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+#include <poll.h>
+
+#define CLAVIER_INFINI -1 // attendre une touche sans limite de temps
+#define CLAVIER_AUCUNE -1 // délai écoulé sans touche
+#define CLAVIER_FIN -2 // entrée fermée ou illisible
+
+static struct termios clavier_origine; // réglage du terminal au lancement
+static volatile sig_atomic_t clavier_actif = 0; // le mode brut est en place
+static bool clavier_prepare = false; // réglage d'origine lu, sorties prévues
+
+/**
+* @brief remet le terminal dans son réglage d'origine ; sans effet s'il n'est
+* pas en mode brut. Peut être appelée depuis un gestionnaire de signal.
+* @return résultat : terminal restauré
+*/
+
+static inline void clavier_normal(){
+	if (clavier_actif) {
+		tcsetattr(STDIN_FILENO, TCSANOW, &clavier_origine);
+		clavier_actif = 0;
+	}
+}
+
+/**
+* @brief gestionnaire des signaux d'arrêt : restaure le terminal puis laisse
+* le signal agir normalement
+* @param signal type : entier, entrée, numéro du signal
+* @return résultat : le programme s'arrête comme sans gestionnaire
+*/
+
+static inline void clavier_signal(int signal){
+	clavier_normal();
+	sigaction(signal, &(struct sigaction){.sa_handler = SIG_DFL}, NULL);
+	raise(signal);
+}
+
+/**
+* @brief passe le terminal en mode brut ; au premier appel, garde le réglage
+* d'origine et prévoit sa remise en place à la sortie et sur signal
+* @return résultat : faux si l'entrée n'est pas un terminal (les touches sont
+	alors lues telles quelles)
+*/
+
+static inline bool clavier_brut(){
+	struct termios brut;
+	struct sigaction action = {.sa_handler = clavier_signal};
+	const int signaux[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT};
+
+	if (!clavier_prepare) {
+		if (tcgetattr(STDIN_FILENO, &clavier_origine) < 0) {
+			return false;
+		}
+		clavier_prepare = true;
+		atexit(clavier_normal);
+		sigemptyset(&action.sa_mask);
+		for (size_t i = 0; i < sizeof(signaux) / sizeof(signaux[0]); i++) {
+			sigaction(signaux[i], &action, NULL);
+		}
+	}
+	brut = clavier_origine;
+	brut.c_lflag &= ~(ICANON | ECHO);
+	brut.c_cc[VMIN] = 1;
+	brut.c_cc[VTIME] = 0;
+	if (tcsetattr(STDIN_FILENO, TCSANOW, &brut) < 0) {
+		return false;
+	}
+	clavier_actif = 1;
+	return true;
+}
+
+/**
+* @brief attend une touche en dormant dans poll
+* @param delai type : entier, entrée, délai en millisecondes (CLAVIER_INFINI : aucun)
+* @return résultat : la touche lue, CLAVIER_AUCUNE si le délai est écoulé,
+	CLAVIER_FIN si l'entrée est fermée
+*/
+
+static inline int clavier_attendre(int delai){
+	struct pollfd entree = {.fd = STDIN_FILENO, .events = POLLIN};
+	unsigned char touche;
+	int nb;
+
+	do {
+		nb = poll(&entree, 1, delai);
+	} while (nb < 0 && errno == EINTR);
+	if (nb == 0) {
+		return CLAVIER_AUCUNE;
+	}
+	if (nb < 0 || read(STDIN_FILENO, &touche, 1) != 1) {
+		return CLAVIER_FIN;
+	}
+	return touche;
+}
+
+#endif
@@ -0,0 +1,286 @@
+/**
+* @file compteurs.h
+* @brief Compteurs de performance, écrits en JSON à la sortie ou sur signal
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Chaque compteur a un nombre (coups, octets...) et une durée cumulée en
+* nanosecondes. Chaque thread écrit dans son propre bloc de compteurs, sans
+* instruction atomique coûteuse ni partage de ligne de cache : les compteurs
+* peuvent rester actifs en permanence. Les blocs sont additionnés au moment
+* de l'écriture.
+*
+* Les appels très fréquents (gagner) ne sont ni chronométrés ni comptés un
+* par un : l'appelant ajoute d'un bloc le nombre de tests d'une suite de coups
+* et la durée de la boucle qui joue cette suite. Cette durée comprend donc les
+* coups eux-mêmes : c'est une borne haute du temps passé dans gagner.
+*
+* Si la variable d'environnement SOKOBAN_COMPTEURS donne un nom de fichier
+* ("-" : sortie d'erreur), les compteurs y sont écrits à la fin du programme
+* et à chaque signal SIGUSR1, sans arrêter le programme. L'écriture n'utilise
+* que des fonctions permises dans un gestionnaire de signal.
+*/
+
+#ifndef COMPTEURS_H
+#define COMPTEURS_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CPT_BLOCS 264 // blocs de compteurs : un par thread
+#define CPT_JSON 4096 // taille maximale du texte JSON
+
+// Compteurs disponibles.
+#define CPT_COUPS 0 // déplacements appliqués
+#define CPT_POUSSEES 1 // caisses poussées
+#define CPT_ANNULATIONS 2 // coups annulés
+#define CPT_REFAITS 3 // coups refaits
+#define CPT_IMAGES 4 // images affichées (durée : différence et write)
+#define CPT_OCTETS 5 // octets envoyés au terminal
+#define CPT_NIVEAUX 6 // niveaux chargés (durée : lecture et analyse)
+#define CPT_FICHIERS_DEP 7 // fichiers de déplacements lus
+#define CPT_GAGNER 8 // tests de victoire (durée : boucles de coups qui les font)
+#define CPT_REJEUX 9 // couples niveau / déplacements analysés
+#define CPT_NB 10
+
+static const char *cpt_noms[CPT_NB] = {"coups", "poussees", "annulations", "refaits", "images",
+	"octets_terminal", "chargements_niveau", "chargements_deplacements", "gagner", "rejeux"};
+
+//Définition d'un bloc de compteurs, seul sur sa ligne de cache
+typedef struct{
+	alignas(64) atomic_uint_fast64_t nombres[CPT_NB]; // nombre de chaque compteur
+	atomic_uint_fast64_t ns[CPT_NB]; // durée cumulée en nanosecondes
+} t_compteurs;
+
+static t_compteurs cpt_blocs[CPT_BLOCS]; // blocs des threads
+static atomic_int cpt_nbBlocs = 0; // blocs déjà attribués
+static _Thread_local t_compteurs *cpt_bloc = NULL; // bloc du thread courant
+static const char *cpt_programme = ""; // nom écrit dans le JSON
+static const char *cpt_fichier = NULL; // destination (NULL : aucune)
+static uint64_t cpt_lancement = 0; // heure du lancement en nanosecondes
+
+/**
+* @brief donne l'heure d'une horloge monotone
+* @return résultat : temps en nanosecondes
+*/
+
+static inline uint64_t cpt_maintenant(){
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+
+/**
+* @brief donne le bloc de compteurs du thread, attribué à son premier appel
+* (les threads en trop partagent le dernier bloc)
+* @return résultat : bloc du thread
+*/
+
+static inline t_compteurs *cpt_local(){
+	int i;
+
+	if (cpt_bloc == NULL) {
+		i = atomic_fetch_add_explicit(&cpt_nbBlocs, 1, memory_order_relaxed);
+		cpt_bloc = &cpt_blocs[i < CPT_BLOCS ? i : CPT_BLOCS - 1];
+	}
+	return cpt_bloc;
+}
+
+/**
+* @brief ajoute à un compteur du thread (lecture puis écriture simples : seul
+* le thread écrit dans son bloc)
+* @param c type : entier, entrée, compteur (CPT_...)
+* @param nb type : entier, entrée, quantité ajoutée
+* @return résultat : compteur augmenté
+*/
+
+static inline void cpt_ajouter(int c, uint64_t nb){
+	t_compteurs *b = cpt_local();
+
+	atomic_store_explicit(&b->nombres[c],
+		atomic_load_explicit(&b->nombres[c], memory_order_relaxed) + nb, memory_order_relaxed);
+}
+
+/**
+* @brief ajoute une durée à un compteur du thread
+* @param c type : entier, entrée, compteur (CPT_...)
+* @param ns type : entier, entrée, durée en nanosecondes
+* @return résultat : durée cumulée augmentée
+*/
+
+static inline void cpt_duree(int c, uint64_t ns){
+	t_compteurs *b = cpt_local();
+
+	atomic_store_explicit(&b->ns[c],
+		atomic_load_explicit(&b->ns[c], memory_order_relaxed) + ns, memory_order_relaxed);
+}
+
+/**
+* @brief termine une opération chronométrée : le compteur augmente de un et
+* la durée depuis debut est ajoutée
+* @param c type : entier, entrée, compteur (CPT_...)
+* @param debut type : entier, entrée, heure donnée par cpt_maintenant
+* @return résultat : compteur et durée augmentés
+*/
+
+static inline void cpt_fin(int c, uint64_t debut){
+	cpt_ajouter(c, 1);
+	cpt_duree(c, cpt_maintenant() - debut);
+}
+
+/**
+* @brief écrit un entier en décimal (sans printf, pour le gestionnaire de signal)
+* @param texte type : chaine, entrée/sortie, texte en construction
+* @param nb type : entier, entrée/sortie, longueur du texte
+* @param valeur type : entier, entrée, nombre à écrire
+* @return résultat : nombre ajouté s'il reste de la place
+*/
+
+static inline void cpt_ecrire_nombre(char texte[], int *nb, uint64_t valeur){
+	char chiffres[24];
+	int n = 0;
+
+	do {
+		chiffres[n++] = (char)('0' + valeur % 10);
+		valeur /= 10;
+	} while (valeur > 0);
+	while (n > 0 && *nb < CPT_JSON - 1) {
+		texte[(*nb)++] = chiffres[--n];
+	}
+}
+
+/**
+* @brief ajoute une chaine au texte
+* @param texte type : chaine, entrée/sortie, texte en construction
+* @param nb type : entier, entrée/sortie, longueur du texte
+* @param chaine type : chaine, entrée, chaine à ajouter
+* @return résultat : chaine ajoutée s'il reste de la place
+*/
+
+static inline void cpt_ecrire_texte(char texte[], int *nb, const char *chaine){
+	while (*chaine != '\0' && *nb < CPT_JSON - 1) {
+		texte[(*nb)++] = *chaine++;
+	}
+}
+
+/**
+* @brief construit le JSON des compteurs, tous threads additionnés :
+* {"programme": "...", "pid": 1, "duree_ns": 2, "compteurs": {"coups":
+* {"nombre": 3, "ns": 4}, ...}}
+* @param texte type : chaine, sortie, CPT_JSON octets
+* @return résultat : longueur du texte
+*/
+
+static inline int cpt_json(char texte[]){
+	uint64_t nombre;
+	uint64_t ns;
+	int nbBlocs = atomic_load_explicit(&cpt_nbBlocs, memory_order_relaxed);
+	int nb = 0;
+
+	nbBlocs = nbBlocs < CPT_BLOCS ? nbBlocs : CPT_BLOCS;
+	cpt_ecrire_texte(texte, &nb, "{\"programme\": \"");
+	cpt_ecrire_texte(texte, &nb, cpt_programme);
+	cpt_ecrire_texte(texte, &nb, "\", \"pid\": ");
+	cpt_ecrire_nombre(texte, &nb, (uint64_t)getpid());
+	cpt_ecrire_texte(texte, &nb, ", \"duree_ns\": ");
+	cpt_ecrire_nombre(texte, &nb, cpt_maintenant() - cpt_lancement);
+	cpt_ecrire_texte(texte, &nb, ", \"compteurs\": {");
+	for (int c = 0; c < CPT_NB; c++) {
+		nombre = 0;
+		ns = 0;
+		for (int i = 0; i < nbBlocs; i++) {
+			nombre += atomic_load_explicit(&cpt_blocs[i].nombres[c], memory_order_relaxed);
+			ns += atomic_load_explicit(&cpt_blocs[i].ns[c], memory_order_relaxed);
+		}
+		cpt_ecrire_texte(texte, &nb, c > 0 ? ", \"" : "\"");
+		cpt_ecrire_texte(texte, &nb, cpt_noms[c]);
+		cpt_ecrire_texte(texte, &nb, "\": {\"nombre\": ");
+		cpt_ecrire_nombre(texte, &nb, nombre);
+		cpt_ecrire_texte(texte, &nb, ", \"ns\": ");
+		cpt_ecrire_nombre(texte, &nb, ns);
+		cpt_ecrire_texte(texte, &nb, "}");
+	}
+	cpt_ecrire_texte(texte, &nb, "}}\n");
+	return nb;
+}
+
+/**
+* @brief écrit le JSON des compteurs dans la destination choisie au lancement
+* (le fichier est remplacé à chaque écriture)
+* @return résultat : compteurs écrits, rien si aucune destination
+*/
+
+static inline void cpt_ecrire(){
+	char texte[CPT_JSON];
+	int nb;
+	int fd;
+	ssize_t ecrits;
+
+	if (cpt_fichier == NULL) {
+		return;
+	}
+	nb = cpt_json(texte);
+	fd = (strcmp(cpt_fichier, "-") == 0) ? STDERR_FILENO : open(cpt_fichier, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return;
+	}
+	for (int envoyes = 0; envoyes < nb; envoyes += (int)ecrits) {
+		ecrits = write(fd, texte + envoyes, nb - envoyes);
+		if (ecrits <= 0) {
+			break;
+		}
+	}
+	if (fd != STDERR_FILENO) {
+		close(fd);
+	}
+}
+
+/**
+* @brief gestionnaire de SIGUSR1 : écrit les compteurs, le programme continue
+* @param signal type : entier, entrée, numéro du signal
+* @return résultat : compteurs écrits
+*/
+
+static inline void cpt_signal(int signal){
+	int erreur = errno; // write peut changer errno du code interrompu
+
+	(void)signal;
+	cpt_ecrire();
+	errno = erreur;
+}
+
+/**
+* @brief note le lancement du programme ; si SOKOBAN_COMPTEURS est défini,
+* prévoit l'écriture des compteurs à la sortie et sur SIGUSR1
+* @param programme type : chaine, entrée, nom du programme écrit dans le JSON
+* @return résultat : compteurs prêts
+*/
+
+static inline void cpt_demarrer(const char *programme){
+	struct sigaction action = {.sa_handler = cpt_signal, .sa_flags = SA_RESTART};
+
+	cpt_programme = programme;
+	cpt_lancement = cpt_maintenant();
+	cpt_fichier = getenv("SOKOBAN_COMPTEURS");
+	if (cpt_fichier != NULL && cpt_fichier[0] != '\0') {
+		atexit(cpt_ecrire);
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGUSR1, &action, NULL);
+	}
+	else {
+		cpt_fichier = NULL;
+	}
+}
+
+#endif
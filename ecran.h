@@ -0,0 +1,335 @@
+/**
+* @file ecran.h
+* @brief Affichage du terminal par différence entre deux images
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* L'image (entête et plateau) est construite dans un tableau de caractères
+* puis comparée à celle qui est à l'écran. Seules les cases qui ont changé
+* sont envoyées, précédées d'un déplacement du curseur (séquence ANSI), le
+* tout en un seul write. Il n'y a plus de system("clear") à chaque image :
+* pas de processus lancé par touche et pas de clignotement.
+*
+* Les lignes qui contiennent des caractères accentués (plusieurs octets pour
+* une colonne) sont réécrites depuis le premier octet changé jusqu'au bout,
+* puis le reste de la ligne est effacé. Les lignes du plateau n'ont que des
+* caractères ASCII et sont envoyées case par case.
+*/
+
+#ifndef ECRAN_H
+#define ECRAN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define ECRAN_ECART 4 // cases inchangées réécrites plutôt que de déplacer le curseur
+
+//Définition de l'écran
+typedef struct{
+	char *image; // image en construction, lignes * colonnes octets
+	char *affichee; // image à l'écran
+	int lignes; // lignes allouées des deux images
+	int colonnes; // colonnes allouées des deux images
+	int lig; // ligne d'écriture dans l'image
+	int col; // colonne (octet) d'écriture dans l'image
+	int hauteur; // lignes écrites dans l'image
+	char *sortie; // séquences envoyées au terminal
+	size_t nbSortie; // octets de la sortie
+	size_t capaciteSortie; // taille allouée de la sortie
+	bool complet; // la prochaine image efface l'écran et est envoyée entièrement
+	double duree; // durée du dernier ecran_afficher en microsecondes
+} t_ecran;
+
+/**
+* @brief prépare un écran vide ; la première image efface le terminal
+* @param e type : structure, sortie, écran
+* @return résultat : écran prêt, rien n'est alloué
+*/
+
+static inline void ecran_init(t_ecran *e){
+	memset(e, 0, sizeof(t_ecran));
+	e->complet = true;
+}
+
+/**
+* @brief libère la mémoire de l'écran
+* @param e type : structure, entrée/sortie, écran
+* @return résultat : mémoire libérée
+*/
+
+static inline void ecran_liberer(t_ecran *e){
+	free(e->image);
+	free(e->affichee);
+	free(e->sortie);
+	ecran_init(e);
+}
+
+/**
+* @brief agrandit les deux images, les nouvelles cases sont des espaces
+* @param e type : structure, entrée/sortie, écran
+* @param lignes type : entier, entrée, lignes nécessaires
+* @param colonnes type : entier, entrée, colonnes nécessaires
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool ecran_agrandir(t_ecran *e, int lignes, int colonnes){
+	char *image;
+	char *affichee;
+
+	if (lignes <= e->lignes && colonnes <= e->colonnes) {
+		return true;
+	}
+	lignes = lignes > e->lignes ? (lignes > 2 * e->lignes ? lignes : 2 * e->lignes) : e->lignes;
+	colonnes = colonnes > e->colonnes ? (colonnes > 2 * e->colonnes ? colonnes : 2 * e->colonnes) : e->colonnes;
+	image = malloc((size_t)lignes * colonnes);
+	affichee = malloc((size_t)lignes * colonnes);
+	if (image == NULL || affichee == NULL) {
+		free(image);
+		free(affichee);
+		return false;
+	}
+	memset(image, ' ', (size_t)lignes * colonnes);
+	memset(affichee, ' ', (size_t)lignes * colonnes);
+	for (int l = 0; l < e->lignes; l++) {
+		memcpy(&image[(size_t)l * colonnes], &e->image[(size_t)l * e->colonnes], e->colonnes);
+		memcpy(&affichee[(size_t)l * colonnes], &e->affichee[(size_t)l * e->colonnes], e->colonnes);
+	}
+	free(e->image);
+	free(e->affichee);
+	e->image = image;
+	e->affichee = affichee;
+	e->lignes = lignes;
+	e->colonnes = colonnes;
+	return true;
+}
+
+/**
+* @brief commence une nouvelle image vide
+* @param e type : structure, entrée/sortie, écran
+* @return résultat : image effacée, écriture en haut à gauche
+*/
+
+static inline void ecran_debut(t_ecran *e){
+	if (e->image != NULL) {
+		memset(e->image, ' ', (size_t)e->lignes * e->colonnes);
+	}
+	e->lig = 0;
+	e->col = 0;
+	e->hauteur = 0;
+}
+
+/**
+* @brief écrit un caractère dans l'image ('\n' passe à la ligne suivante)
+* @param e type : structure, entrée/sortie, écran
+* @param c type : caractère, entrée, caractère (ou octet d'un caractère UTF-8)
+* @return résultat : caractère écrit, ignoré si la mémoire manque
+*/
+
+static inline void ecran_car(t_ecran *e, char c){
+	if (c == '\n') {
+		e->lig++;
+		e->col = 0;
+		return;
+	}
+	if (!ecran_agrandir(e, e->lig + 1, e->col + 1)) {
+		return;
+	}
+	e->image[(size_t)e->lig * e->colonnes + e->col++] = c;
+	if (e->lig + 1 > e->hauteur) {
+		e->hauteur = e->lig + 1;
+	}
+}
+
+/**
+* @brief écrit un texte mis en forme dans l'image, comme printf
+* @param e type : structure, entrée/sortie, écran
+* @param format type : chaine, entrée, format de printf
+* @return résultat : texte écrit
+*/
+
+static inline void ecran_printf(t_ecran *e, const char *format, ...){
+	char texte[512];
+	va_list args;
+	int nb;
+
+	va_start(args, format);
+	nb = vsnprintf(texte, sizeof(texte), format, args);
+	va_end(args);
+	if (nb > (int)sizeof(texte) - 1) {
+		nb = sizeof(texte) - 1; // texte tronqué
+	}
+	for (int i = 0; i < nb; i++) {
+		ecran_car(e, texte[i]);
+	}
+}
+
+/**
+* @brief ajoute des octets à la sortie
+* @param e type : structure, entrée/sortie, écran
+* @param texte type : chaine, entrée, octets à ajouter
+* @param nb type : entier, entrée, nombre d'octets
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool ecran_ajouter(t_ecran *e, const char *texte, size_t nb){
+	char *sortie;
+
+	if (e->nbSortie + nb > e->capaciteSortie) {
+		e->capaciteSortie = 2 * (e->nbSortie + nb) + 256;
+		sortie = realloc(e->sortie, e->capaciteSortie);
+		if (sortie == NULL) {
+			return false;
+		}
+		e->sortie = sortie;
+	}
+	memcpy(&e->sortie[e->nbSortie], texte, nb);
+	e->nbSortie += nb;
+	return true;
+}
+
+/**
+* @brief place le curseur du terminal
+* @param e type : structure, entrée/sortie, écran
+* @param lig type : entier, entrée, ligne (0 en haut)
+* @param col type : entier, entrée, colonne à l'écran (0 à gauche)
+* @return résultat : séquence ajoutée à la sortie
+*/
+
+static inline bool ecran_curseur(t_ecran *e, int lig, int col){
+	char sequence[32];
+	int nb = snprintf(sequence, sizeof(sequence), "\033[%d;%dH", lig + 1, col + 1);
+
+	return ecran_ajouter(e, sequence, nb);
+}
+
+/**
+* @brief compare une ligne de l'image à celle de l'écran et ajoute à la
+* sortie ce qui a changé
+* @param e type : structure, entrée/sortie, écran
+* @param l type : entier, entrée, ligne
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool ecran_ligne(t_ecran *e, int l){
+	const char *nouvelle = &e->image[(size_t)l * e->colonnes];
+	const char *ancienne = &e->affichee[(size_t)l * e->colonnes];
+	bool accents = false;
+	bool ok = true;
+	int debut = 0;
+	int fin;
+	int colonne;
+
+	while (debut < e->colonnes && nouvelle[debut] == ancienne[debut]) {
+		debut++;
+	}
+	if (debut == e->colonnes) {
+		return true; // ligne inchangée
+	}
+	for (int i = 0; i < e->colonnes && !accents; i++) {
+		accents = (unsigned char)nouvelle[i] >= 0x80 || (unsigned char)ancienne[i] >= 0x80;
+	}
+	if (accents) {
+		// début du caractère, colonne à l'écran sans les octets de suite UTF-8
+		while (debut > 0 && ((unsigned char)nouvelle[debut] & 0xC0) == 0x80) {
+			debut--;
+		}
+		colonne = 0;
+		for (int i = 0; i < debut; i++) {
+			colonne += ((unsigned char)nouvelle[i] & 0xC0) != 0x80;
+		}
+		for (fin = e->colonnes; fin > debut && nouvelle[fin - 1] == ' '; fin--);
+		ok = ecran_curseur(e, l, colonne) && ecran_ajouter(e, &nouvelle[debut], fin - debut) &&
+			ecran_ajouter(e, "\033[K", 3);
+		return ok;
+	}
+	// suites de cases changées ; un petit écart est réécrit tel quel
+	while (ok && debut < e->colonnes) {
+		fin = debut + 1;
+		for (int i = fin; i < e->colonnes && i - fin < ECRAN_ECART; i++) {
+			if (nouvelle[i] != ancienne[i]) {
+				fin = i + 1;
+			}
+		}
+		ok = ecran_curseur(e, l, debut) && ecran_ajouter(e, &nouvelle[debut], fin - debut);
+		for (debut = fin; debut < e->colonnes && nouvelle[debut] == ancienne[debut]; debut++);
+	}
+	return ok;
+}
+
+/**
+* @brief envoie au terminal les différences entre l'image construite et
+* l'écran, en un seul write, puis place le curseur sous l'image
+* @param e type : structure, entrée/sortie, écran
+* @return résultat : faux si la mémoire manque ou si l'écriture échoue
+*/
+
+static inline bool ecran_afficher(t_ecran *e){
+	struct timespec t0;
+	struct timespec t1;
+	char *echange;
+	size_t envoyes = 0;
+	ssize_t nb;
+	bool ok = true;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	e->nbSortie = 0;
+	if (e->complet) {
+		ok = ecran_ajouter(e, "\033[H\033[2J", 7);
+		if (e->affichee != NULL) {
+			memset(e->affichee, ' ', (size_t)e->lignes * e->colonnes);
+		}
+		e->complet = false;
+	}
+	for (int l = 0; ok && l < e->lignes; l++) {
+		ok = ecran_ligne(e, l);
+	}
+	ok = ok && ecran_curseur(e, e->hauteur, 0);
+	// ce que printf garde encore doit partir avant l'image
+	fflush(stdout);
+	while (ok && envoyes < e->nbSortie) {
+		nb = write(STDOUT_FILENO, &e->sortie[envoyes], e->nbSortie - envoyes);
+		ok = nb > 0;
+		envoyes += ok ? (size_t)nb : 0;
+	}
+	// l'image envoyée devient celle de l'écran
+	echange = e->affichee;
+	e->affichee = e->image;
+	e->image = echange;
+	if (!ok) {
+		e->complet = true;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	e->duree = (t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3;
+	return ok;
+}
+
+/**
+* @brief demande que la prochaine image soit entièrement redessinée, après
+* un texte écrit par printf (question, message) qui a changé l'écran
+* @param e type : structure, entrée/sortie, écran
+* @return résultat : prochaine image complète
+*/
+
+static inline void ecran_effacer(t_ecran *e){
+	e->complet = true;
+}
+
+/**
+* @brief efface le terminal sans lancer de processus
+* @return résultat : terminal effacé, curseur en haut à gauche
+*/
+
+static inline void ecran_nettoyer(){
+	fflush(stdout);
+	if (write(STDOUT_FILENO, "\033[H\033[2J", 7) < 0) {
+		return;
+	}
+}
+
+#endif
@@ -0,0 +1,288 @@
+/**
+* @file etat.h
+* @brief Codage compact d'un état de sokoban
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Un état (cases des caisses et case du joueur) est rangé en quelques octets
+* au lieu d'une copie du plateau. Les cases qui ne sont pas des murs sont
+* numérotées de 0 à nbLibres - 1 et chaque numéro est écrit sur le plus petit
+* nombre de bits qui les contient tous : d'abord le joueur, puis les caisses
+* triées par case croissante. L'ordre des caisses ne compte donc pas.
+*
+* Le joueur est ramené à la plus petite case (la plus haute, puis la plus à
+* gauche) de la zone qu'il atteint sans pousser : deux états qui ne diffèrent
+* que par l'endroit où le joueur a marché ont le même codage.
+*
+* Les cases sont numérotées lig * largeur + col, comme dans le solveur.
+*/
+
+#ifndef ETAT_H
+#define ETAT_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+//Définition du codage des états d'un niveau
+typedef struct{
+	int hauteur; // nombre de lignes
+	int largeur; // nombre de colonnes
+	int nbCases; // hauteur * largeur
+	int nbCaisses; // nombre de caisses
+	int nbLibres; // nombre de cases qui ne sont pas des murs
+	int *rang; // numéro de chaque case parmi les cases libres (-1 : mur)
+	int *cases; // case de chaque numéro
+	bool *cible; // la case est une cible
+	int bits; // bits par numéro de case
+	int octets; // octets par état codé
+	int *file; // parcours en largeur de etat_depuis_plateau
+	bool *vu; // cases atteintes par ce parcours
+} t_codage;
+
+/**
+* @brief prépare le codage des états d'un plateau de caractères
+* @param c type : structure, sortie, codage
+* @param plateau type : tableau, entrée, plateau de caractères
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool etat_init(t_codage *c, char **plateau, int hauteur, int largeur){
+	char car;
+
+	memset(c, 0, sizeof(t_codage));
+	c->hauteur = hauteur;
+	c->largeur = largeur;
+	c->nbCases = hauteur * largeur;
+	c->rang = malloc(c->nbCases * sizeof(int));
+	c->cases = malloc(c->nbCases * sizeof(int));
+	c->cible = calloc(c->nbCases, sizeof(bool));
+	c->file = malloc(c->nbCases * sizeof(int));
+	c->vu = malloc(c->nbCases * sizeof(bool));
+	if (c->rang == NULL || c->cases == NULL || c->cible == NULL || c->file == NULL || c->vu == NULL) {
+		return false;
+	}
+	for (int lig = 0; lig < hauteur; lig++) {
+		for (int col = 0; col < largeur; col++) {
+			car = plateau[lig][col];
+			c->rang[lig * largeur + col] = -1;
+			if (car != '#') {
+				c->rang[lig * largeur + col] = c->nbLibres;
+				c->cases[c->nbLibres++] = lig * largeur + col;
+			}
+			c->cible[lig * largeur + col] = car == '.' || car == '*' || car == '+';
+			c->nbCaisses += car == '$' || car == '*';
+		}
+	}
+	c->bits = 1;
+	while ((1 << c->bits) < c->nbLibres) {
+		c->bits++;
+	}
+	c->octets = ((c->nbCaisses + 1) * c->bits + 7) / 8;
+	return true;
+}
+
+/**
+* @brief libère le codage
+* @param c type : structure, entrée/sortie, codage
+* @return résultat : mémoire libérée
+*/
+
+static inline void etat_liberer(t_codage *c){
+	free(c->rang);
+	free(c->cases);
+	free(c->cible);
+	free(c->file);
+	free(c->vu);
+}
+
+/**
+* @brief trie des cases par ordre croissant (tri par insertion : il y a peu
+* de caisses et une seule est déplacée d'un état au suivant)
+* @param caisses type : tableau, entrée/sortie, cases des caisses
+* @param nb type : entier, entrée, nombre de caisses
+* @return résultat : cases triées
+*/
+
+static inline void etat_trier(int caisses[], int nb){
+	int i;
+	int j;
+	int c;
+
+	for (i = 1; i < nb; i++) {
+		c = caisses[i];
+		for (j = i; j > 0 && caisses[j - 1] > c; j--) {
+			caisses[j] = caisses[j - 1];
+		}
+		caisses[j] = c;
+	}
+}
+
+/**
+* @brief écrit un état : le joueur puis les caisses, bits de poids faible en tête
+* @param c type : structure, entrée, codage
+* @param caisses type : tableau, entrée, cases des caisses triées
+* @param joueur type : entier, entrée, case du joueur déjà ramenée au coin de sa zone
+* @param etat type : tableau, sortie, c->octets octets
+* @return résultat : état codé
+*/
+
+static inline void etat_coder(const t_codage *c, const int caisses[], int joueur, unsigned char etat[]){
+	uint64_t mot = (uint64_t)c->rang[joueur]; // bits pas encore écrits
+	int nbBits = c->bits;
+	int o = 0;
+
+	for (int i = 0; i < c->nbCaisses; i++) {
+		mot |= (uint64_t)c->rang[caisses[i]] << nbBits;
+		nbBits += c->bits;
+		while (nbBits >= 8) {
+			etat[o++] = (unsigned char)mot;
+			mot >>= 8;
+			nbBits -= 8;
+		}
+	}
+	while (o < c->octets) {
+		etat[o++] = (unsigned char)mot;
+		mot >>= 8;
+	}
+}
+
+/**
+* @brief relit un état codé par etat_coder
+* @param c type : structure, entrée, codage
+* @param etat type : tableau, entrée, état codé
+* @param caisses type : tableau, sortie, cases des caisses triées
+* @param joueur type : entier, sortie, case du joueur
+* @return résultat : état décodé
+*/
+
+static inline void etat_decoder(const t_codage *c, const unsigned char etat[], int caisses[], int *joueur){
+	uint64_t masque = ((uint64_t)1 << c->bits) - 1;
+	uint64_t mot = 0; // bits lus pas encore rendus
+	int nbBits = 0;
+	int o = 0;
+
+	for (int i = -1; i < c->nbCaisses; i++) {
+		while (nbBits < c->bits) {
+			mot |= (uint64_t)etat[o++] << nbBits;
+			nbBits += 8;
+		}
+		if (i < 0) {
+			*joueur = c->cases[mot & masque];
+		}
+		else {
+			caisses[i] = c->cases[mot & masque];
+		}
+		mot >>= c->bits;
+		nbBits -= c->bits;
+	}
+}
+
+/**
+* @brief code l'état d'un plateau de caractères (celui d'une partie en cours)
+* @param c type : structure, entrée/sortie, codage (sa mémoire de parcours sert)
+* @param plateau type : tableau, entrée, plateau de caractères
+* @param posx type : entier, entrée, ligne du joueur
+* @param posy type : entier, entrée, colonne du joueur
+* @param coin type : booléen, entrée, ramener le joueur au coin de sa zone
+	(faux : garder sa case exacte, pour reprendre un rejeu)
+* @param etat type : tableau, sortie, c->octets octets
+* @return résultat : faux si le plateau n'a pas le nombre de caisses du codage
+*/
+
+static inline bool etat_depuis_plateau(t_codage *c, char **plateau, int posx, int posy, bool coin,
+	unsigned char etat[]){
+	int *caisses = malloc((c->nbCaisses + 1) * sizeof(int));
+	int nb = 0;
+	int debut = 0;
+	int fin = 0;
+	int joueur = posx * c->largeur + posy;
+	int q;
+	int v;
+	char car;
+
+	if (caisses == NULL) {
+		return false;
+	}
+	// les caisses sont lues dans l'ordre des cases : déjà triées
+	memset(c->vu, 0, c->nbCases * sizeof(bool));
+	for (q = 0; q < c->nbCases; q++) {
+		car = plateau[q / c->largeur][q % c->largeur];
+		if ((car == '$' || car == '*') && nb++ < c->nbCaisses) {
+			caisses[nb - 1] = q;
+		}
+	}
+	if (nb != c->nbCaisses) {
+		free(caisses);
+		return false;
+	}
+	// coin de la zone du joueur : plus petite case atteinte
+	c->file[fin++] = joueur;
+	c->vu[joueur] = true;
+	while (coin && debut < fin) {
+		q = c->file[debut++];
+		if (q < joueur) {
+			joueur = q;
+		}
+		for (int d = 0; d < 4; d++) {
+			if ((d == 0 && q < c->largeur) || (d == 1 && q + c->largeur >= c->nbCases) ||
+				(d == 2 && q % c->largeur == 0) || (d == 3 && q % c->largeur == c->largeur - 1)) {
+				continue;
+			}
+			v = q + (d == 0 ? -c->largeur : d == 1 ? c->largeur : d == 2 ? -1 : 1);
+			car = plateau[v / c->largeur][v % c->largeur];
+			if (!c->vu[v] && car != '#' && car != '$' && car != '*') {
+				c->vu[v] = true;
+				c->file[fin++] = v;
+			}
+		}
+	}
+	etat_coder(c, caisses, joueur, etat);
+	free(caisses);
+	return true;
+}
+
+/**
+* @brief réécrit un plateau de caractères à partir d'un état codé : les murs
+* ne changent pas, le joueur est placé sur la case codée
+* @param c type : structure, entrée, codage
+* @param etat type : tableau, entrée, état codé
+* @param plateau type : tableau, entrée/sortie, plateau du même niveau
+* @param posx type : entier, sortie, ligne du joueur
+* @param posy type : entier, sortie, colonne du joueur
+* @return résultat : nombre de caisses qui ne sont pas sur une cible (-1 si la
+	mémoire manque)
+*/
+
+static inline int etat_vers_plateau(const t_codage *c, const unsigned char etat[], char **plateau,
+	int *posx, int *posy){
+	int *caisses = malloc((c->nbCaisses + 1) * sizeof(int));
+	int joueur = -1;
+	int restantes = 0;
+	int q;
+
+	if (caisses == NULL) {
+		return -1;
+	}
+	etat_decoder(c, etat, caisses, &joueur);
+	for (int i = 0; i < c->nbLibres; i++) {
+		q = c->cases[i];
+		plateau[q / c->largeur][q % c->largeur] = c->cible[q] ? '.' : ' ';
+	}
+	for (int i = 0; i < c->nbCaisses; i++) {
+		q = caisses[i];
+		plateau[q / c->largeur][q % c->largeur] = c->cible[q] ? '*' : '$';
+		restantes += !c->cible[q];
+	}
+	plateau[joueur / c->largeur][joueur % c->largeur] = c->cible[joueur] ? '+' : '@';
+	*posx = joueur / c->largeur;
+	*posy = joueur % c->largeur;
+	free(caisses);
+	return restantes;
+}
+
+#endif
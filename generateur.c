@@ -0,0 +1,312 @@
+/**
+* @file generateur.c
+* @brief Programme qui crée des niveaux de sokoban aléatoires avec leur solution
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Ce programme écrit dans un dossier des niveaux niveauN.sok tirés au hasard,
+* chacun avec une solution niveauN.dep (voir generateur.h) : le dossier se
+* vérifie directement avec sokoban -d dossier. Ces niveaux servent aux
+* mesures et aux essais de charge, des petites salles aux plateaux de
+* 256x256.
+*
+* Utilisation : generateur dossier nombre [-t min-max] [-c min-max] [-m murs]
+*                          [-p tirages] [-s graine] [-j threads]
+*   -t : côtés du plateau, murs du bord compris (défaut 8-16)
+*   -c : nombre de caisses (défaut 2-6), borné par la taille de la salle
+*   -m : part des cases changées en murs, en pour cent (défaut 15)
+*   -p : tirages de caisse du jeu à l'envers, par caisse (défaut 20)
+*   -s : graine (défaut 1)
+*   -j : nombre de threads (défaut : un par coeur)
+* Un intervalle min-max peut se réduire à une valeur.
+*
+* Le niveau N ne dépend que de la graine et de N : le même dossier est écrit
+* quel que soit le nombre de threads. Les threads se partagent les numéros
+* par un compteur atomique, chacun avec son propre générateur.
+*
+* Compilation : gcc -O2 generateur.c -o generateur -lpthread
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define TAILLE_LIGNE 256
+#define MAXTHREADS 256
+#define MINTAILLE 5 // plus petit côté : une case libre au moins sur trois
+#define MAXTAILLE 1024 // plus grand côté, comme NIVEAU_MAX dans niveau.h
+
+#include "historique.h"
+#include "generateur.h"
+
+//Définition de la commande partagée par les threads
+typedef struct{
+	const char *dossier; // dossier des niveaux
+	int nombre; // nombre de niveaux
+	int tailleMin; // côtés du plateau
+	int tailleMax;
+	int caissesMin; // nombre de caisses
+	int caissesMax;
+	int pourcentMurs; // part des cases changées en murs
+	int tirages; // tirages de caisse par caisse
+	uint64_t graine; // graine de la série
+	atomic_int suivant; // prochain numéro de niveau à créer
+} t_commande;
+
+//Définition d'un thread et de ses comptes
+typedef struct{
+	t_commande *commande;
+	long niveaux; // niveaux écrits
+	long echecs; // niveaux sans salle convenable
+	long coups; // coups des solutions
+	long poussees; // poussées des solutions
+	long cases; // cases des plateaux
+	bool erreur; // un fichier n'a pas pu être écrit
+} t_ouvrier;
+
+double temps_us();
+bool lire_intervalle(const char texte[], int *min, int *max);
+bool ecrire_niveau(t_generateur *g, t_historique *solution, const char dossier[], int numero);
+void *generer(void *arg);
+
+/**
+* @brief coeur du programme
+* Lit la ligne de commande, lance les threads et affiche les comptes.
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return EXIT_SUCCESS si tous les niveaux ont été écrits, EXIT_FAILURE sinon
+*/
+
+int main(int argc, char *argv[]){
+	t_commande commande;
+	t_ouvrier ouvriers[MAXTHREADS];
+	pthread_t threads[MAXTHREADS];
+	int nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	bool correct = argc >= 3 && argc % 2 == 1; // la ligne de commande est correcte
+	long niveaux = 0;
+	long echecs = 0;
+	long coups = 0;
+	long poussees = 0;
+	long cases = 0;
+	bool erreur = false;
+	double debut;
+	double duree;
+
+	commande.dossier = (argc >= 3) ? argv[1] : NULL;
+	commande.nombre = (argc >= 3) ? atoi(argv[2]) : 0;
+	commande.tailleMin = 8;
+	commande.tailleMax = 16;
+	commande.caissesMin = 2;
+	commande.caissesMax = 6;
+	commande.pourcentMurs = 15;
+	commande.tirages = 20;
+	commande.graine = 1;
+	atomic_init(&commande.suivant, 0);
+	for (int arg = 3; correct && arg + 1 < argc; arg += 2) {
+		if (strcmp(argv[arg], "-t") == 0) {
+			correct = lire_intervalle(argv[arg+1], &commande.tailleMin, &commande.tailleMax);
+		}
+		else if (strcmp(argv[arg], "-c") == 0) {
+			correct = lire_intervalle(argv[arg+1], &commande.caissesMin, &commande.caissesMax);
+		}
+		else if (strcmp(argv[arg], "-m") == 0) {
+			commande.pourcentMurs = atoi(argv[arg+1]);
+		}
+		else if (strcmp(argv[arg], "-p") == 0) {
+			commande.tirages = atoi(argv[arg+1]);
+		}
+		else if (strcmp(argv[arg], "-s") == 0) {
+			commande.graine = strtoull(argv[arg+1], NULL, 10);
+		}
+		else if (strcmp(argv[arg], "-j") == 0) {
+			nbThreads = atoi(argv[arg+1]);
+		}
+		else {
+			correct = false;
+		}
+	}
+	if (!correct || commande.nombre < 1 || commande.tailleMin < MINTAILLE ||
+		commande.tailleMax > MAXTAILLE || commande.caissesMin < 1 ||
+		commande.pourcentMurs < 0 || commande.pourcentMurs > 90 || commande.tirages < 1) {
+		fprintf(stderr, "Utilisation : %s dossier nombre [-t min-max] [-c min-max] [-m murs]"
+			" [-p tirages] [-s graine] [-j threads]\n", argv[0]);
+		fprintf(stderr, "              (côtés de %d à %d, murs de 0 à 90 %%)\n", MINTAILLE, MAXTAILLE);
+		return EXIT_FAILURE;
+	}
+	if (mkdir(commande.dossier, 0755) != 0 && errno != EEXIST) {
+		fprintf(stderr, "DOSSIER NON CREE : %s\n", commande.dossier);
+		return EXIT_FAILURE;
+	}
+	if (nbThreads < 1) {
+		nbThreads = 1;
+	}
+	if (nbThreads > MAXTHREADS) {
+		nbThreads = MAXTHREADS;
+	}
+	if (nbThreads > commande.nombre) {
+		nbThreads = commande.nombre;
+	}
+
+	debut = temps_us();
+	for (int i = 0; i < nbThreads; i++) {
+		ouvriers[i].commande = &commande;
+		pthread_create(&threads[i], NULL, generer, &ouvriers[i]);
+	}
+	for (int i = 0; i < nbThreads; i++) {
+		pthread_join(threads[i], NULL);
+		niveaux += ouvriers[i].niveaux;
+		echecs += ouvriers[i].echecs;
+		coups += ouvriers[i].coups;
+		poussees += ouvriers[i].poussees;
+		cases += ouvriers[i].cases;
+		erreur = erreur || ouvriers[i].erreur;
+	}
+	duree = temps_us() - debut;
+
+	printf("%ld niveaux écrits dans %s, %ld échecs en %.3f ms sur %d threads (%.0f niveaux/s)\n",
+		niveaux, commande.dossier, echecs, duree / 1e3, nbThreads,
+		(duree > 0) ? niveaux / (duree / 1e6) : 0.0);
+	if (niveaux > 0) {
+		printf("en moyenne %.0f cases, %.1f coups et %.1f poussées par solution\n",
+			(double)cases / niveaux, (double)coups / niveaux, (double)poussees / niveaux);
+	}
+	if (erreur) {
+		printf("ERREUR SUR FICHIER dans %s\n", commande.dossier);
+	}
+	return (!erreur && echecs == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief donne l'heure courante d'une horloge monotone
+* @return résultat : temps en microsecondes
+*/
+
+double temps_us(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+/**
+* @brief lit un intervalle "min-max" ou une seule valeur
+* @param texte type : chaine, entrée, argument de la commande
+* @param min type : entier, sortie, plus petite valeur
+* @param max type : entier, sortie, plus grande valeur
+* @return résultat : faux si le texte n'est pas un intervalle croissant
+*/
+
+bool lire_intervalle(const char texte[], int *min, int *max){
+	int nb = sscanf(texte, "%d-%d", min, max);
+
+	if (nb == 1) {
+		*max = *min;
+	}
+	return nb >= 1 && *min <= *max;
+}
+
+/**
+* @brief écrit le niveau créé et sa solution : dossier/niveauN.sok et
+* dossier/niveauN.dep
+* @param g type : structure, entrée, générateur qui vient de créer le niveau
+* @param solution type : structure, entrée/sortie, historique de travail
+* @param dossier type : chaine, entrée, dossier des niveaux
+* @param numero type : entier, entrée, numéro du niveau
+* @return résultat : faux si un fichier n'a pas pu être écrit
+*/
+
+bool ecrire_niveau(t_generateur *g, t_historique *solution, const char dossier[], int numero){
+	char fichier[TAILLE_LIGNE];
+	FILE * f;
+
+	if (snprintf(fichier, TAILLE_LIGNE, "%s/niveau%06d.sok", dossier, numero) >= TAILLE_LIGNE) {
+		return false;
+	}
+	f = fopen(fichier, "w");
+	if (f == NULL) {
+		return false;
+	}
+	gen_ecrire(g, f);
+	fclose(f);
+
+	strcpy(fichier + strlen(fichier) - 4, ".dep");
+	if (!gen_solution(g, solution)) {
+		return false;
+	}
+	f = fopen(fichier, "w");
+	if (f == NULL) {
+		return false;
+	}
+	hist_ecrire_fichier(solution, f);
+	fclose(f);
+	return true;
+}
+
+/**
+* @brief fonction d'un thread : crée les niveaux dont il prend le numéro
+* Les côtés, le nombre de caisses et la graine du niveau N sont tirés d'un
+* état qui ne dépend que de la graine de la série et de N.
+* @param arg type : pointeur, entrée/sortie, ouvrier (t_ouvrier)
+* @return résultat : NULL, les comptes sont dans l'ouvrier
+*/
+
+void *generer(void *arg){
+	t_ouvrier *o = arg;
+	t_commande *c = o->commande;
+	t_generateur g;
+	t_historique solution;
+	uint64_t etat; // hasard du niveau
+	int numero;
+	int hauteur;
+	int largeur;
+	int nbCaisses;
+	int maxCaisses;
+
+	o->niveaux = 0;
+	o->echecs = 0;
+	o->coups = 0;
+	o->poussees = 0;
+	o->cases = 0;
+	o->erreur = false;
+	hist_init(&solution);
+	if (!gen_init(&g, c->tailleMax, c->tailleMax)) {
+		o->erreur = true;
+		gen_liberer(&g);
+		return NULL;
+	}
+	while ((numero = atomic_fetch_add(&c->suivant, 1)) < c->nombre) {
+		etat = c->graine * 0xD1B54A32D192ED03ull + (uint64_t)numero;
+		hauteur = c->tailleMin + (int)(gen_aleatoire(&etat) % (uint64_t)(c->tailleMax - c->tailleMin + 1));
+		largeur = c->tailleMin + (int)(gen_aleatoire(&etat) % (uint64_t)(c->tailleMax - c->tailleMin + 1));
+		nbCaisses = c->caissesMin + (int)(gen_aleatoire(&etat) % (uint64_t)(c->caissesMax - c->caissesMin + 1));
+		// une caisse au plus pour quatre cases de l'intérieur de la salle
+		maxCaisses = (hauteur - 2) * (largeur - 2) / 4;
+		if (nbCaisses > maxCaisses) {
+			nbCaisses = (maxCaisses > 0) ? maxCaisses : 1;
+		}
+		if (!gen_niveau(&g, gen_aleatoire(&etat), hauteur, largeur, nbCaisses, c->pourcentMurs,
+			nbCaisses * c->tirages)) {
+			o->echecs++;
+			continue;
+		}
+		if (!ecrire_niveau(&g, &solution, c->dossier, numero)) {
+			o->erreur = true;
+			continue;
+		}
+		o->niveaux++;
+		o->coups += g.nbCoups;
+		o->poussees += g.nbPoussees;
+		o->cases += g.nbCases;
+	}
+	hist_liberer(&solution);
+	gen_liberer(&g);
+	return NULL;
+}
@@ -0,0 +1,509 @@
+/**
+* @file generateur.h
+* @brief Création de niveaux aléatoires qui ont toujours une solution
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Une salle est tirée au hasard : des murs sont semés dans un rectangle, puis
+* seule la plus grande zone d'un seul tenant est gardée. Les caisses sont
+* d'abord posées sur les cibles, puis le jeu est joué à l'envers : le joueur
+* marche et tire des caisses au lieu de les pousser. Chaque coup à l'envers
+* est l'inverse d'un coup permis à l'endroit, donc relire ces coups du
+* dernier au premier ramène toutes les caisses sur les cibles : le niveau a
+* une solution, écrite avec lui.
+*
+* Un tirage continue le plus souvent dans la même direction avec la même
+* caisse, ce qui donne de longues poussées ; sinon un parcours en largeur
+* depuis le joueur s'arrête dès qu'il a trouvé GEN_CHOIX tirages possibles et
+* l'un d'eux est choisi au hasard. Le parcours ne voit ainsi que le voisinage
+* du joueur : son coût ne dépend pas de la taille du plateau, ce qui compte
+* sur les plateaux de 256x256. La marche avant le premier tirage n'est pas
+* gardée : à l'endroit, elle suivrait la dernière poussée, quand le niveau est
+* déjà gagné.
+*
+* Tout le hasard vient d'un seul état splitmix64 par niveau : un niveau ne
+* dépend que de sa graine, pas du thread qui le crée.
+*
+* Les cases sont numérotées lig * largeur + col ; le bord du rectangle est
+* toujours un mur, ce qui évite de tester les limites.
+*/
+
+#ifndef GENERATEUR_H
+#define GENERATEUR_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "historique.h"
+
+#define GEN_ESSAIS 16 // salles tirées au plus pour un niveau
+#define GEN_SUITE 4 // un tirage sur GEN_SUITE change de caisse ou de direction
+#define GEN_CHOIX 8 // tirages possibles cherchés avant d'en choisir un
+
+static const char gen_marches[] = "hbgd"; // coup de chaque direction
+static const char gen_poussees[] = "HBGD"; // poussée de chaque direction
+
+//Définition du générateur : salle, caisses et coups joués à l'envers
+typedef struct{
+	int maxHauteur; // plus grand plateau prévu par les allocations
+	int maxLargeur;
+	int hauteur; // plateau du niveau courant
+	int largeur;
+	int nbCases; // hauteur * largeur
+	int decalage[4]; // haut, bas, gauche, droite
+	bool *mur; // murs de la salle
+	bool *cible; // cibles
+	bool *caisse; // caisses de l'état courant
+	int nbHorsCible; // caisses qui ne sont pas sur une cible
+	int joueur; // case du joueur
+	int *file; // parcours en largeur (aussi cases libres de la salle)
+	int *venu; // direction d'arrivée sur chaque case atteinte
+	unsigned *vu; // numéro du parcours qui a atteint chaque case
+	unsigned parcours; // numéro du parcours courant
+	int candidats[GEN_CHOIX + 3]; // tirages possibles : 4 * case du joueur + direction
+	char *coups; // coups à l'endroit, rangés dans l'ordre du jeu à l'envers
+	int nbCoups; // nombre de coups rangés
+	int capaciteCoups; // taille allouée de coups
+	int nbPoussees; // poussées de la solution
+	uint64_t alea; // état du générateur pseudo-aléatoire
+} t_generateur;
+
+/**
+* @brief générateur pseudo-aléatoire splitmix64
+* @param etat type : entier, entrée/sortie, état du générateur
+* @return résultat : nombre aléatoire sur 64 bits
+*/
+
+static inline uint64_t gen_aleatoire(uint64_t *etat){
+	uint64_t z = (*etat += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+* @brief tire un entier dans un intervalle
+* @param g type : structure, entrée/sortie, générateur
+* @param min type : entier, entrée, plus petite valeur
+* @param max type : entier, entrée, plus grande valeur (au moins min)
+* @return résultat : entier entre min et max compris
+*/
+
+static inline int gen_entre(t_generateur *g, int min, int max){
+	return min + (int)(gen_aleatoire(&g->alea) % (uint64_t)(max - min + 1));
+}
+
+/**
+* @brief alloue un générateur pour des plateaux de taille bornée
+* @param g type : structure, sortie, générateur
+* @param maxHauteur type : entier, entrée, plus grand nombre de lignes
+* @param maxLargeur type : entier, entrée, plus grand nombre de colonnes
+* @return résultat : faux si la mémoire manque (le générateur doit quand
+* même être libéré)
+*/
+
+static inline bool gen_init(t_generateur *g, int maxHauteur, int maxLargeur){
+	int nbCases = maxHauteur * maxLargeur;
+
+	g->maxHauteur = maxHauteur;
+	g->maxLargeur = maxLargeur;
+	g->hauteur = 0;
+	g->largeur = 0;
+	g->nbCases = 0;
+	g->nbHorsCible = 0;
+	g->joueur = 0;
+	g->parcours = 0;
+	g->nbCoups = 0;
+	g->capaciteCoups = 0;
+	g->nbPoussees = 0;
+	g->alea = 0;
+	g->mur = malloc(nbCases * sizeof(bool));
+	g->cible = malloc(nbCases * sizeof(bool));
+	g->caisse = malloc(nbCases * sizeof(bool));
+	g->file = malloc(nbCases * sizeof(int));
+	g->venu = malloc(nbCases * sizeof(int));
+	g->vu = calloc(nbCases, sizeof(unsigned));
+	g->coups = NULL;
+	return g->mur != NULL && g->cible != NULL && g->caisse != NULL && g->file != NULL &&
+		g->venu != NULL && g->vu != NULL;
+}
+
+/**
+* @brief libère la mémoire du générateur
+* @param g type : structure, entrée/sortie, générateur
+* @return résultat : mémoire libérée
+*/
+
+static inline void gen_liberer(t_generateur *g){
+	free(g->mur);
+	free(g->cible);
+	free(g->caisse);
+	free(g->file);
+	free(g->venu);
+	free(g->vu);
+	free(g->coups);
+	g->mur = NULL;
+	g->cible = NULL;
+	g->caisse = NULL;
+	g->file = NULL;
+	g->venu = NULL;
+	g->vu = NULL;
+	g->coups = NULL;
+}
+
+/**
+* @brief range un coup à l'endroit
+* @param g type : structure, entrée/sortie, générateur
+* @param c type : caractère, entrée, coup
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool gen_noter(t_generateur *g, char c){
+	char *coups;
+	int capacite;
+
+	if (g->nbCoups == g->capaciteCoups) {
+		capacite = (g->capaciteCoups == 0) ? 4096 : 2 * g->capaciteCoups;
+		coups = realloc(g->coups, capacite);
+		if (coups == NULL) {
+			return false;
+		}
+		g->coups = coups;
+		g->capaciteCoups = capacite;
+	}
+	g->coups[g->nbCoups++] = c;
+	return true;
+}
+
+/**
+* @brief tire une salle : murs semés au hasard, puis seule la plus grande
+* zone d'un seul tenant reste libre
+* @param g type : structure, entrée/sortie, générateur
+* @param pourcentMurs type : entier, entrée, part des cases changées en murs
+* @return résultat : nombre de cases libres, rangées au début de g->file
+*/
+
+static inline int gen_salle(t_generateur *g, int pourcentMurs){
+	int lig;
+	int col;
+	int meilleure = -1; // première case de la plus grande zone
+	int taille = 0;
+	int debut;
+	int fin;
+	int c;
+	int v;
+	int nb = 0;
+
+	for (int i = 0; i < g->nbCases; i++) {
+		lig = i / g->largeur;
+		col = i % g->largeur;
+		g->mur[i] = lig == 0 || col == 0 || lig == g->hauteur - 1 || col == g->largeur - 1 ||
+			gen_entre(g, 0, 99) < pourcentMurs;
+		g->cible[i] = false;
+		g->caisse[i] = false;
+		g->venu[i] = -1;
+	}
+	// chaque zone est notée dans venu par le numéro de sa première case
+	for (int i = 0; i < g->nbCases; i++) {
+		if (g->mur[i] || g->venu[i] >= 0) {
+			continue;
+		}
+		debut = 0;
+		fin = 0;
+		g->venu[i] = i;
+		g->file[fin++] = i;
+		while (debut < fin) {
+			c = g->file[debut++];
+			for (int d = 0; d < 4; d++) {
+				v = c + g->decalage[d];
+				if (!g->mur[v] && g->venu[v] < 0) {
+					g->venu[v] = i;
+					g->file[fin++] = v;
+				}
+			}
+		}
+		if (fin > taille) {
+			taille = fin;
+			meilleure = i;
+		}
+	}
+	for (int i = 0; i < g->nbCases; i++) {
+		if (!g->mur[i]) {
+			if (g->venu[i] == meilleure) {
+				g->file[nb++] = i;
+			}
+			else {
+				g->mur[i] = true;
+			}
+		}
+	}
+	return nb;
+}
+
+/**
+* @brief ajoute la marche du joueur jusqu'à une case, trouvée par le dernier
+* parcours en largeur depuis sa case
+* @param g type : structure, entrée/sortie, générateur
+* @param arrivee type : entier, entrée, case atteinte par le parcours
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool gen_marcher(t_generateur *g, int arrivee){
+	int nb = 0;
+	int c = arrivee;
+
+	// les pas sont retrouvés de l'arrivée vers le départ et gardés dans
+	// file, dont le parcours n'a plus besoin
+	while (c != g->joueur) {
+		g->file[nb++] = g->venu[c];
+		c -= g->decalage[g->venu[c]];
+	}
+	// à l'envers le joueur fait ces pas dans l'ordre, à l'endroit chacun est
+	// fait dans la direction opposée (d ^ 1)
+	while (nb > 0) {
+		if (!gen_noter(g, gen_marches[g->file[--nb] ^ 1])) {
+			return false;
+		}
+	}
+	g->joueur = arrivee;
+	return true;
+}
+
+/**
+* @brief dit si le joueur peut reculer sur une case sans s'y enfermer : après
+* le tirage, la caisse est sur la case qu'il quitte et il lui faut une autre
+* case libre à côté. Une poche plus grande peut encore l'enfermer, le jeu à
+* l'envers s'arrête alors plus tôt.
+* @param g type : structure, entrée, générateur
+* @param q type : entier, entrée, case où le joueur recule
+* @param p type : entier, entrée, case qu'il quitte, où vient la caisse
+* @return résultat : vrai si la case est libre et a une autre case libre à côté
+*/
+
+static inline bool gen_recul(const t_generateur *g, int q, int p){
+	int v;
+
+	if (g->mur[q] || g->caisse[q]) {
+		return false;
+	}
+	for (int d = 0; d < 4; d++) {
+		v = q + g->decalage[d];
+		if (v != p && !g->mur[v] && !g->caisse[v]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+* @brief parcours en largeur depuis le joueur, qui s'arrête dès que
+* GEN_CHOIX tirages possibles sont trouvés : depuis une case p atteinte, la
+* caisse en p + decalage[d] peut être tirée si le joueur peut reculer en
+* p - decalage[d]
+* @param g type : structure, entrée/sortie, générateur
+* @return résultat : nombre de tirages trouvés, rangés dans g->candidats ;
+* direction d'arrivée des cases atteintes dans g->venu
+*/
+
+static inline int gen_chercher(t_generateur *g){
+	int debut = 0;
+	int fin = 0;
+	int nb = 0;
+	int c;
+	int v;
+
+	// un nouveau numéro de parcours évite de remettre venu à zéro
+	if (++g->parcours == 0) {
+		for (int i = 0; i < g->maxHauteur * g->maxLargeur; i++) {
+			g->vu[i] = 0;
+		}
+		g->parcours = 1;
+	}
+	g->vu[g->joueur] = g->parcours;
+	g->venu[g->joueur] = 4;
+	g->file[fin++] = g->joueur;
+	while (debut < fin && nb < GEN_CHOIX) {
+		c = g->file[debut++];
+		for (int d = 0; d < 4; d++) {
+			v = c + g->decalage[d];
+			if (g->caisse[v]) {
+				if (gen_recul(g, c - g->decalage[d], c)) {
+					g->candidats[nb++] = 4 * c + d;
+				}
+			}
+			else if (g->vu[v] != g->parcours && !g->mur[v]) {
+				g->vu[v] = g->parcours;
+				g->venu[v] = d;
+				g->file[fin++] = v;
+			}
+		}
+	}
+	return nb;
+}
+
+/**
+* @brief joue le jeu à l'envers depuis l'état où toutes les caisses sont sur
+* les cibles
+* @param g type : structure, entrée/sortie, générateur (salle, cibles et
+* joueur posés)
+* @param nbTirages type : entier, entrée, nombre de tirages de caisse
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool gen_jouer_envers(t_generateur *g, int nbTirages){
+	int dir = -1; // direction du dernier tirage (-1 : aucun)
+	int nbCandidats;
+	int p; // case du joueur au moment du tirage, où vient la caisse
+	int c;
+
+	for (int t = 0; t < nbTirages; t++) {
+		if (dir < 0 || gen_entre(g, 1, GEN_SUITE) == 1 ||
+			!gen_recul(g, g->joueur - g->decalage[dir], g->joueur)) {
+			nbCandidats = gen_chercher(g);
+			if (nbCandidats == 0) {
+				break;
+			}
+			c = g->candidats[gen_entre(g, 0, nbCandidats - 1)];
+			dir = c % 4;
+			// la marche vers le premier tirage suivrait la dernière poussée
+			if (g->nbPoussees == 0) {
+				g->joueur = c / 4;
+			}
+			else if (!gen_marcher(g, c / 4)) {
+				return false;
+			}
+		}
+		// la caisse vient sur la case du joueur, qui recule d'une case : à
+		// l'endroit, c'est une poussée dans la direction dir
+		p = g->joueur;
+		c = p + g->decalage[dir];
+		g->caisse[c] = false;
+		g->caisse[p] = true;
+		g->nbHorsCible += g->cible[c] - g->cible[p];
+		g->joueur = p - g->decalage[dir];
+		if (!gen_noter(g, gen_poussees[dir])) {
+			return false;
+		}
+		g->nbPoussees++;
+	}
+	return true;
+}
+
+/**
+* @brief crée un niveau : salle, cibles, puis jeu à l'envers. Une salle trop
+* petite pour les caisses, ou dont toutes les caisses reviennent sur des
+* cibles, est tirée de nouveau.
+* @param g type : structure, entrée/sortie, générateur
+* @param graine type : entier, entrée, graine du niveau
+* @param hauteur type : entier, entrée, nombre de lignes (au plus maxHauteur)
+* @param largeur type : entier, entrée, nombre de colonnes (au plus maxLargeur)
+* @param nbCaisses type : entier, entrée, nombre de caisses
+* @param pourcentMurs type : entier, entrée, part des cases changées en murs
+* @param nbTirages type : entier, entrée, tirages de caisse du jeu à l'envers
+* @return résultat : faux si aucune salle ne convient ou si la mémoire manque
+*/
+
+static inline bool gen_niveau(t_generateur *g, uint64_t graine, int hauteur, int largeur,
+	int nbCaisses, int pourcentMurs, int nbTirages){
+	int nbLibres;
+	int k;
+	int c;
+
+	if (hauteur < 3 || largeur < 3 || hauteur > g->maxHauteur || largeur > g->maxLargeur ||
+		nbCaisses < 1) {
+		return false;
+	}
+	g->alea = graine;
+	g->hauteur = hauteur;
+	g->largeur = largeur;
+	g->nbCases = hauteur * largeur;
+	g->decalage[0] = -largeur;
+	g->decalage[1] = largeur;
+	g->decalage[2] = -1;
+	g->decalage[3] = 1;
+	for (int essai = 0; essai < GEN_ESSAIS; essai++) {
+		g->nbCoups = 0;
+		g->nbPoussees = 0;
+		g->nbHorsCible = 0;
+		nbLibres = gen_salle(g, pourcentMurs);
+		if (nbLibres < nbCaisses + 2) {
+			continue;
+		}
+		// tirage sans remise dans les cases libres : les cibles, puis le joueur
+		for (int i = 0; i <= nbCaisses; i++) {
+			k = gen_entre(g, i, nbLibres - 1);
+			c = g->file[k];
+			g->file[k] = g->file[i];
+			g->file[i] = c;
+			if (i < nbCaisses) {
+				g->cible[c] = true;
+				g->caisse[c] = true;
+			}
+			else {
+				g->joueur = c;
+			}
+		}
+		if (!gen_jouer_envers(g, nbTirages)) {
+			return false;
+		}
+		if (g->nbHorsCible > 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+* @brief donne la solution du niveau créé : les coups du jeu à l'envers,
+* relus du dernier au premier
+* @param g type : structure, entrée, générateur
+* @param solution type : structure, entrée/sortie, historique (vidé)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool gen_solution(const t_generateur *g, t_historique *solution){
+	hist_vider(solution);
+	for (int i = g->nbCoups - 1; i >= 0; i--) {
+		if (!hist_ajouter(solution, g->coups[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+* @brief écrit le niveau créé au format .sok
+* @param g type : structure, entrée, générateur
+* @param f type : fichier, entrée/sortie, fichier ouvert en écriture
+* @return résultat : niveau écrit, une ligne par ligne du plateau
+*/
+
+static inline void gen_ecrire(const t_generateur *g, FILE *f){
+	char ligne[g->largeur + 2];
+	int c;
+
+	for (int lig = 0; lig < g->hauteur; lig++) {
+		for (int col = 0; col < g->largeur; col++) {
+			c = lig * g->largeur + col;
+			if (g->mur[c]) {
+				ligne[col] = '#';
+			}
+			else if (c == g->joueur) {
+				ligne[col] = g->cible[c] ? '+' : '@';
+			}
+			else if (g->caisse[c]) {
+				ligne[col] = g->cible[c] ? '*' : '$';
+			}
+			else {
+				ligne[col] = g->cible[c] ? '.' : ' ';
+			}
+		}
+		ligne[g->largeur] = '\n';
+		ligne[g->largeur + 1] = '\0';
+		fputs(ligne, f);
+	}
+}
+
+#endif
@@ -0,0 +1,364 @@
+/**
+* @file heuristique.h
+* @brief Estimation du nombre de poussées restantes par affectation des
+* caisses aux cibles
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Au chargement, on calcule pour chaque cible le nombre minimal de poussées
+* qui y amènent une caisse depuis chaque case, en tirant la caisse à reculons
+* depuis la cible (les autres caisses sont ignorées). L'estimation d'un état
+* est le coût minimal d'une affectation des caisses aux cibles, une cible par
+* caisse : elle ne dépasse jamais le vrai nombre de poussées et ne baisse que
+* d'un au plus par poussée.
+*
+* L'affectation est calculée par la méthode hongroise sur une matrice carrée
+* (les cibles en trop reçoivent des caisses fictives de coût nul). Quand une
+* seule caisse bouge, on libère sa ligne, on garde les potentiels des autres
+* et un seul chemin augmentant rétablit l'affectation optimale : O(n²) au
+* lieu de O(n³) pour un calcul complet.
+*/
+
+#ifndef HEURISTIQUE_H
+#define HEURISTIQUE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define HEUR_INFINI (1 << 30) // pas de chemin : la position est sans issue
+
+//Définition des distances de poussée, calculées une fois par niveau
+typedef struct{
+	int nbCases; // cases numérotées lig * pas + col
+	int nbCibles; // nombre de cibles
+	int *cibles; // case de chaque cible
+	int *distances; // distances[t * nbCases + c] : poussées de c jusqu'à la cible t
+} t_heuristique;
+
+//Définition d'une affectation des caisses aux cibles, avec ses potentiels
+typedef struct{
+	const t_heuristique *h; // distances de poussée
+	int nbCaisses; // lignes réelles de la matrice
+	int taille; // lignes et colonnes de la matrice (nombre de cibles)
+	int *caisses; // case de chaque caisse (ligne 1 à nbCaisses)
+	int64_t *u; // potentiels des lignes (indices 1 à taille)
+	int64_t *v; // potentiels des colonnes (indices 0 à taille)
+	int *p; // p[col] : ligne affectée à la colonne, 0 si aucune
+	int *chemin; // colonne précédente sur le chemin augmentant
+	int64_t *minv; // plus petit coût réduit vers chaque colonne
+	bool *vu; // colonnes déjà atteintes
+	int64_t *uSauve; // copie des potentiels et de l'affectation
+	int64_t *vSauve;
+	int *pSauve;
+	int *caissesSauve;
+} t_affectation;
+
+/**
+* @brief calcule les distances de poussée de toutes les cases vers chaque cible
+* @param h type : structure, sortie, distances
+* @param plateau type : tableau, entrée, plateau de caractères
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @param pas type : entier, entrée, décalage d'une ligne (>= largeur)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool heur_init(t_heuristique *h, char **plateau, int hauteur, int largeur, int pas){
+	int *file;
+	int *dist;
+	int debut;
+	int fin;
+	int q;
+	int lig;
+	int col;
+	int dl;
+	int dc;
+	char c;
+
+	h->nbCases = hauteur * pas;
+	h->nbCibles = 0;
+	h->cibles = malloc((h->nbCases + 1) * sizeof(int));
+	file = malloc((h->nbCases + 1) * sizeof(int));
+	if (h->cibles == NULL || file == NULL) {
+		free(file);
+		h->distances = NULL;
+		return false;
+	}
+	for (lig = 0; lig < hauteur; lig++) {
+		for (col = 0; col < largeur; col++) {
+			c = plateau[lig][col];
+			if (c == '.' || c == '*' || c == '+') {
+				h->cibles[h->nbCibles++] = lig * pas + col;
+			}
+		}
+	}
+	h->distances = malloc(((size_t)h->nbCibles * h->nbCases + 1) * sizeof(int));
+	if (h->distances == NULL) {
+		free(file);
+		return false;
+	}
+
+	// une caisse en q a pu venir de q - d si le joueur pouvait se tenir en q - 2d
+	for (int t = 0; t < h->nbCibles; t++) {
+		dist = &h->distances[(size_t)t * h->nbCases];
+		for (q = 0; q < h->nbCases; q++) {
+			dist[q] = HEUR_INFINI;
+		}
+		debut = 0;
+		fin = 0;
+		dist[h->cibles[t]] = 0;
+		file[fin++] = h->cibles[t];
+		while (debut < fin) {
+			q = file[debut++];
+			lig = q / pas;
+			col = q % pas;
+			for (int d = 0; d < 4; d++) {
+				dl = (d == 1) - (d == 0);
+				dc = (d == 3) - (d == 2);
+				if (lig - 2 * dl >= 0 && lig - 2 * dl < hauteur && col - 2 * dc >= 0 && col - 2 * dc < largeur &&
+					plateau[lig - dl][col - dc] != '#' && plateau[lig - 2 * dl][col - 2 * dc] != '#' &&
+					dist[(lig - dl) * pas + col - dc] == HEUR_INFINI) {
+					dist[(lig - dl) * pas + col - dc] = dist[q] + 1;
+					file[fin++] = (lig - dl) * pas + col - dc;
+				}
+			}
+		}
+	}
+	free(file);
+	return true;
+}
+
+/**
+* @brief libère les distances de poussée
+* @param h type : structure, entrée/sortie, distances
+* @return résultat : mémoire libérée
+*/
+
+static inline void heur_liberer(t_heuristique *h){
+	free(h->cibles);
+	free(h->distances);
+}
+
+/**
+* @brief prépare une affectation (une par thread de recherche)
+* @param a type : structure, sortie, affectation
+* @param h type : structure, entrée, distances de poussée
+* @param nbCaisses type : entier, entrée, nombre de caisses (<= nombre de cibles)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool affect_init(t_affectation *a, const t_heuristique *h, int nbCaisses){
+	int n = h->nbCibles + 1;
+
+	a->h = h;
+	a->nbCaisses = nbCaisses;
+	a->taille = h->nbCibles;
+	a->caisses = calloc(n, sizeof(int));
+	a->u = calloc(n, sizeof(int64_t));
+	a->v = calloc(n, sizeof(int64_t));
+	a->p = calloc(n, sizeof(int));
+	a->chemin = calloc(n, sizeof(int));
+	a->minv = calloc(n, sizeof(int64_t));
+	a->vu = calloc(n, sizeof(bool));
+	a->uSauve = calloc(n, sizeof(int64_t));
+	a->vSauve = calloc(n, sizeof(int64_t));
+	a->pSauve = calloc(n, sizeof(int));
+	a->caissesSauve = calloc(n, sizeof(int));
+	return a->caisses != NULL && a->u != NULL && a->v != NULL && a->p != NULL &&
+		a->chemin != NULL && a->minv != NULL && a->vu != NULL && a->uSauve != NULL &&
+		a->vSauve != NULL && a->pSauve != NULL && a->caissesSauve != NULL;
+}
+
+/**
+* @brief libère une affectation
+* @param a type : structure, entrée/sortie, affectation
+* @return résultat : mémoire libérée
+*/
+
+static inline void affect_liberer(t_affectation *a){
+	free(a->caisses);
+	free(a->u);
+	free(a->v);
+	free(a->p);
+	free(a->chemin);
+	free(a->minv);
+	free(a->vu);
+	free(a->uSauve);
+	free(a->vSauve);
+	free(a->pSauve);
+	free(a->caissesSauve);
+}
+
+/**
+* @brief coût d'une case de la matrice
+* @param a type : structure, entrée, affectation
+* @param i type : entier, entrée, ligne (1 à taille)
+* @param j type : entier, entrée, colonne (1 à taille)
+* @return résultat : poussées de la caisse i vers la cible j, 0 pour une caisse fictive
+*/
+
+static inline int64_t affect_cout(const t_affectation *a, int i, int j){
+	if (i > a->nbCaisses) {
+		return 0;
+	}
+	return a->h->distances[(size_t)(j - 1) * a->h->nbCases + a->caisses[i]];
+}
+
+/**
+* @brief affecte une ligne libre par le plus court chemin augmentant, en
+* gardant les coûts réduits positifs et nuls sur les cases affectées
+* @param a type : structure, entrée/sortie, affectation
+* @param i type : entier, entrée, ligne libre
+* @return résultat : ligne affectée, affectation optimale si elle l'était
+	pour les autres lignes
+*/
+
+static inline void affect_augmenter(t_affectation *a, int i){
+	int n = a->taille;
+	int j0 = 0;
+	int j1 = 0;
+	int i0;
+	int64_t delta;
+	int64_t reduit;
+
+	a->p[0] = i;
+	for (int j = 0; j <= n; j++) {
+		a->minv[j] = INT64_MAX;
+		a->vu[j] = false;
+	}
+	do {
+		a->vu[j0] = true;
+		i0 = a->p[j0];
+		delta = INT64_MAX;
+		for (int j = 1; j <= n; j++) {
+			if (!a->vu[j]) {
+				reduit = affect_cout(a, i0, j) - a->u[i0] - a->v[j];
+				if (reduit < a->minv[j]) {
+					a->minv[j] = reduit;
+					a->chemin[j] = j0;
+				}
+				if (a->minv[j] < delta) {
+					delta = a->minv[j];
+					j1 = j;
+				}
+			}
+		}
+		for (int j = 0; j <= n; j++) {
+			if (a->vu[j]) {
+				a->u[a->p[j]] += delta;
+				a->v[j] -= delta;
+			}
+			else {
+				a->minv[j] -= delta;
+			}
+		}
+		j0 = j1;
+	} while (a->p[j0] != 0);
+	// inversion du chemin
+	do {
+		j1 = a->chemin[j0];
+		a->p[j0] = a->p[j1];
+		j0 = j1;
+	} while (j0 != 0);
+}
+
+/**
+* @brief somme des coûts de l'affectation courante
+* @param a type : structure, entrée, affectation
+* @return résultat : nombre de poussées estimé, HEUR_INFINI si une caisse ne
+	peut atteindre aucune cible libre
+*/
+
+static inline int affect_valeur(const t_affectation *a){
+	int64_t total = 0;
+	int64_t cout;
+
+	for (int j = 1; j <= a->taille; j++) {
+		cout = affect_cout(a, a->p[j], j);
+		if (cout >= HEUR_INFINI) {
+			return HEUR_INFINI;
+		}
+		total += cout;
+	}
+	return (int)total;
+}
+
+/**
+* @brief calcule entièrement l'affectation optimale d'un état
+* @param a type : structure, entrée/sortie, affectation
+* @param caisses type : tableau, entrée, cases des caisses
+* @return résultat : nombre de poussées estimé ou HEUR_INFINI
+*/
+
+static inline int affect_calculer(t_affectation *a, const int caisses[]){
+	for (int j = 0; j <= a->taille; j++) {
+		a->u[j] = 0;
+		a->v[j] = 0;
+		a->p[j] = 0;
+	}
+	for (int i = 1; i <= a->nbCaisses; i++) {
+		a->caisses[i] = caisses[i - 1];
+	}
+	for (int i = 1; i <= a->taille; i++) {
+		affect_augmenter(a, i);
+	}
+	return affect_valeur(a);
+}
+
+/**
+* @brief met à jour l'affectation quand une caisse change de case
+* @param a type : structure, entrée/sortie, affectation déjà calculée
+* @param k type : entier, entrée, indice de la caisse (0 à nbCaisses - 1)
+* @param c type : entier, entrée, nouvelle case de la caisse
+* @return résultat : nombre de poussées estimé ou HEUR_INFINI
+*/
+
+static inline int affect_deplacer(t_affectation *a, int k, int c){
+	int i = k + 1;
+
+	a->caisses[i] = c;
+	for (int j = 1; j <= a->taille; j++) {
+		if (a->p[j] == i) {
+			a->p[j] = 0;
+		}
+	}
+	// les potentiels des colonnes sont négatifs : u = 0 garde la ligne admissible
+	a->u[i] = 0;
+	affect_augmenter(a, i);
+	return affect_valeur(a);
+}
+
+/**
+* @brief garde une copie de l'affectation (avant d'essayer une poussée)
+* @param a type : structure, entrée/sortie, affectation
+* @return résultat : copie faite
+*/
+
+static inline void affect_sauver(t_affectation *a){
+	size_t n = a->taille + 1;
+
+	memcpy(a->uSauve, a->u, n * sizeof(int64_t));
+	memcpy(a->vSauve, a->v, n * sizeof(int64_t));
+	memcpy(a->pSauve, a->p, n * sizeof(int));
+	memcpy(a->caissesSauve, a->caisses, n * sizeof(int));
+}
+
+/**
+* @brief revient à la copie faite par affect_sauver
+* @param a type : structure, entrée/sortie, affectation
+* @return résultat : affectation restaurée
+*/
+
+static inline void affect_restaurer(t_affectation *a){
+	size_t n = a->taille + 1;
+
+	memcpy(a->u, a->uSauve, n * sizeof(int64_t));
+	memcpy(a->v, a->vSauve, n * sizeof(int64_t));
+	memcpy(a->p, a->pSauve, n * sizeof(int));
+	memcpy(a->caisses, a->caissesSauve, n * sizeof(int));
+}
+
+#endif
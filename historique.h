@@ -0,0 +1,232 @@
+/**
+* @file historique.h
+* @brief Historique des déplacements de taille illimitée
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Les caractères de déplacement sont rangés dans des morceaux de
+* HIST_MORCEAU octets alloués au fur et à mesure : rien n'est alloué tant
+* que l'historique est vide, un ajout ne déplace jamais les caractères déjà
+* rangés et il n'y a pas de limite autre que la mémoire. La structure
+* elle-même ne contient que quelques champs, ce qui garde t_partie petite.
+*/
+
+#ifndef HISTORIQUE_H
+#define HISTORIQUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define HIST_DECALAGE 12
+#define HIST_MORCEAU (1 << HIST_DECALAGE) // caractères par morceau
+
+//Définition de l'historique des déplacements
+typedef struct{
+	char **morceaux; // table des morceaux alloués
+	int nbMorceaux; // nombre de morceaux alloués
+	int capacite; // taille de la table des morceaux
+	int nb; // nombre de caractères rangés
+} t_historique;
+
+/**
+* @brief initialise un historique vide, sans allocation
+* @param h type : structure, sortie, historique
+* @return résultat : historique vide
+*/
+
+static inline void hist_init(t_historique *h){
+	h->morceaux = NULL;
+	h->nbMorceaux = 0;
+	h->capacite = 0;
+	h->nb = 0;
+}
+
+/**
+* @brief libère la mémoire de l'historique
+* @param h type : structure, entrée/sortie, historique
+* @return résultat : historique vide
+*/
+
+static inline void hist_liberer(t_historique *h){
+	for (int m = 0; m < h->nbMorceaux; m++) {
+		free(h->morceaux[m]);
+	}
+	free(h->morceaux);
+	hist_init(h);
+}
+
+/**
+* @brief vide l'historique en gardant ses morceaux pour la suite
+* @param h type : structure, entrée/sortie, historique
+* @return résultat : historique vide
+*/
+
+static inline void hist_vider(t_historique *h){
+	h->nb = 0;
+}
+
+/**
+* @brief s'assure qu'un morceau existe pour le caractère d'indice h->nb
+* @param h type : structure, entrée/sortie, historique
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool hist_agrandir(t_historique *h){
+	char **morceaux;
+
+	if ((h->nb >> HIST_DECALAGE) < h->nbMorceaux) {
+		return true;
+	}
+	if (h->nbMorceaux == h->capacite) {
+		morceaux = realloc(h->morceaux, (h->capacite ? 2 * h->capacite : 8) * sizeof(char *));
+		if (morceaux == NULL) {
+			return false;
+		}
+		h->morceaux = morceaux;
+		h->capacite = h->capacite ? 2 * h->capacite : 8;
+	}
+	h->morceaux[h->nbMorceaux] = malloc(HIST_MORCEAU);
+	if (h->morceaux[h->nbMorceaux] == NULL) {
+		return false;
+	}
+	h->nbMorceaux++;
+	return true;
+}
+
+/**
+* @brief ajoute un caractère à la fin de l'historique
+* @param h type : structure, entrée/sortie, historique
+* @param c type : caractère, entrée, caractère de déplacement
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool hist_ajouter(t_historique *h, char c){
+	if (!hist_agrandir(h)) {
+		return false;
+	}
+	h->morceaux[h->nb >> HIST_DECALAGE][h->nb & (HIST_MORCEAU - 1)] = c;
+	h->nb++;
+	return true;
+}
+
+/**
+* @brief lit un caractère de l'historique
+* @param h type : structure, entrée, historique
+* @param i type : entier, entrée, indice du caractère
+* @return résultat : le caractère, '\0' si l'indice est hors de l'historique
+*/
+
+static inline char hist_lire(const t_historique *h, int i){
+	char c = '\0';
+
+	if (i >= 0 && i < h->nb) {
+		c = h->morceaux[i >> HIST_DECALAGE][i & (HIST_MORCEAU - 1)];
+	}
+	return c;
+}
+
+/**
+* @brief donne les caractères rangés à la suite à partir d'un indice, sans
+* copie : ceux du même morceau, jusqu'à la fin de l'historique
+* @param h type : structure, entrée, historique
+* @param i type : entier, entrée, indice du premier caractère
+* @param nb type : entier, sortie, nombre de caractères contigus (0 après la fin)
+* @return résultat : adresse du caractère i, NULL après la fin
+*/
+
+static inline const char *hist_suite(const t_historique *h, int i, int *nb){
+	*nb = 0;
+	if (i < 0 || i >= h->nb) {
+		return NULL;
+	}
+	*nb = HIST_MORCEAU - (i & (HIST_MORCEAU - 1));
+	if (*nb > h->nb - i) {
+		*nb = h->nb - i;
+	}
+	return &h->morceaux[i >> HIST_DECALAGE][i & (HIST_MORCEAU - 1)];
+}
+
+/**
+* @brief retire le dernier caractère de l'historique
+* @param h type : structure, entrée/sortie, historique
+* @return résultat : le caractère retiré, '\0' si l'historique est vide
+*/
+
+static inline char hist_retirer(t_historique *h){
+	char c = hist_lire(h, h->nb - 1);
+
+	if (h->nb > 0) {
+		h->nb--;
+	}
+	return c;
+}
+
+/**
+* @brief cherche un caractère dans l'historique
+* @param h type : structure, entrée, historique
+* @param c type : caractère, entrée, caractère cherché
+* @return résultat : vrai si le caractère est présent
+*/
+
+static inline bool hist_contient(const t_historique *h, char c){
+	bool trouve = false;
+	int taille;
+
+	for (int m = 0; m < h->nbMorceaux && !trouve; m++) {
+		taille = h->nb - m * HIST_MORCEAU;
+		if (taille > HIST_MORCEAU) {
+			taille = HIST_MORCEAU;
+		}
+		trouve = taille > 0 && memchr(h->morceaux[m], c, taille) != NULL;
+	}
+	return trouve;
+}
+
+/**
+* @brief ajoute à l'historique tout le contenu d'un fichier, morceau par morceau
+* @param h type : structure, entrée/sortie, historique
+* @param f type : fichier, entrée, fichier ouvert en lecture
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool hist_lire_fichier(t_historique *h, FILE *f){
+	size_t place; // place libre dans le morceau courant
+	size_t lus = 1;
+
+	while (lus > 0) {
+		if (!hist_agrandir(h)) {
+			return false;
+		}
+		place = HIST_MORCEAU - (h->nb & (HIST_MORCEAU - 1));
+		lus = fread(h->morceaux[h->nb >> HIST_DECALAGE] + (h->nb & (HIST_MORCEAU - 1)),
+			sizeof(char), place, f);
+		h->nb += lus;
+	}
+	return true;
+}
+
+/**
+* @brief écrit tout l'historique dans un fichier
+* @param h type : structure, entrée, historique
+* @param f type : fichier, entrée/sortie, fichier ouvert en écriture
+* @return résultat : caractères écrits
+*/
+
+static inline void hist_ecrire_fichier(const t_historique *h, FILE *f){
+	int taille;
+
+	for (int m = 0; m < h->nbMorceaux; m++) {
+		taille = h->nb - m * HIST_MORCEAU;
+		if (taille > HIST_MORCEAU) {
+			taille = HIST_MORCEAU;
+		}
+		if (taille > 0) {
+			fwrite(h->morceaux[m], sizeof(char), taille, f);
+		}
+	}
+}
+
+#endif
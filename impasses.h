@@ -0,0 +1,192 @@
+/**
+* @file impasses.h
+* @brief Détection des positions sans issue (impasses) d'un niveau de sokoban
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Deux tests, faits après chaque poussée :
+* - les cases mortes, calculées une fois au chargement : une caisse posée sur
+*   une telle case ne peut plus atteindre aucune cible. On les trouve en
+*   tirant une caisse à reculons depuis chaque cible : toute case qu'elle
+*   n'atteint pas est morte. Le test est une lecture de tableau.
+* - le gel : une caisse bloquée horizontalement et verticalement par des murs
+*   ou par d'autres caisses elles-mêmes gelées ne bougera plus jamais. Si une
+*   caisse du groupe gelé n'est pas sur une cible, la partie est perdue. Le
+*   test ne regarde que les voisines de la caisse poussée.
+*
+* Les cases sont numérotées lig * pas + col, où pas vaut au moins la largeur :
+* le solveur utilise pas = largeur et le plateau de bits pas = largeur + 1.
+*/
+
+#ifndef IMPASSES_H
+#define IMPASSES_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define IMPASSE_PROFONDEUR 64 // caisses examinées au plus par un test de gel
+
+//Définition d'un test de gel : le plateau est lu par des fonctions pour que
+//le même test serve au solveur et au plateau de bits
+typedef struct{
+	int pas; // décalage d'une ligne à la suivante
+	int nbCases; // nombre de cases
+	const bool *mortes; // cases mortes
+	bool (*mur)(const void *plateau, int c); // la case est un mur
+	bool (*caisse)(const void *plateau, int c); // la case porte une caisse
+	bool (*cible)(const void *plateau, int c); // la case est une cible
+	const void *plateau; // plateau passé aux trois fonctions
+	int vues[IMPASSE_PROFONDEUR]; // caisses examinées, traitées comme des murs
+	int nbVues; // nombre de caisses examinées
+} t_gel;
+
+/**
+* @brief calcule les cases mortes en tirant une caisse depuis chaque cible :
+* une caisse en q a pu venir de q - d si le joueur pouvait se tenir en q - 2d
+* @param plateau type : tableau, entrée, plateau de caractères
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @param pas type : entier, entrée, décalage d'une ligne (>= largeur)
+* @param mortes type : tableau, sortie, hauteur * pas cases (les murs et les
+	cases au-delà de la largeur sont mortes)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool impasse_cases_mortes(char **plateau, int hauteur, int largeur, int pas, bool mortes[]){
+	int nbCases = hauteur * pas;
+	int *file = malloc((nbCases + 1) * sizeof(int));
+	int debut = 0;
+	int fin = 0;
+	int q;
+	int lig;
+	int col;
+	int dl;
+	int dc;
+	char c;
+
+	if (file == NULL) {
+		return false;
+	}
+	for (q = 0; q < nbCases; q++) {
+		mortes[q] = true;
+	}
+	for (lig = 0; lig < hauteur; lig++) {
+		for (col = 0; col < largeur; col++) {
+			c = plateau[lig][col];
+			if (c == '.' || c == '*' || c == '+') {
+				mortes[lig * pas + col] = false;
+				file[fin++] = lig * pas + col;
+			}
+		}
+	}
+	while (debut < fin) {
+		q = file[debut++];
+		lig = q / pas;
+		col = q % pas;
+		for (int d = 0; d < 4; d++) {
+			dl = (d == 1) - (d == 0);
+			dc = (d == 3) - (d == 2);
+			// case d'où vient la caisse (q - d) et case du joueur (q - 2d)
+			if (lig - 2 * dl >= 0 && lig - 2 * dl < hauteur && col - 2 * dc >= 0 && col - 2 * dc < largeur &&
+				plateau[lig - dl][col - dc] != '#' && plateau[lig - 2 * dl][col - 2 * dc] != '#' &&
+				mortes[(lig - dl) * pas + col - dc]) {
+				mortes[(lig - dl) * pas + col - dc] = false;
+				file[fin++] = (lig - dl) * pas + col - dc;
+			}
+		}
+	}
+	free(file);
+	return true;
+}
+
+/**
+* @brief vérifie si une case compte comme un mur pour le test de gel : mur,
+* bord du plateau ou caisse déjà reconnue gelée
+* @param g type : structure, entrée, test de gel
+* @param c type : entier, entrée, case
+* @return résultat : vrai si la case bloque
+*/
+
+static inline bool impasse_bloque(const t_gel *g, int c){
+	if (c < 0 || c >= g->nbCases || g->mur(g->plateau, c)) {
+		return true;
+	}
+	for (int i = 0; i < g->nbVues; i++) {
+		if (g->vues[i] == c) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline bool impasse_caisse_gelee(t_gel *g, int c);
+
+/**
+* @brief vérifie qu'une caisse ne peut pas bouger le long d'un axe
+* @param g type : structure, entrée/sortie, test de gel
+* @param c type : entier, entrée, case de la caisse
+* @param decalage type : entier, entrée, 1 (horizontal) ou pas (vertical)
+* @return résultat : vrai si la caisse est bloquée sur cet axe
+*/
+
+static inline bool impasse_axe_bloque(t_gel *g, int c, int decalage){
+	int avant = c - decalage;
+	int apres = c + decalage;
+
+	if (impasse_bloque(g, avant) || impasse_bloque(g, apres)) {
+		return true;
+	}
+	if (g->mortes[avant] && g->mortes[apres]) {
+		return true; // elle ne peut bouger que vers une case morte
+	}
+	return (g->caisse(g->plateau, avant) && impasse_caisse_gelee(g, avant)) ||
+		(g->caisse(g->plateau, apres) && impasse_caisse_gelee(g, apres));
+}
+
+/**
+* @brief vérifie qu'une caisse est gelée. Pendant l'examen, elle compte comme
+* un mur pour ses voisines ; si elle n'est pas gelée, elle et les caisses
+* examinées à partir d'elle sont retirées.
+* @param g type : structure, entrée/sortie, test de gel
+* @param c type : entier, entrée, case de la caisse
+* @return résultat : vrai si la caisse ne peut plus bouger
+*/
+
+static inline bool impasse_caisse_gelee(t_gel *g, int c){
+	int nbVues = g->nbVues;
+	bool gelee;
+
+	if (g->nbVues == IMPASSE_PROFONDEUR) {
+		return false; // trop loin : on suppose qu'elle peut bouger
+	}
+	g->vues[g->nbVues++] = c;
+	gelee = impasse_axe_bloque(g, c, 1) && impasse_axe_bloque(g, c, g->pas);
+	if (!gelee) {
+		g->nbVues = nbVues;
+	}
+	return gelee;
+}
+
+/**
+* @brief teste si la caisse qui vient d'être poussée est gelée avec au moins
+* une caisse du groupe hors cible
+* @param g type : structure, entrée/sortie, test de gel préparé
+* @param c type : entier, entrée, case où la caisse vient d'arriver
+* @return résultat : vrai si la position est sans issue
+*/
+
+static inline bool impasse_gel(t_gel *g, int c){
+	g->nbVues = 0;
+	if (!impasse_caisse_gelee(g, c)) {
+		return false;
+	}
+	for (int i = 0; i < g->nbVues; i++) {
+		if (!g->cible(g->plateau, g->vues[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif
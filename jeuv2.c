@@ -8,33 +8,70 @@
 * Ce programme fait tourner un jeu de sokoban dont le but est de déplacer
 * toutes les caisses sur des cibles pour gagner la partie.
 *
+* Le plateau reste en caractères, sans plans de bits (plateau_bits.h) : chaque
+* coup passe par le journal pour annuler et refaire, et l'image est faite par
+* différence sur ces caractères. Un coup ne lit que deux cases (table de
+* transitions.h) et gagner lit le compte des caisses hors cible : des plans
+* tenus à jour en plus doubleraient les écritures sans rien accélérer. Les
+* plans servent là où de longues suites sont rejouées sans affichage
+* (rejouer_bits dans sokoban.c).
+*
 */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-#include <termios.h>
 #include <unistd.h>
-#include <fcntl.h>
+#include <time.h>
+#include <string.h>
+#include <ctype.h>
+#include "niveau.h"
+#include "paquet.h"
+#include "historique.h"
+#include "journal.h"
+#include "transitions.h"
+#include "binaire.h"
+#include "ecran.h"
+#include "clavier.h"
+#include "compteurs.h"
 
 // Définition de la taille du tableau.
-#define MAXLIG 12
-#define MAXDEP 10000
 #define MAXECH 3
 #define MINECH 1
 #define TAILLE_FICHIER 50
+#define TAILLE_TITRE 64
+#define TAILLE_COUPS 1024 // caractères d'une suite de coups tapée au clavier
 
-typedef char t_plateau[MAXLIG][MAXLIG];
-typedef char t_tabDeplacement[MAXDEP];
+typedef char **t_plateau; // lignes du plateau, taille lue dans le fichier
 
 //Définition de la structure de jeu
 typedef struct{
 	int posx; // position horizontale du joueur
 	int posy; // position verticale du joueur
 	int nbDep; // nombre de déplacements effectués
+	int nbCaisses; // nombre de caisses qui ne sont pas sur une cible
 	int echelle; // taille initiale du plateau
+	int hauteur; // nombre de lignes du plateau
+	int largeur; // nombre de colonnes du plateau
+	t_arene *arene; // mémoire qui contient le plateau
+	t_paquet *paquet; // recueil du niveau, gardé ouvert pour recommencer
+	char titre[TAILLE_TITRE]; // titre du niveau dans son recueil ("" : aucun)
+	uint64_t empreinte; // empreinte du niveau, écrite dans les fichiers .depb
 	t_plateau plateau; // déclaration du plateau de jeu
-	t_tabDeplacement historiqueDep; // déclaration du tableau des déplacements
+	t_historique historiqueDep; // historique des déplacements, sans limite
+	t_journal journal; // changements des coups, pour annuler et refaire
+	t_ecran ecran; // image affichée, envoyée par différence
+	bool choix; // le curseur de destination est affiché
+	int curx; // ligne du curseur de destination
+	int cury; // colonne du curseur de destination
+	bool inaccessible; // la dernière destination n'a pas de chemin
+	int *venu; // direction d'arrivée sur chaque case pendant la recherche d'un chemin
+	int *file; // file de la recherche, puis directions du chemin
+	bool suite; // la dernière touche a joué une suite de coups
+	t_bilan bilan; // bilan de cette suite
+	int nbImages; // images affichées après une touche
+	double latence; // somme des durées touche -> image (microsecondes)
+	double latenceMax; // plus longue durée touche -> image
 } t_partie;
 
 
@@ -55,8 +92,13 @@ const char DROITE = 'd';
 const char QUITTER = 'x';
 const char RECOMMENCER = 'r';
 const char RETOUR = 'u';
+const char REFAIRE = 'y';
 const char ZOOMER = '+';
 const char DEZOOMER = '-';
+const char ALLER = 'g';
+const char COORDONNEES = 'c';
+const char CURSEUR = 'X';
+const char SUITE = 'm';
 
 // Définition des caractères de déplacement
 const char DEP_GAUCHE = 'g';
@@ -70,21 +112,27 @@ const char CAISSE_BAS = 'B';
 
 
 // liste des procédures déclarées
-void chargerPartie(t_plateau plateau, char fichier[]);
-void enregistrerPartie(t_plateau plateau, char fichier[]);
+void chargerPartie(t_partie *jeu, char fichier[]);
+void enregistrerPartie(t_partie *jeu, char fichier[]);
 void afficher_entete(t_partie *jeu, char fichier[]);
 void afficher_plateau(t_partie *jeu);
 void chercher_joueur(t_partie *jeu);
-int kbhit();
-void enregistrerDeplacements(t_tabDeplacement t, int nb, char fic[]);
+bool dans_plateau(t_partie *jeu, int lig, int col);
+void enregistrerDeplacements(t_historique *t, char fic[], uint64_t empreinte);
 void abandonner_partie(t_partie *jeu, char fichier[]);
 void recommencer_partie(t_partie *jeu, char fichier[]);
 void conditions_dep(t_partie *jeu, int depx, int depy, char touche);
-void deplacer_joueur(t_partie *jeu, int depx, int depy);
-void deplacer_caisse(t_partie *jeu, int depx, int depy, int casx, int casy);
-void annuler_deplacer(t_partie *jeu, char last);
+bool annuler_coup(t_partie *jeu);
+int jouer_coups(t_partie *jeu, const char coups[], int nb, t_bilan *bilan);
+void saisir_coups(t_partie *jeu);
 void jouer(t_partie *jeu, char fichier[]);
+void deplacer_curseur(t_partie *jeu, char touche);
+void choisir_coordonnees(t_partie *jeu);
+int chercher_chemin(t_partie *jeu, int lig, int col);
+int aller_vers(t_partie *jeu, int lig, int col);
 bool gagner(t_partie *jeu);
+void afficher_latence(t_partie *jeu);
+double temps_us();
 
 /**
 * @brief coeur du programme
@@ -93,19 +141,37 @@ bool gagner(t_partie *jeu);
 */
 
 int main(){
+	cpt_demarrer("jeuv2"); // compteurs écrits en JSON si SOKOBAN_COMPTEURS est défini
 	t_partie jeu;
+	t_arene arene; // mémoire du plateau
+	t_paquet paquet; // recueil de niveaux (fichier.xsb#N)
+	arene_init(&arene);
+	paquet_init(&paquet);
+	jeu.arene = &arene;
+	jeu.paquet = &paquet;
 	jeu.posx = 0; // initialisation de la position
 	jeu.posy = 0; 
 	jeu.nbDep = 0; // initialisation du nombre de déplacements
+	hist_init(&jeu.historiqueDep); // rien n'est alloué avant le premier déplacement
+	jour_init(&jeu.journal);
 	jeu.echelle = 1; // définition de l'echelle
+	ecran_init(&jeu.ecran);
+	jeu.choix = false;
+	jeu.inaccessible = false;
+	jeu.suite = false;
+	jeu.nbImages = 0;
+	jeu.latence = 0;
+	jeu.latenceMax = 0;
 	char fichier[TAILLE_FICHIER]; // nom du fichier de sauvegarde
 	char valider; // pour permettre de valider les enregistrements
 
 	// sélection du niveau
-	printf("Quel niveau voulez vous charger ? (ex: niveau1.sok) : ");
+	printf("Quel niveau voulez vous charger ? (ex: niveau1.sok ou recueil.xsb#12) : ");
 	scanf("%s", fichier); // sélection du fichier
+	while (getchar() != '\n' && !feof(stdin)); // reste de la ligne
 
-	chargerPartie(jeu.plateau, fichier); // charge le fichier
+	chargerPartie(&jeu, fichier); // charge le fichier
+	clavier_brut(); // une seule fois : remis à la sortie ou sur signal
 	afficher_entete(&jeu, fichier); 
 	afficher_plateau(&jeu);
 	chercher_joueur(&jeu);
@@ -115,66 +181,86 @@ int main(){
 	// permet de faire des modifications au programme (ex : déplacements)
 	}
 	// affichage des résultats
+	clavier_normal();
+	afficher_latence(&jeu);
 	printf("Vous avez gagné la partie avec %d déplacements !\n", jeu.nbDep);
 	printf("Souhaitez-vous sauvegarder vos déplacements ? y/n : \n");
 	scanf("%c", &valider);
 	if (valider == 'y'){
 		printf("Entrez le nom du fichier (en .dep) :");
 		scanf("%s", fichier); // saisie du fichier
-		enregistrerDeplacements(jeu.historiqueDep, jeu.nbDep, fichier);
+		enregistrerDeplacements(&jeu.historiqueDep, fichier, jeu.empreinte);
 	}
 
-	system("clear"); // effacement de l'affichage
+	ecran_nettoyer(); // effacement de l'affichage
 
 	printf("Merci d'avoir joué !! \n");
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	hist_liberer(&jeu.historiqueDep);
+	jour_liberer(&jeu.journal);
+	ecran_liberer(&jeu.ecran);
 	return EXIT_SUCCESS;
 }
 
 /**
-* @brief charge les caractères sur lignes et colonnes de la partie
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param fichier type : entier, entrée, fichier de la partie chargée
+* @brief charge le plateau de la partie, de taille quelconque, dans l'arène
+	de la partie et compte les caisses qui ne sont pas sur une cible
+* @param jeu type : structure, entrée/sortie, partie à charger
+* @param fichier type : entier, entrée, fichier de la partie chargée (ou
+	recueil.xsb#N, voir paquet.h)
 * @return résultat : chargement de la partie
 */
 
-void chargerPartie(t_plateau plateau, char fichier[]){
-    FILE * f;
-    char finDeLigne;
-	int TAILLE = 12;
-
-    f = fopen(fichier, "r");
-    if (f==NULL){
-        printf("ERREUR SUR FICHIER");
-        exit(EXIT_FAILURE);
-    } else {
-        for (int ligne=0 ; ligne<TAILLE ; ligne++){
-            for (int colonne=0 ; colonne<TAILLE ; colonne++){
-                fread(&plateau[ligne][colonne], sizeof(char), 1, f);
-            }
-            fread(&finDeLigne, sizeof(char), 1, f);
-        }
-        fclose(f);
-    }
+void chargerPartie(t_partie *jeu, char fichier[]){
+	char nom[PAQUET_NOM]; // fichier sans le numéro du niveau
+	int numero; // numéro du niveau dans le recueil (0 : fichier seul)
+	uint64_t debut = cpt_maintenant();
+
+	arene_vider(jeu->arene);
+	if (!paquet_charger(jeu->paquet, fichier, jeu->arene, &jeu->plateau, &jeu->hauteur, &jeu->largeur)){
+		printf("ERREUR SUR FICHIER");
+		exit(EXIT_FAILURE);
+	}
+	jeu->empreinte = bin_empreinte(jeu->plateau, jeu->hauteur, jeu->largeur);
+	// recherche des chemins vers une case choisie, prise aussi dans l'arène
+	jeu->venu = arene_allouer(jeu->arene, jeu->hauteur * jeu->largeur * sizeof(int));
+	jeu->file = arene_allouer(jeu->arene, jeu->hauteur * jeu->largeur * sizeof(int));
+	if (jeu->venu == NULL || jeu->file == NULL) {
+		printf("ERREUR SUR FICHIER");
+		exit(EXIT_FAILURE);
+	}
+	jeu->choix = false;
+	jeu->suite = false;
+	jeu->titre[0] = '\0';
+	if (paquet_separer(fichier, nom, &numero) && numero > 0) {
+		paquet_titre(jeu->paquet, numero, jeu->titre, TAILLE_TITRE);
+	}
+	jeu->nbCaisses = 0;
+	for (int lig=0; lig < jeu->hauteur; lig++) {
+		for (int col=0; col < jeu->largeur; col++) {
+			if (jeu->plateau[lig][col] == CAISSE) {
+				jeu->nbCaisses++;
+			}
+		}
+	}
+	cpt_fin(CPT_NIVEAUX, debut);
 }
 
 /**
 * @brief enregistre les caractères de chaque ligne et colonne de la partie
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
+* @param jeu type : structure, entrée, partie à enregistrer
 * @param fichier type : entier, entrée, fichier de la partie chargée
 * @return résultat : affichage du plateau
 */
 
-void enregistrerPartie(t_plateau plateau, char fichier[]){
+void enregistrerPartie(t_partie *jeu, char fichier[]){
     FILE * f;
     char finDeLigne='\n';
-	int TAILLE = 12;
-
 
     f = fopen(fichier, "w");
-    for (int ligne=0 ; ligne<TAILLE ; ligne++){
-        for (int colonne=0 ; colonne<TAILLE ; colonne++){
-            fwrite(&plateau[ligne][colonne], sizeof(char), 1, f);
-        }
+    for (int ligne=0 ; ligne<jeu->hauteur ; ligne++){
+        fwrite(jeu->plateau[ligne], sizeof(char), jeu->largeur, f);
         fwrite(&finDeLigne, sizeof(char), 1, f);
     }
     fclose(f);
@@ -188,14 +274,37 @@ void enregistrerPartie(t_plateau plateau, char fichier[]){
 */
 
 void afficher_entete(t_partie *jeu, char fichier[]){
+	t_ecran *e = &jeu->ecran;
 
-	system("clear");
-	printf(" Nom de la partie : %s\n\n", fichier);
-	printf(" Haut : z\n Bas : s\n Gauche : q\n Droite : d\n");
-	printf(" Pour abandonner la partie : x\n Pour continuer la partie : r\n");
-	printf(" Pour annuler un déplacement : u\n");
-	printf(" Pour agrandir le plateau : +\n Pour le rétrécir : -\n\n");
-	printf(" Nombre de déplacement : %d\n\n", jeu->nbDep);
+	ecran_debut(e); // l'image est envoyée par afficher_plateau
+	ecran_printf(e, " Nom de la partie : %s\n", fichier);
+	if (jeu->titre[0] != '\0') {
+		ecran_printf(e, " Titre : %s\n", jeu->titre);
+	}
+	ecran_printf(e, "\n");
+	ecran_printf(e, " Haut : z\n Bas : s\n Gauche : q\n Droite : d\n");
+	ecran_printf(e, " Pour abandonner la partie : x\n Pour continuer la partie : r\n");
+	ecran_printf(e, " Pour annuler un déplacement : u\n Pour le refaire : y\n");
+	ecran_printf(e, " Pour agrandir le plateau : +\n Pour le rétrécir : -\n");
+	ecran_printf(e, " Pour aller à une case : g (curseur) ou c (coordonnées)\n");
+	ecran_printf(e, " Pour jouer une suite de coups (h b g d u) : m\n\n");
+	ecran_printf(e, " Nombre de déplacement : %d\n", jeu->nbDep);
+	if (jeu->choix) {
+		ecran_printf(e, " Destination : ligne %d, colonne %d (z q s d pour choisir,"
+			" g ou entrée pour y aller, x pour annuler)\n", jeu->curx + 1, jeu->cury + 1);
+	}
+	else if (jeu->inaccessible) {
+		ecran_printf(e, " Aucun chemin vers cette case\n");
+	}
+	else if (jeu->suite) {
+		ecran_printf(e, " Suite : %d coups, %d poussées, %d annulations", jeu->bilan.nbCoups,
+			jeu->bilan.nbPoussees, jeu->bilan.nbAnnulations);
+		if (jeu->bilan.illegal >= 0) {
+			ecran_printf(e, ", arrêtée au caractère %d (coup impossible)", jeu->bilan.illegal + 1);
+		}
+		ecran_printf(e, "\n");
+	}
+	ecran_printf(e, "\n");
 }
 
 /**
@@ -209,9 +318,9 @@ void afficher_plateau(t_partie *jeu){
 	char caractere; // caractère de la case correspondante
 	char affiche; // affichage de la case
 
-	for (int lig=0; lig < MAXLIG; lig++) {
+	for (int lig=0; lig < jeu->hauteur; lig++) {
 		for (int ligchar=0; ligchar < jeu->echelle; ligchar++) {
-			for (int col=0; col < MAXLIG; col++) {
+			for (int col=0; col < jeu->largeur; col++) {
 				caractere = jeu->plateau[lig][col];
 				// pour afficher correctement le joueur et la caisse sur cible 
 				if (caractere == JOUEUR_CIBLE) {
@@ -223,13 +332,20 @@ void afficher_plateau(t_partie *jeu){
 				else {
 					affiche = caractere;
 				}
+				if (jeu->choix && lig == jeu->curx && col == jeu->cury) {
+					affiche = CURSEUR; // destination en cours de choix
+				}
 				for (int colchar=0; colchar < jeu->echelle; colchar++) {
-						printf("%c", affiche); 
-					}
+					ecran_car(&jeu->ecran, affiche);
+				}
 			}	
-			printf("\n"); // nouvelle ligne de tableau
+			ecran_car(&jeu->ecran, '\n'); // nouvelle ligne de tableau
 		}
 	}
+	ecran_afficher(&jeu->ecran); // seules les cases changées sont envoyées
+	cpt_ajouter(CPT_IMAGES, 1);
+	cpt_duree(CPT_IMAGES, (uint64_t)(jeu->ecran.duree * 1e3));
+	cpt_ajouter(CPT_OCTETS, jeu->ecran.nbSortie);
 }
 
 /**
@@ -241,8 +357,8 @@ void afficher_plateau(t_partie *jeu){
 */
 
 void chercher_joueur(t_partie *jeu){
-	for (int lig=0; lig < MAXLIG; lig++) {
-		for (int col=0; col < MAXLIG; col++) {
+	for (int lig=0; lig < jeu->hauteur; lig++) {
+		for (int col=0; col < jeu->largeur; col++) {
 			// si on trouve le joueur
 			if ((jeu->plateau[lig][col] == JOUEUR) ||
 				 (jeu->plateau[lig][col] == JOUEUR_CIBLE)) {
@@ -253,50 +369,38 @@ void chercher_joueur(t_partie *jeu){
 	}
 }
 
-int kbhit() {
-	// la fonction retourne :
-	// 1 si un caractere est present
-	// 0 si pas de caractere présent
-	int unCaractere=0;
-	struct termios oldt, newt;
-	int ch;
-	int oldf;
-
-	// mettre le terminal en mode non bloquant
-	tcgetattr(STDIN_FILENO, &oldt);
-	newt = oldt;
-	newt.c_lflag &= ~(ICANON | ECHO);
-	tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-	oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-	fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
- 
-	ch = getchar();
-
-	// restaurer le mode du terminal
-	tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-	fcntl(STDIN_FILENO, F_SETFL, oldf);
- 
-	if (ch != EOF) {
-		ungetc(ch, stdin);
-		unCaractere=1;
-	} 
-	return unCaractere;
+/**
+* @brief vérifie qu'une case est dans le plateau
+* @param jeu type : structure, entrée, partie en cours
+* @param lig type : entier, entrée, ligne de la case
+* @param col type : entier, entrée, colonne de la case
+* @return résultat : vrai si la case existe (les autres comptent comme des murs)
+*/
+
+bool dans_plateau(t_partie *jeu, int lig, int col){
+	return lig >= 0 && lig < jeu->hauteur && col >= 0 && col < jeu->largeur;
 }
 
 /**
-* @brief enregistre les déplacements
-* @param t type : tableau entrée/sortie importe le tableau des déplacements
-* @param nb type : entier entrée nombre de cases (déplacements faits)
+* @brief enregistre les déplacements, en binaire si le nom finit par .depb
+* @param t type : structure entrée historique des déplacements
 * @param fic type : chaine entrée fichier d'enregistrement
+* @param empreinte type : entier entrée empreinte du niveau (voir binaire.h)
 * @return résultat : fichier des déplacements créé
 */
 
-void enregistrerDeplacements(t_tabDeplacement t, int nb, char fic[]){
+void enregistrerDeplacements(t_historique *t, char fic[], uint64_t empreinte){
     FILE * f;
 
+    if (bin_extension(fic)) {
+        bin_enregistrer(t, fic, empreinte);
+        return;
+    }
     f = fopen(fic, "w");
-    fwrite(t,sizeof(char), nb, f);
-    fclose(f);
+    if (f != NULL) {
+        hist_ecrire_fichier(t, f);
+        fclose(f);
+    }
 }
 /**
 * @brief le joueur abandonne, enregistrement des tableaux sur demande
@@ -309,12 +413,14 @@ void enregistrerDeplacements(t_tabDeplacement t, int nb, char fic[]){
 
 void abandonner_partie(t_partie *jeu, char fichier[]){
 	char validation;
+	clavier_normal(); // questions lues ligne par ligne, avec écho
+	afficher_latence(jeu);
 	printf("Souhaitez-vous sauvegarder votre progression ? \n y/n :");
 	scanf("%c", &validation);
 	if (validation == 'y') {
 		printf("Nommez le fichier de sauvegarde : ");
 		scanf("%s", fichier);
-		enregistrerPartie(jeu->plateau, fichier); // enregistre le plateau de jeu
+		enregistrerPartie(jeu, fichier); // enregistre le plateau de jeu
 		printf("Partie sauvegardée dans le fichier %s\n", fichier);
 	}
 
@@ -325,11 +431,11 @@ void abandonner_partie(t_partie *jeu, char fichier[]){
 	if (validation == 'y') {
 		printf("Nommez le fichier de sauvegarde : ");
 		scanf("%s", fichier);
-		enregistrerDeplacements(jeu->historiqueDep, jeu->nbDep, fichier);
+		enregistrerDeplacements(&jeu->historiqueDep, fichier, jeu->empreinte);
 		printf("Partie sauvegardée dans le fichier %s\n", fichier);
 	}
 
-	system("clear");
+	ecran_nettoyer();
 
 	printf("Au revoir !\n");
 	exit(0);
@@ -349,13 +455,18 @@ void abandonner_partie(t_partie *jeu, char fichier[]){
 void recommencer_partie(t_partie *jeu, char fichier[]){
 
 	char validation;
+	clavier_normal();
 	printf("Recommencer la partie ? (y/n) ");
     		scanf(" %c", &validation);
 		    if (validation == 'y') {
-    		    chargerPartie(jeu->plateau, fichier);
+    		    chargerPartie(jeu, fichier);
     		    chercher_joueur(jeu);
 				jeu->nbDep = 0; // Réinitialise le nombre de déplacements
+				hist_vider(&jeu->historiqueDep);
+				jour_vider(&jeu->journal);
 				}
+	clavier_brut();
+	ecran_effacer(&jeu->ecran); // la question reste à l'écran sinon
 }
 
 /**
@@ -378,34 +489,47 @@ void conditions_dep(t_partie *jeu, int depx, int depy, char touche){
 	
 	int casx; // case de destination de la caisse
 	int casy; 
+	t_delta *delta; // cases que le coup peut changer, pour l'annuler
+
+	// le joueur, la case visée et celle d'après
+	delta = jour_ouvrir(&jeu->journal, jeu->posx, jeu->posy, jeu->nbCaisses);
+	if (delta != NULL) {
+		jour_noter(delta, jeu->plateau, jeu->posx, jeu->posy);
+		if (dans_plateau(jeu, depx, depy)) {
+			jour_noter(delta, jeu->plateau, depx, depy);
+		}
+		if (dans_plateau(jeu, 2 * depx - jeu->posx, 2 * depy - jeu->posy)) {
+			jour_noter(delta, jeu->plateau, 2 * depx - jeu->posx, 2 * depy - jeu->posy);
+		}
+	}
 
-	if (jeu->plateau[depx][depy] != MUR) {
+	if (dans_plateau(jeu, depx, depy) && jeu->plateau[depx][depy] != MUR) {
 
-		if ((jeu->plateau[depx][depy] == CAISSE) || 
-		(jeu->plateau[depx][depy] == CAISSE_CIBLE)) {
+		if (trans_est_caisse(jeu->plateau[depx][depy])) {
 			// calcul de la case de destination de la caisse
 			casx = depx + (depx - jeu->posx);
 			casy = depy + (depy - jeu->posy);
 			// colision avec un mur ou une autre caisse
-			if ((jeu->plateau[casx][casy] != MUR) && 
-				(jeu->plateau[casx][casy] != CAISSE) && 
-				(jeu->plateau[casx][casy] != CAISSE_CIBLE)) {
-				deplacer_caisse(jeu, depx, depy, casx, casy);
-				deplacer_joueur(jeu, depx, depy);
+			if (dans_plateau(jeu, casx, casy) &&
+				trans_accueille(jeu->plateau[casx][casy])) {
+				trans_caisse(jeu->plateau, depx, depy, casx, casy, &jeu->nbCaisses);
+				trans_joueur(jeu->plateau, &jeu->posx, &jeu->posy, depx, depy);
 				jeu->nbDep++;
+				cpt_ajouter(CPT_COUPS, 1);
+				cpt_ajouter(CPT_POUSSEES, 1);
 				//enregistrement des déplacements de la caisse
 				switch (touche) {
 				case HAUT:
-					jeu->historiqueDep[jeu->nbDep] = CAISSE_HAUT;
+					hist_ajouter(&jeu->historiqueDep, CAISSE_HAUT);
 					break;
 				case BAS:
-					jeu->historiqueDep[jeu->nbDep] = CAISSE_BAS;
+					hist_ajouter(&jeu->historiqueDep, CAISSE_BAS);
 					break;
 				case GAUCHE:
-					jeu->historiqueDep[jeu->nbDep] = CAISSE_GAUCHE;
+					hist_ajouter(&jeu->historiqueDep, CAISSE_GAUCHE);
 					break;
 				case DROITE:
-					jeu->historiqueDep[jeu->nbDep] = CAISSE_DROITE;
+					hist_ajouter(&jeu->historiqueDep, CAISSE_DROITE);
 					break;
 				default:
 					break;
@@ -414,241 +538,406 @@ void conditions_dep(t_partie *jeu, int depx, int depy, char touche){
 		}
 		// Uniquement les déplacements du joueur
 		else {
-			deplacer_joueur(jeu, depx, depy);
+			trans_joueur(jeu->plateau, &jeu->posx, &jeu->posy, depx, depy);
 			jeu->nbDep++;
+			cpt_ajouter(CPT_COUPS, 1);
 			// enregistrement des déplacements du joueur
 			switch (touche) {
 				case HAUT:
-					jeu->historiqueDep[jeu->nbDep] = DEP_HAUT;
+					hist_ajouter(&jeu->historiqueDep, DEP_HAUT);
 					break;
 				case BAS:
-					jeu->historiqueDep[jeu->nbDep] = DEP_BAS;
+					hist_ajouter(&jeu->historiqueDep, DEP_BAS);
 					break;
 				case GAUCHE:
-					jeu->historiqueDep[jeu->nbDep] = DEP_GAUCHE;
+					hist_ajouter(&jeu->historiqueDep, DEP_GAUCHE);
 					break;
 				case DROITE:
-					jeu->historiqueDep[jeu->nbDep] = DEP_DROITE;
+					hist_ajouter(&jeu->historiqueDep, DEP_DROITE);
 					break;
 				default:
 					break;
 			}
 		}
 	}
+	// un coup bloqué n'est pas gardé : jour_fermer le voit au joueur immobile
+	if (delta != NULL && jeu->historiqueDep.nb > 0) {
+		jour_fermer(&jeu->journal, jeu->plateau, jeu->posx, jeu->posy, jeu->nbCaisses,
+			hist_lire(&jeu->historiqueDep, jeu->historiqueDep.nb - 1));
+	}
 }
 
 /**
-* @brief introduit les conditions de déplacement du joueur
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param depx type : entier, entrée, case de déplacement horizontale joueur
-* @param depy type : entier, entrée, case de déplacement verticale joueur
-* @param casx type : entier, entrée/sortie, case de déplacement horizontale caisse
-* @param casy type : entier, entrée/sortie, case de déplacement verticale caisse
-* @return résultat : le joueur peut/peut pas se déplacer
+* @brief annule le dernier coup : le plateau reprend les cases d'avant le
+* coup (voir journal.h) et son caractère est retiré de l'historique
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @return résultat : faux s'il n'y a plus de coup à annuler
 */
 
-void deplacer_joueur(t_partie *jeu, int depx, int depy){
-	// si le joueur est déplacé depuis une cible
-	if (jeu->plateau[jeu->posx][jeu->posy] == JOUEUR_CIBLE) {
-		jeu->plateau[jeu->posx][jeu->posy] = CIBLE;
-	}
-	else {
-		jeu->plateau[jeu->posx][jeu->posy] = CASE;
-	}
-	jeu->posx = depx; // mise à jour de la position du joueur
-	jeu->posy = depy;
-	// si le joueur est déplacé sur une cible
-	if (jeu->plateau[depx][depy] == CIBLE) {
-		jeu->plateau[jeu->posx][jeu->posy] = JOUEUR_CIBLE;
-	}
-	else {
-		jeu->plateau[jeu->posx][jeu->posy] = JOUEUR;
+bool annuler_coup(t_partie *jeu){
+	if (jour_annuler(&jeu->journal, jeu->plateau, &jeu->posx, &jeu->posy, &jeu->nbCaisses) == '\0') {
+		return false;
 	}
+	hist_retirer(&jeu->historiqueDep); // retire le dernier caractère
+	jeu->nbDep--; // décrementation du nombre de déplacement
+	cpt_ajouter(CPT_ANNULATIONS, 1);
+	return true;
 }
 
 /**
-* @brief introduit les conditions de déplacement de la caisse
+* @brief cette procédure contient les touches et conditions pour jouer.
 * @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param depx type : entier, entrée, case initiale horizontale caisse
-* @param depy type : entier, entrée, case initiale verticale caisse
-* @param casx type : entier, entrée, case de déplacement horizontale caisse
-* @param casy type : entier, entrée, case de déplacement verticale caisse
-* @return résultat : la caisse peut/peut pas se déplacer
+* @param historiqueDep type : tableau, entrée/sortie, importe le 
+	tableau des déplacements
+* @param posx type : entier, entrée/sortie, position verticale du joueur
+* @param posy type : entier, entrée/sortie, position horizontale du joueur
+* @param nbDep type : entier, entrée/sortie, nombre de déplacements
+* @param echelle type : entier, entrée, taille du tableau
+* @param fichier type : chaine, entrée, fichier de sauvegarde
+* @return résultat : permet de jouer au jeu
 */
 
-void deplacer_caisse(t_partie *jeu, int depx, int depy, int casx, int casy){
-	// si la caisse est déplacée depuis une cible
-	if (jeu->plateau[depx][depy] == CAISSE_CIBLE) {
-		jeu->plateau[depx][depy] = CIBLE;
-	// si la caisse sur cible est déplacée sur une cible
-		if (jeu->plateau[casx][casy] == CIBLE) {
-			jeu->plateau[casx][casy] = CAISSE_CIBLE; 
-			}
+void jouer(t_partie *jeu, char fichier[]){
+
+	char touche; // touche de déplacement
+	char last; // caractère des déplacements du joueur
+	int depx = jeu->posx;  // case de déplacement du joueur
+	int depy = jeu->posy;
+	int lu; // touche lue ou CLAVIER_AUCUNE / CLAVIER_FIN
+	double debut; // arrivée de la touche
+
+	// attente de la touche : le programme dort jusqu'à ce qu'elle arrive
+	lu = clavier_attendre(CLAVIER_INFINI);
+	if (lu == CLAVIER_FIN) {
+		// entrée fermée : plus aucune touche ne viendra
+		clavier_normal();
+		ecran_nettoyer();
+		printf("Au revoir !\n");
+		exit(0);
+	}
+	debut = temps_us();
+	touche = lu == CLAVIER_AUCUNE ? '\0' : (char)lu;
+	// déplacement du joueur
+	if (touche != '\0') {
+		jeu->inaccessible = false;
+		jeu->suite = false;
+		if (jeu->choix) {
+			deplacer_curseur(jeu, touche);
+		}
 		else {
-			jeu->plateau[casx][casy] = CAISSE; 
+			switch (touche) {
+				case HAUT:
+					depx--; // déplacement joueur haut
+					break;
+				case BAS:
+					depx++; // déplacement joueur bas
+					break;
+				case GAUCHE:
+					depy--; // déplacement joueur gauche
+					break;
+				case DROITE:
+					depy++; // déplacement joueur droite
+					break;
+				case RETOUR:
+					annuler_coup(jeu);
+					break;
+				case REFAIRE:
+					last = jour_refaire(&jeu->journal, jeu->plateau, &jeu->posx, &jeu->posy, &jeu->nbCaisses);
+					if (last != '\0') {
+						hist_ajouter(&jeu->historiqueDep, last);
+						jeu->nbDep++;
+						cpt_ajouter(CPT_REFAITS, 1);
+					}
+					break;
+				case ZOOMER:
+					if (jeu->echelle < MAXECH) {
+						jeu->echelle++;
+					}
+					break;
+				case DEZOOMER:
+					if (jeu->echelle > MINECH) {
+						jeu->echelle--;
+					}
+					break;
+				case ALLER:
+					// le curseur part du joueur
+					jeu->choix = true;
+					jeu->curx = jeu->posx;
+					jeu->cury = jeu->posy;
+					break;
+				case COORDONNEES:
+					choisir_coordonnees(jeu);
+					break;
+				case SUITE:
+					saisir_coups(jeu);
+					break;
+				case QUITTER:
+					abandonner_partie(jeu, fichier);
+					break;
+				case RECOMMENCER:
+					recommencer_partie(jeu, fichier);
+					break;
+				default:
+					break;
+			}
+			// si les touches sont celles de déplacements on utilise les conditions
+			if (touche == HAUT || touche == BAS || touche == DROITE || touche == GAUCHE) {
+			// si la case de destination n'est pas un mur
+				conditions_dep(jeu, depx, depy, touche);
+			}
+		}
+		afficher_entete(jeu, fichier);
+		afficher_plateau(jeu);
+		debut = temps_us() - debut;
+		jeu->nbImages++;
+		jeu->latence += debut;
+		if (debut > jeu->latenceMax) {
+			jeu->latenceMax = debut;
 		}
 	}
-	// si la caisse est déplacée sur une cible
-	else if (jeu->plateau[casx][casy] == CIBLE) {
-		jeu->plateau[casx][casy] = CAISSE_CIBLE; 
+}
+
+
+/**
+* @brief déplace le curseur de destination, ou part vers la case choisie
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @param touche type : caractère, entrée, touche appuyée
+* @return résultat : curseur déplacé (sans sortir du plateau), chemin joué
+	avec g ou entrée, choix abandonné avec x
+*/
+
+void deplacer_curseur(t_partie *jeu, char touche){
+	if (touche == HAUT && jeu->curx > 0) {
+		jeu->curx--;
 	}
-	else {
-		jeu->plateau[casx][casy] = CAISSE; 
+	else if (touche == BAS && jeu->curx < jeu->hauteur - 1) {
+		jeu->curx++;
+	}
+	else if (touche == GAUCHE && jeu->cury > 0) {
+		jeu->cury--;
+	}
+	else if (touche == DROITE && jeu->cury < jeu->largeur - 1) {
+		jeu->cury++;
+	}
+	else if (touche == ALLER || touche == '\n' || touche == '\r') {
+		jeu->choix = false;
+		aller_vers(jeu, jeu->curx, jeu->cury);
+	}
+	else if (touche == QUITTER) {
+		jeu->choix = false;
 	}
 }
 
 /**
-* @brief cette procédure permet d'annuler les déplacements précédents
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param posx type : entier, entrée/sortie, position verticale du joueur
-* @param posy type : entier, entrée/sortie, position horizontale du joueur
-* @param last type : caractère, entrée, stocke le tableau des déplacements
-* @return résultat : retourne le perso et/ou caisse sur l'ancien deplacement
+* @brief demande la ligne et la colonne d'une case, puis y va
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @return résultat : chemin joué si la case est accessible
 */
 
-void annuler_deplacer(t_partie *jeu, char last){
+void choisir_coordonnees(t_partie *jeu){
+	int lig;
+	int col;
 
-	int depx = jeu->posx; //case de déplacement horizontale
-	int depy = jeu->posy; //case de déplacement verticale
-	int casx; // case de déplacement de la caisse
-	int casy; 
-	int ancienx; // ancienne case de la caisse
-	int ancieny; 
-
-	if (last == DEP_HAUT || last == CAISSE_HAUT) {
-		depx++; //déplacement vers le Haut
-	}
-	else if (last == DEP_BAS || last == CAISSE_BAS) {
-		depx--; //déplacement vers le Bas
-	}
-	else if (last == DEP_GAUCHE || last == CAISSE_GAUCHE) {
-		depy++; //déplacement à Droite
-	}
-	else if (last == DEP_DROITE || last == CAISSE_DROITE) {
-		depy--; //déplacement à Gauche
-	}
-	// la case de destination de la caisse correspond a l'ancienne du personnage
-	casx = jeu->posx;
-	casy = jeu->posy;
-	// changement de position du caractère
-	deplacer_joueur(jeu, depx, depy);
-	// si les anciens déplacements correspondent à celui d'une caisse
-	if (last == CAISSE_HAUT ||
-		last == CAISSE_BAS ||
-		last == CAISSE_GAUCHE ||
-		last == CAISSE_DROITE) {
-		// ancienne position de la caisse
-		ancienx = casx + (casx - jeu->posx);
-		ancieny = casy + (casy - jeu->posy);
-		// si ancienne position de la caisse = cible
-		if (jeu->plateau[ancienx][ancieny] == CAISSE_CIBLE) {
-			jeu->plateau[ancienx][ancieny] = CIBLE;
+	clavier_normal(); // saisie lue ligne par ligne, avec écho
+	printf("Aller à la case (ligne colonne, à partir de 1) : ");
+	if (scanf("%d %d", &lig, &col) == 2) {
+		aller_vers(jeu, lig - 1, col - 1);
+	}
+	while (getchar() != '\n' && !feof(stdin)); // reste de la ligne
+	clavier_brut();
+	ecran_effacer(&jeu->ecran); // la question reste à l'écran sinon
+}
+
+/**
+* @brief joue une suite de coups d'un bloc, sans affichage : caractères d'un
+* fichier .dep (h b g d, en majuscules aussi) et u pour annuler. Les coups
+* sont gardés dans l'historique et le journal comme des touches ; les autres
+* caractères sont ignorés. La suite s'arrête au premier coup impossible ou
+* dès que la partie est gagnée, et l'image n'est refaite qu'une fois à la
+* fin par jouer.
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @param coups type : tableau, entrée, caractères de la suite
+* @param nb type : entier, entrée, nombre de caractères
+* @param bilan type : structure, sortie, caractères appliqués, coups,
+	poussées, annulations et indice du coup impossible (-1 si aucun)
+* @return résultat : nombre de caractères appliqués
+*/
+
+int jouer_coups(t_partie *jeu, const char coups[], int nb, t_bilan *bilan){
+	const char pas[4] = {DEP_HAUT, DEP_BAS, DEP_GAUCHE, DEP_DROITE};
+	const char touches[4] = {HAUT, BAS, GAUCHE, DROITE};
+	const int dlig[4] = {-1, 1, 0, 0};
+	const int dcol[4] = {0, 0, -1, 1};
+	uint64_t debut = cpt_maintenant();
+	int avant; // coups joués avant le caractère
+	int d;
+	int i;
+	char c;
+
+	trans_bilan_init(bilan);
+	for (i = 0; i < nb && !gagner(jeu); i++) {
+		c = tolower(coups[i]);
+		if (c == RETOUR) {
+			if (!annuler_coup(jeu)) {
+				bilan->illegal = i;
+				break;
+			}
+			bilan->nbAnnulations++;
+			continue;
 		}
-		else {
-			jeu->plateau[ancienx][ancieny] = CASE;
+		for (d = 0; d < 4 && pas[d] != c; d++);
+		if (d == 4) {
+			continue; // ni un pas ni un retour
+		}
+		avant = jeu->nbDep;
+		conditions_dep(jeu, jeu->posx + dlig[d], jeu->posy + dcol[d], touches[d]);
+		if (jeu->nbDep == avant) {
+			bilan->illegal = i;
+			break;
 		}
-		//déplacement de la caisse
-		deplacer_caisse(jeu, ancienx, ancieny, casx, casy);
+		bilan->nbCoups++;
+		bilan->nbPoussees += isupper(hist_lire(&jeu->historiqueDep, jeu->nbDep - 1)) != 0;
 	}
+	cpt_ajouter(CPT_GAGNER, i < nb ? i + 1 : i); // un test par tour, comptés d'un bloc
+	cpt_duree(CPT_GAGNER, cpt_maintenant() - debut); // la boucle entière, tests compris
+	bilan->nbLus = i;
+	return i;
 }
 
 /**
-* @brief cette procédure contient les touches et conditions pour jouer.
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param historiqueDep type : tableau, entrée/sortie, importe le 
-	tableau des déplacements
-* @param posx type : entier, entrée/sortie, position verticale du joueur
-* @param posy type : entier, entrée/sortie, position horizontale du joueur
-* @param nbDep type : entier, entrée/sortie, nombre de déplacements
-* @param echelle type : entier, entrée, taille du tableau
-* @param fichier type : chaine, entrée, fichier de sauvegarde
-* @return résultat : permet de jouer au jeu
+* @brief demande une suite de coups au clavier, puis la joue d'un bloc
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @return résultat : suite jouée, bilan dans jeu->bilan
 */
 
-void jouer(t_partie *jeu, char fichier[]){
+void saisir_coups(t_partie *jeu){
+	char coups[TAILLE_COUPS];
 
-	char touche; // touche de déplacement
-	char last; // caractère des déplacements du joueur
-	int depx = jeu->posx;  // case de déplacement du joueur
-	int depy = jeu->posy;
+	clavier_normal(); // saisie lue ligne par ligne, avec écho
+	printf("Coups à jouer (h b g d, u pour annuler) : ");
+	if (fgets(coups, TAILLE_COUPS, stdin) != NULL) {
+		jouer_coups(jeu, coups, strlen(coups), &jeu->bilan);
+		jeu->suite = true;
+		if (strchr(coups, '\n') == NULL) {
+			while (getchar() != '\n' && !feof(stdin)); // reste de la ligne
+		}
+	}
+	clavier_brut();
+	ecran_effacer(&jeu->ecran); // la question reste à l'écran sinon
+}
 
-	// définition de la valeur de touche
-	touche = '\0';
-	// lecture de la touche appuyée et déplacement du joueur
-	if (kbhit()) {
-		touche = getchar();
-		switch (touche) {
-			case HAUT:
-				depx--; // déplacement joueur haut
-				break;
-			case BAS:
-				depx++; // déplacement joueur bas
-				break;
-			case GAUCHE:
-				depy--; // déplacement joueur gauche
-				break;
-			case DROITE:
-				depy++; // déplacement joueur droite
-				break;
-			case RETOUR:
-				if (jeu->nbDep > 0) {
-					last = jeu->historiqueDep[jeu->nbDep]; // stocke le caractère de la case
-					annuler_deplacer(jeu, last); 
-					jeu->historiqueDep[jeu->nbDep] = ' '; // effacement du caractère 
-					jeu->nbDep--; // décrementation du nombre de déplacement
-				}
-				break;
-			case ZOOMER:
-				if (jeu->echelle < MAXECH) {
-					jeu->echelle++;
-				}
-				break;
-			case DEZOOMER:
-				if (jeu->echelle > MINECH) {
-					jeu->echelle--;
+/**
+* @brief cherche le plus court chemin du joueur vers une case sans pousser de
+* caisse, par un parcours en largeur arrêté dès que la case est atteinte
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @param lig type : entier, entrée, ligne de la case
+* @param col type : entier, entrée, colonne de la case
+* @return résultat : nombre de pas, rangés de la fin vers le début dans
+	jeu->file (0 : haut, 1 : bas, 2 : gauche, 3 : droite) ; -1 sans chemin
+*/
+
+int chercher_chemin(t_partie *jeu, int lig, int col){
+	const int dlig[4] = {-1, 1, 0, 0};
+	const int dcol[4] = {0, 0, -1, 1};
+	int depart = jeu->posx * jeu->largeur + jeu->posy;
+	int arrivee = lig * jeu->largeur + col;
+	int debut = 0;
+	int fin = 0;
+	int nb = 0;
+	int c;
+	int l; // case voisine
+	int k;
+	char car;
+
+	if (!dans_plateau(jeu, lig, col) ||
+		(arrivee != depart && jeu->plateau[lig][col] != CASE && jeu->plateau[lig][col] != CIBLE)) {
+		return -1;
+	}
+	for (int i = 0; i < jeu->hauteur * jeu->largeur; i++) {
+		jeu->venu[i] = -1;
+	}
+	jeu->venu[depart] = 4;
+	jeu->file[fin++] = depart;
+	while (debut < fin && jeu->venu[arrivee] < 0) {
+		c = jeu->file[debut++];
+		for (int d = 0; d < 4; d++) {
+			l = c / jeu->largeur + dlig[d];
+			k = c % jeu->largeur + dcol[d];
+			if (dans_plateau(jeu, l, k) && jeu->venu[l * jeu->largeur + k] < 0) {
+				car = jeu->plateau[l][k];
+				if (car == CASE || car == CIBLE) {
+					jeu->venu[l * jeu->largeur + k] = d;
+					jeu->file[fin++] = l * jeu->largeur + k;
 				}
-				break;
-			case QUITTER:
-				abandonner_partie(jeu, fichier);
-				break;
-			case RECOMMENCER:
-				recommencer_partie(jeu, fichier);
-				break;
-			default:
-				break;
-		}
-		// si les touches sont celles de déplacements on utilise les conditions
-		if (touche == HAUT || touche == BAS || touche == DROITE || touche == GAUCHE) {
-		// si la case de destination n'est pas un mur
-			conditions_dep(jeu, depx, depy, touche);
+			}
 		}
-		
-		system("clear");
-		afficher_entete(jeu, fichier);
-		afficher_plateau(jeu);
 	}
+	if (jeu->venu[arrivee] < 0) {
+		return -1;
+	}
+	// la file n'est plus utile : elle reçoit les pas, de l'arrivée au départ
+	for (c = arrivee; c != depart; c -= dlig[jeu->venu[c]] * jeu->largeur + dcol[jeu->venu[c]]) {
+		jeu->file[nb++] = jeu->venu[c];
+	}
+	return nb;
 }
 
+/**
+* @brief amène le joueur sur une case par le plus court chemin : tous les pas
+* sont joués d'un coup, gardés dans l'historique et le journal comme des
+* touches, et l'image n'est refaite qu'une fois à la fin par jouer
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @param lig type : entier, entrée, ligne de la case
+* @param col type : entier, entrée, colonne de la case
+* @return résultat : nombre de pas joués, -1 si la case est inaccessible
+*/
+
+int aller_vers(t_partie *jeu, int lig, int col){
+	const char touches[4] = {HAUT, BAS, GAUCHE, DROITE};
+	const int dlig[4] = {-1, 1, 0, 0};
+	const int dcol[4] = {0, 0, -1, 1};
+	int nb = chercher_chemin(jeu, lig, col);
+	int d;
+
+	jeu->inaccessible = nb < 0;
+	for (int i = nb - 1; i >= 0; i--) {
+		d = jeu->file[i];
+		conditions_dep(jeu, jeu->posx + dlig[d], jeu->posy + dcol[d], touches[d]);
+	}
+	return nb;
+}
 
 /**
-* @brief vérifie si il n'y a plus de caisses à déplacer sur les cibles
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
+* @brief vérifie si il n'y a plus de caisses à déplacer sur les cibles. Le
+* nombre de caisses restantes est tenu à jour à chaque déplacement.
+* @param jeu type : structure, entrée, partie en cours
 * @return résultat : retourne le statut de la partie (fini/non fini)
 */
 
 bool gagner (t_partie *jeu) {
-	bool win = false; // statut de la partie
-	int nbCaisses = 0;
-	// compte le nombre de caisses restantes
-	for (int lig=0; lig < MAXLIG; lig++) {
-		for (int col=0; col < MAXLIG; col++) {
-			if (jeu->plateau[lig][col] == CAISSE) {
-				nbCaisses++;
-			}
-		}
-	}
-	if (nbCaisses == 0) {
-		win = true; // toutes les caisses sont sur les cibles
+	return jeu->nbCaisses == 0; // toutes les caisses sont sur les cibles
+}
+
+/**
+* @brief affiche la durée entre l'arrivée d'une touche et l'envoi de l'image
+* @param jeu type : structure, entrée, partie en cours
+* @return résultat : moyenne et maximum en microsecondes
+*/
+
+void afficher_latence(t_partie *jeu){
+	if (jeu->nbImages > 0) {
+		printf("Latence touche -> image : %.1f us en moyenne, %.1f us au plus (%d images)\n",
+			jeu->latence / jeu->nbImages, jeu->latenceMax, jeu->nbImages);
 	}
-	return win;
-}
\ No newline at end of file
+}
+
+/**
+* @brief donne l'heure courante d'une horloge monotone
+* @return résultat : temps en microsecondes
+*/
+
+double temps_us(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
@@ -0,0 +1,259 @@
+/**
+* @file journal.h
+* @brief Journal des coups pour annuler et refaire en temps constant
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Chaque coup joué garde les cases qu'il a changées (au plus trois : le
+* joueur, la case où il arrive et celle où arrive la caisse) avec leur
+* caractère avant et après le coup, la case du joueur et le nombre de caisses
+* hors cible. Annuler réécrit les caractères d'avant, refaire ceux d'après :
+* aucun déplacement n'est recalculé et aucun plateau n'est copié.
+*
+* Les coups annulés restent dans le journal tant qu'aucun nouveau coup n'est
+* joué : c'est la pile des coups à refaire. Un coup qui ne change rien (bloqué
+* par un mur) n'est pas gardé, une annulation revient donc toujours sur le
+* dernier coup qui a réellement eu lieu. Le coup en cours est noté à part et
+* n'est recopié dans le journal qu'une fois joué : un coup bloqué ne touche
+* ni les coups à annuler ni ceux à refaire.
+*
+* Utilisation : jour_ouvrir avant le coup, jour_noter pour chaque case qu'il
+* peut changer, jour_fermer une fois le coup joué.
+*/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define JOURNAL_CASES 3 // cases changées au plus par un coup
+
+//Définition des changements d'un coup
+typedef struct{
+	int lig[JOURNAL_CASES]; // lignes des cases notées
+	int col[JOURNAL_CASES]; // colonnes des cases notées
+	char avant[JOURNAL_CASES]; // caractères avant le coup
+	char apres[JOURNAL_CASES]; // caractères après le coup
+	int nb; // nombre de cases notées
+	int posx; // joueur avant le coup
+	int posy;
+	int posxApres; // joueur après le coup
+	int posyApres;
+	int caissesAvant; // caisses hors cible avant le coup
+	int caissesApres; // caisses hors cible après le coup
+	char coup; // caractère du coup (g/d/h/b ou G/D/H/B)
+} t_delta;
+
+//Définition du journal : coups joués puis coups annulés à refaire
+typedef struct{
+	t_delta *deltas; // coups, du premier au dernier
+	t_delta ouvert; // coup en cours, entre jour_ouvrir et jour_fermer
+	int courant; // nombre de coups en place (les suivants sont à refaire)
+	int nb; // nombre de coups gardés
+	int capacite; // taille allouée du tableau
+} t_journal;
+
+/**
+* @brief initialise un journal vide, sans allocation
+* @param j type : structure, sortie, journal
+* @return résultat : journal vide
+*/
+
+static inline void jour_init(t_journal *j){
+	j->deltas = NULL;
+	j->courant = 0;
+	j->nb = 0;
+	j->capacite = 0;
+}
+
+/**
+* @brief libère la mémoire du journal
+* @param j type : structure, entrée/sortie, journal
+* @return résultat : journal vide
+*/
+
+static inline void jour_liberer(t_journal *j){
+	free(j->deltas);
+	jour_init(j);
+}
+
+/**
+* @brief vide le journal en gardant sa mémoire (nouvelle partie, saut dans
+* un rejeu)
+* @param j type : structure, entrée/sortie, journal
+* @return résultat : journal vide
+*/
+
+static inline void jour_vider(t_journal *j){
+	j->courant = 0;
+	j->nb = 0;
+}
+
+/**
+* @brief remplace le journal par des coups en place, sans coup à refaire
+* (reprise d'un rejeu à un point de reprise)
+* @param j type : structure, entrée/sortie, journal
+* @param deltas type : tableau, entrée, coups du plus ancien au dernier
+* @param nb type : entier, entrée, nombre de coups
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool jour_charger(t_journal *j, const t_delta *deltas, int nb){
+	t_delta *agrandi;
+	int capacite = j->capacite;
+
+	if (nb > capacite) {
+		while (capacite < nb) {
+			capacite = (capacite == 0) ? 64 : 2 * capacite;
+		}
+		agrandi = realloc(j->deltas, capacite * sizeof(t_delta));
+		if (agrandi == NULL) {
+			return false;
+		}
+		j->deltas = agrandi;
+		j->capacite = capacite;
+	}
+	for (int i = 0; i < nb; i++) {
+		j->deltas[i] = deltas[i];
+	}
+	j->courant = nb;
+	j->nb = nb;
+	return true;
+}
+
+/**
+* @brief commence le coup suivant : la case du joueur et les caisses hors
+* cible sont gardées, les cases sont notées ensuite avec jour_noter
+* @param j type : structure, entrée/sortie, journal
+* @param posx type : entier, entrée, ligne du joueur avant le coup
+* @param posy type : entier, entrée, colonne du joueur avant le coup
+* @param nbCaisses type : entier, entrée, caisses hors cible avant le coup
+* @return résultat : le coup à remplir, NULL si la mémoire manque
+*/
+
+static inline t_delta *jour_ouvrir(t_journal *j, int posx, int posy, int nbCaisses){
+	t_delta *deltas;
+	t_delta *d;
+	int capacite;
+
+	if (j->courant == j->capacite) {
+		capacite = (j->capacite == 0) ? 64 : 2 * j->capacite;
+		deltas = realloc(j->deltas, capacite * sizeof(t_delta));
+		if (deltas == NULL) {
+			return NULL;
+		}
+		j->deltas = deltas;
+		j->capacite = capacite;
+	}
+	// la place est prise d'avance : jour_fermer ne peut plus échouer
+	d = &j->ouvert;
+	d->nb = 0;
+	d->posx = posx;
+	d->posy = posy;
+	d->caissesAvant = nbCaisses;
+	return d;
+}
+
+/**
+* @brief note le caractère d'une case que le coup peut changer
+* @param d type : structure, entrée/sortie, coup ouvert par jour_ouvrir
+* @param plateau type : tableau, entrée, plateau avant le coup
+* @param lig type : entier, entrée, ligne de la case
+* @param col type : entier, entrée, colonne de la case
+* @return résultat : case notée (au plus JOURNAL_CASES)
+*/
+
+static inline void jour_noter(t_delta *d, char **plateau, int lig, int col){
+	if (d->nb < JOURNAL_CASES) {
+		d->lig[d->nb] = lig;
+		d->col[d->nb] = col;
+		d->avant[d->nb++] = plateau[lig][col];
+	}
+}
+
+/**
+* @brief termine le coup ouvert : les caractères d'après sont relus. Un coup
+* qui n'a pas bougé le joueur est oublié et les coups à refaire restent ;
+* sinon il est recopié comme dernier coup et les coups à refaire sont perdus.
+* @param j type : structure, entrée/sortie, journal
+* @param plateau type : tableau, entrée, plateau après le coup
+* @param posx type : entier, entrée, ligne du joueur après le coup
+* @param posy type : entier, entrée, colonne du joueur après le coup
+* @param nbCaisses type : entier, entrée, caisses hors cible après le coup
+* @param coup type : caractère, entrée, caractère du coup joué
+* @return résultat : vrai si le coup est gardé
+*/
+
+static inline bool jour_fermer(t_journal *j, char **plateau, int posx, int posy, int nbCaisses, char coup){
+	t_delta *d = &j->ouvert;
+
+	if (posx == d->posx && posy == d->posy) {
+		return false;
+	}
+	for (int i = 0; i < d->nb; i++) {
+		d->apres[i] = plateau[d->lig[i]][d->col[i]];
+	}
+	d->posxApres = posx;
+	d->posyApres = posy;
+	d->caissesApres = nbCaisses;
+	d->coup = coup;
+	j->deltas[j->courant] = *d;
+	j->nb = ++j->courant;
+	return true;
+}
+
+/**
+* @brief annule le dernier coup en place
+* @param j type : structure, entrée/sortie, journal
+* @param plateau type : tableau, entrée/sortie, plateau
+* @param posx type : entier, sortie, ligne du joueur
+* @param posy type : entier, sortie, colonne du joueur
+* @param nbCaisses type : entier, sortie, caisses hors cible
+* @return résultat : caractère du coup annulé, '\0' s'il n'y a rien à annuler
+*/
+
+static inline char jour_annuler(t_journal *j, char **plateau, int *posx, int *posy, int *nbCaisses){
+	t_delta *d;
+
+	if (j->courant == 0) {
+		return '\0';
+	}
+	d = &j->deltas[--j->courant];
+	for (int i = d->nb - 1; i >= 0; i--) {
+		plateau[d->lig[i]][d->col[i]] = d->avant[i];
+	}
+	*posx = d->posx;
+	*posy = d->posy;
+	*nbCaisses = d->caissesAvant;
+	return d->coup;
+}
+
+/**
+* @brief refait le dernier coup annulé
+* @param j type : structure, entrée/sortie, journal
+* @param plateau type : tableau, entrée/sortie, plateau
+* @param posx type : entier, sortie, ligne du joueur
+* @param posy type : entier, sortie, colonne du joueur
+* @param nbCaisses type : entier, sortie, caisses hors cible
+* @return résultat : caractère du coup refait, '\0' s'il n'y a rien à refaire
+*/
+
+static inline char jour_refaire(t_journal *j, char **plateau, int *posx, int *posy, int *nbCaisses){
+	t_delta *d;
+
+	if (j->courant == j->nb) {
+		return '\0';
+	}
+	d = &j->deltas[j->courant++];
+	for (int i = 0; i < d->nb; i++) {
+		plateau[d->lig[i]][d->col[i]] = d->apres[i];
+	}
+	*posx = d->posxApres;
+	*posy = d->posyApres;
+	*nbCaisses = d->caissesApres;
+	return d->coup;
+}
+
+#endif
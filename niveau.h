@@ -0,0 +1,308 @@
+/**
+* @file niveau.h
+* @brief Chargement des niveaux de sokoban de taille quelconque
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Lit un niveau au format XSB (lignes de '#', '@', '+', '$', '*', '.', ' ')
+* de n'importe quelle taille jusqu'à NIVEAU_MAX x NIVEAU_MAX. Les lignes peuvent
+* être de longueurs différentes et finir par des espaces ou par "\r\n" : elles
+* sont complétées par des cases vides jusqu'à la largeur de la plus longue.
+*
+* Le plateau est un tableau de pointeurs de lignes dont toutes les cases se
+* suivent en mémoire, ce qui garde l'écriture plateau[lig][col]. Il est pris
+* dans une arène que l'appelant vide avant chaque chargement, ce qui réutilise
+* la même mémoire d'un niveau à l'autre.
+*/
+
+#ifndef NIVEAU_H
+#define NIVEAU_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define NIVEAU_MAX 1024 // nombre maximal de lignes et de colonnes
+#define ARENE_ALIGNEMENT 16
+#define ARENE_BLOC 65536 // taille minimale d'un bloc de l'arène
+
+//Définition d'un bloc de l'arène
+typedef struct t_bloc{
+	struct t_bloc *precedent; // bloc alloué avant celui-ci
+	size_t taille; // nombre d'octets utilisables du bloc
+	size_t utilise; // octets déjà distribués
+	size_t remplissage; // garde les données alignées sur 16 octets
+} t_bloc;
+
+//Définition d'une arène : allocation par avancement dans des blocs libérés
+//tous ensemble. Quand on la vide, les blocs sont fusionnés en un seul pour
+//que les chargements suivants ne fassent plus d'allocation.
+typedef struct{
+	t_bloc *courant; // dernier bloc alloué
+} t_arene;
+
+/**
+* @brief initialise une arène vide
+* @param a type : structure, sortie, arène
+* @return résultat : arène sans mémoire
+*/
+
+static inline void arene_init(t_arene *a){
+	a->courant = NULL;
+}
+
+/**
+* @brief libère tous les blocs de l'arène
+* @param a type : structure, entrée/sortie, arène
+* @return résultat : arène vide
+*/
+
+static inline void arene_liberer(t_arene *a){
+	t_bloc *bloc;
+
+	while (a->courant != NULL) {
+		bloc = a->courant;
+		a->courant = bloc->precedent;
+		free(bloc);
+	}
+}
+
+/**
+* @brief ajoute un bloc à l'arène
+* @param a type : structure, entrée/sortie, arène
+* @param taille type : entier, entrée, nombre d'octets utilisables
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool arene_ajouter_bloc(t_arene *a, size_t taille){
+	t_bloc *bloc = malloc(sizeof(t_bloc) + taille);
+
+	if (bloc == NULL) {
+		return false;
+	}
+	bloc->precedent = a->courant;
+	bloc->taille = taille;
+	bloc->utilise = 0;
+	a->courant = bloc;
+	return true;
+}
+
+/**
+* @brief vide l'arène : tout ce qui avait été pris devient invalide. Si elle
+* avait plusieurs blocs, ils sont remplacés par un seul bloc de la même taille.
+* @param a type : structure, entrée/sortie, arène
+* @return résultat : arène vide, mémoire conservée
+*/
+
+static inline void arene_vider(t_arene *a){
+	size_t total = 0;
+
+	if (a->courant != NULL && a->courant->precedent != NULL) {
+		for (t_bloc *bloc = a->courant; bloc != NULL; bloc = bloc->precedent) {
+			total += bloc->taille;
+		}
+		arene_liberer(a);
+		arene_ajouter_bloc(a, total);
+	}
+	if (a->courant != NULL) {
+		a->courant->utilise = 0;
+	}
+}
+
+/**
+* @brief prend un morceau de l'arène, aligné sur 16 octets
+* @param a type : structure, entrée/sortie, arène
+* @param taille type : entier, entrée, nombre d'octets
+* @return résultat : adresse du morceau, NULL si la mémoire manque
+*/
+
+static inline void *arene_allouer(t_arene *a, size_t taille){
+	size_t debut;
+
+	taille = (taille + ARENE_ALIGNEMENT - 1) & ~(size_t)(ARENE_ALIGNEMENT - 1);
+	if (a->courant == NULL || a->courant->utilise + taille > a->courant->taille) {
+		if (!arene_ajouter_bloc(a, taille > ARENE_BLOC ? taille : ARENE_BLOC)) {
+			return NULL;
+		}
+	}
+	debut = a->courant->utilise;
+	a->courant->utilise += taille;
+	return (char *)(a->courant + 1) + debut;
+}
+
+/**
+* @brief prend un plateau dans l'arène, cases contiguës et remplies de vide
+* @param a type : structure, entrée/sortie, arène
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @return résultat : tableau des lignes, NULL si l'arène est pleine
+*/
+
+static inline char **niveau_allouer(t_arene *a, int hauteur, int largeur){
+	char **plateau = arene_allouer(a, hauteur * sizeof(char *));
+	char *cases = arene_allouer(a, (size_t)hauteur * largeur);
+
+	if (plateau == NULL || cases == NULL) {
+		return NULL;
+	}
+	memset(cases, ' ', (size_t)hauteur * largeur);
+	for (int lig = 0; lig < hauteur; lig++) {
+		plateau[lig] = cases + (size_t)lig * largeur;
+	}
+	return plateau;
+}
+
+/**
+* @brief copie les cases d'un plateau dans un autre de même taille
+* @param dest type : tableau, sortie, plateau destination
+* @param source type : tableau, entrée, plateau source
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @return résultat : plateau copié
+*/
+
+static inline void niveau_copier(char **dest, char **source, int hauteur, int largeur){
+	memcpy(dest[0], source[0], (size_t)hauteur * largeur);
+}
+
+/**
+* @brief vérifie qu'un caractère peut faire partie d'un plateau
+* @param c type : caractère, entrée, caractère lu
+* @return résultat : vrai pour '#', '@', '+', '$', '*', '.', ' ', '-' et '_'
+*/
+
+static inline bool niveau_caractere(char c){
+	return c == '#' || c == '@' || c == '+' || c == '$' || c == '*' ||
+		c == '.' || c == ' ' || c == '-' || c == '_' || c == '\t';
+}
+
+/**
+* @brief mesure une ligne de texte : longueur sans "\r\n" ni espaces de fin
+* @param ligne type : chaine, entrée, début de la ligne
+* @param fin type : chaine, entrée, fin du texte
+* @param suivante type : chaine, sortie, début de la ligne suivante
+* @param plateau type : booléen, sortie, la ligne n'a que des cases de plateau
+* @return résultat : longueur utile de la ligne
+*/
+
+static inline int niveau_ligne(const char *ligne, const char *fin,
+	const char **suivante, bool *plateau){
+	const char *c = ligne;
+	int longueur = 0;
+
+	*plateau = true;
+	while (c < fin && *c != '\n') {
+		if (*c != ' ' && *c != '\t' && *c != '\r') {
+			longueur = c - ligne + 1;
+		}
+		if (*c != '\r' && !niveau_caractere(*c)) {
+			*plateau = false;
+		}
+		c++;
+	}
+	*suivante = (c < fin) ? c + 1 : fin;
+	return longueur;
+}
+
+/**
+* @brief analyse un plateau dans un texte : le premier bloc de lignes non
+* vides qui ne contiennent que des cases. Les '-' et '_' sont des cases vides.
+* @param texte type : chaine, entrée, contenu du fichier
+* @param taille type : entier, entrée, nombre de caractères du texte
+* @param a type : structure, entrée/sortie, arène qui recevra le plateau
+* @param plateau type : tableau, sortie, plateau lu
+* @param hauteur type : entier, sortie, nombre de lignes
+* @param largeur type : entier, sortie, nombre de colonnes
+* @return résultat : faux si aucun plateau ou plateau trop grand
+*/
+
+static inline bool niveau_analyser(const char *texte, size_t taille, t_arene *a,
+	char ***plateau, int *hauteur, int *largeur){
+	const char *fin = texte + taille;
+	const char *ligne = texte;
+	const char *suivante;
+	const char *debut = NULL; // première ligne du plateau
+	bool cases; // la ligne n'a que des cases de plateau
+	int longueur;
+	int lig;
+
+	*hauteur = 0;
+	*largeur = 0;
+	// recherche du bloc et de ses dimensions
+	while (ligne < fin) {
+		longueur = niveau_ligne(ligne, fin, &suivante, &cases);
+		if (longueur > 0 && cases) {
+			if (debut == NULL) {
+				debut = ligne;
+			}
+			(*hauteur)++;
+			if (longueur > *largeur) {
+				*largeur = longueur;
+			}
+		}
+		else if (debut != NULL) {
+			break;
+		}
+		ligne = suivante;
+	}
+	if (debut == NULL || *hauteur > NIVEAU_MAX || *largeur > NIVEAU_MAX) {
+		return false;
+	}
+
+	// copie des lignes, complétées par des cases vides
+	*plateau = niveau_allouer(a, *hauteur, *largeur);
+	if (*plateau == NULL) {
+		return false;
+	}
+	ligne = debut;
+	for (lig = 0; lig < *hauteur; lig++) {
+		longueur = niveau_ligne(ligne, fin, &suivante, &cases);
+		for (int col = 0; col < longueur; col++) {
+			if (ligne[col] == '-' || ligne[col] == '_' || ligne[col] == '\t') {
+				(*plateau)[lig][col] = ' ';
+			}
+			else {
+				(*plateau)[lig][col] = ligne[col];
+			}
+		}
+		ligne = suivante;
+	}
+	return true;
+}
+
+/**
+* @brief lit un fichier de niveau en une seule lecture puis l'analyse
+* @param fichier type : chaine, entrée, nom du fichier
+* @param a type : structure, entrée/sortie, arène qui recevra le plateau
+* @param plateau type : tableau, sortie, plateau lu
+* @param hauteur type : entier, sortie, nombre de lignes
+* @param largeur type : entier, sortie, nombre de colonnes
+* @return résultat : faux si le fichier est absent ou ne contient pas de plateau
+*/
+
+static inline bool niveau_lire(const char fichier[], t_arene *a,
+	char ***plateau, int *hauteur, int *largeur){
+	FILE * f;
+	char *texte;
+	long taille;
+	bool lu = false;
+
+	f = fopen(fichier, "rb");
+	if (f == NULL) {
+		return false;
+	}
+	fseek(f, 0, SEEK_END);
+	taille = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	texte = malloc(taille > 0 ? taille : 1);
+	if (texte != NULL && fread(texte, 1, taille, f) == (size_t)taille) {
+		lu = niveau_analyser(texte, taille, a, plateau, hauteur, largeur);
+	}
+	free(texte);
+	fclose(f);
+	return lu;
+}
+
+#endif
@@ -0,0 +1,404 @@
+/**
+* @file optimiseur.h
+* @brief Raccourcissement d'une solution de sokoban déjà valide
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Deux outils, utilisés par "sokoban -optimiser" :
+* - opt_marcher remplace la marche du joueur entre deux poussées par un plus
+*   court chemin (parcours en largeur, les caisses sont des obstacles) ;
+* - opt_fenetre cherche, entre deux états d'une solution séparés par
+*   quelques poussées, la suite de coups la plus courte qui va exactement de
+*   l'un à l'autre (mêmes caisses, même case du joueur). Les poussées
+*   peuvent changer d'ordre ou de nombre. La recherche est un parcours en
+*   largeur sur les états codés par etat.h, limité à OPT_NOEUDS états : si
+*   elle s'arrête avant, le morceau d'origine est gardé.
+* Comme chaque morceau relie les mêmes états, la solution reste valide.
+*
+* Les cases sont numérotées lig * pas + col avec pas = largeur + 1, comme le
+* plateau de bits : la colonne en plus est un mur, ce qui évite de tester les
+* bords gauche et droit. Les cases mortes de impasses.h ont la même
+* numérotation.
+*/
+
+#ifndef OPTIMISEUR_H
+#define OPTIMISEUR_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "etat.h"
+#include "historique.h"
+
+#define OPT_NOEUDS 200000 // états au plus par fenêtre
+
+static const char opt_marches[] = "hbgd"; // coup de chaque direction
+static const char opt_poussees[] = "HBGD"; // poussée de chaque direction
+
+//Définition de l'optimiseur d'un niveau
+typedef struct{
+	int pas; // décalage d'une ligne à la suivante (largeur + 1)
+	int largeur; // nombre de colonnes du plateau
+	int nbCases; // hauteur * pas
+	int decalage[4]; // haut, bas, gauche, droite
+	bool *mur; // mur ou colonne ajoutée
+	const bool *mortes; // cases mortes (impasses.h), fournies par l'appelant
+	bool *caisse; // caisses de l'état courant
+	int *file; // parcours en largeur des marches
+	int *venu; // direction d'arrivée sur chaque case (-1 : pas atteinte)
+	t_codage codage; // codage des états (cases numérotées lig * largeur + col)
+	int maxNoeuds; // états au plus par fenêtre
+	unsigned char *etats; // états atteints par la fenêtre, codage.octets chacun
+	int *parents; // état d'où vient chaque état
+	char *coups; // coup qui mène à chaque état
+	int *table; // table de hachage : indice de l'état + 1 (0 : vide)
+	int masque; // taille de la table - 1
+	int *caisses; // caisses d'un état décodé
+	int *fils; // caisses d'un état voisin
+	int noeuds; // états parcourus par la dernière fenêtre
+} t_optimiseur;
+
+/**
+* @brief prépare l'optimiseur d'un niveau
+* @param o type : structure, sortie, optimiseur
+* @param plateau type : tableau, entrée, plateau de caractères tel que chargé
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @param mortes type : tableau, entrée, cases mortes numérotées avec pas = largeur + 1
+* @param maxNoeuds type : entier, entrée, états au plus par fenêtre
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool opt_init(t_optimiseur *o, char **plateau, int hauteur, int largeur,
+	const bool *mortes, int maxNoeuds){
+	int taille = 1;
+
+	memset(o, 0, sizeof(t_optimiseur));
+	o->pas = largeur + 1;
+	o->largeur = largeur;
+	o->nbCases = hauteur * o->pas;
+	o->decalage[0] = -o->pas;
+	o->decalage[1] = o->pas;
+	o->decalage[2] = -1;
+	o->decalage[3] = 1;
+	o->mortes = mortes;
+	o->maxNoeuds = maxNoeuds;
+	while (taille < 2 * maxNoeuds) {
+		taille *= 2;
+	}
+	o->masque = taille - 1;
+	o->mur = malloc(o->nbCases * sizeof(bool));
+	o->caisse = calloc(o->nbCases, sizeof(bool));
+	o->file = malloc(o->nbCases * sizeof(int));
+	o->venu = malloc(o->nbCases * sizeof(int));
+	if (!etat_init(&o->codage, plateau, hauteur, largeur) || o->mur == NULL ||
+		o->caisse == NULL || o->file == NULL || o->venu == NULL) {
+		return false;
+	}
+	o->etats = malloc((size_t)maxNoeuds * o->codage.octets);
+	o->parents = malloc(maxNoeuds * sizeof(int));
+	o->coups = malloc(maxNoeuds);
+	o->table = malloc(taille * sizeof(int));
+	o->caisses = malloc((o->codage.nbCaisses + 1) * sizeof(int));
+	o->fils = malloc((o->codage.nbCaisses + 1) * sizeof(int));
+	if (o->etats == NULL || o->parents == NULL || o->coups == NULL || o->table == NULL ||
+		o->caisses == NULL || o->fils == NULL) {
+		return false;
+	}
+	for (int q = 0; q < o->nbCases; q++) {
+		o->mur[q] = q % o->pas == largeur || plateau[q / o->pas][q % o->pas] == '#';
+		o->caisse[q] = !o->mur[q] && (plateau[q / o->pas][q % o->pas] == '$' ||
+			plateau[q / o->pas][q % o->pas] == '*');
+	}
+	return true;
+}
+
+/**
+* @brief libère l'optimiseur
+* @param o type : structure, entrée/sortie, optimiseur
+* @return résultat : mémoire libérée
+*/
+
+static inline void opt_liberer(t_optimiseur *o){
+	etat_liberer(&o->codage);
+	free(o->mur);
+	free(o->caisse);
+	free(o->file);
+	free(o->venu);
+	free(o->etats);
+	free(o->parents);
+	free(o->coups);
+	free(o->table);
+	free(o->caisses);
+	free(o->fils);
+}
+
+/**
+* @brief dit si le joueur ou une caisse peut entrer sur une case
+* @param o type : structure, entrée, optimiseur
+* @param q type : entier, entrée, case (éventuellement hors du plateau)
+* @return résultat : vrai si la case existe, n'est pas un mur ni une caisse
+*/
+
+static inline bool opt_libre(const t_optimiseur *o, int q){
+	return q >= 0 && q < o->nbCases && !o->mur[q] && !o->caisse[q];
+}
+
+/**
+* @brief ajoute à une solution le plus court chemin du joueur entre deux cases
+* sans pousser de caisse
+* @param o type : structure, entrée/sortie, optimiseur (caisses de l'état courant)
+* @param depart type : entier, entrée, case du joueur
+* @param arrivee type : entier, entrée, case à atteindre
+* @param sortie type : structure, entrée/sortie, coups ajoutés à la fin
+* @return résultat : faux si la case n'est pas atteignable ou si la mémoire manque
+*/
+
+static inline bool opt_marcher(t_optimiseur *o, int depart, int arrivee, t_historique *sortie){
+	int debut = 0;
+	int fin = 0;
+	int nb = 0;
+	int q;
+	int v;
+
+	for (q = 0; q < o->nbCases; q++) {
+		o->venu[q] = -1;
+	}
+	o->file[fin++] = depart;
+	o->venu[depart] = 4;
+	while (debut < fin && o->venu[arrivee] < 0) {
+		q = o->file[debut++];
+		for (int d = 0; d < 4; d++) {
+			v = q + o->decalage[d];
+			if (opt_libre(o, v) && o->venu[v] < 0) {
+				o->venu[v] = d;
+				o->file[fin++] = v;
+			}
+		}
+	}
+	if (o->venu[arrivee] < 0) {
+		return false;
+	}
+	// chemin relevé à l'envers dans la file, déjà parcourue
+	for (q = arrivee; q != depart; q -= o->decalage[o->venu[q]]) {
+		o->file[nb++] = o->venu[q];
+	}
+	while (nb > 0) {
+		if (!hist_ajouter(sortie, opt_marches[o->file[--nb]])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+* @brief pousse une caisse : le joueur avance d'une case et la caisse devant lui
+* @param o type : structure, entrée/sortie, optimiseur (caisses de l'état courant)
+* @param joueur type : entier, entrée/sortie, case du joueur
+* @param d type : entier, entrée, direction (0 haut, 1 bas, 2 gauche, 3 droite)
+* @param sortie type : structure, entrée/sortie, poussée ajoutée à la fin
+* @return résultat : faux s'il n'y a pas de caisse à pousser ou si elle est bloquée
+*/
+
+static inline bool opt_pousser(t_optimiseur *o, int *joueur, int d, t_historique *sortie){
+	int c = *joueur + o->decalage[d];
+
+	if (c < 0 || c >= o->nbCases || !o->caisse[c] || !opt_libre(o, c + o->decalage[d])) {
+		return false;
+	}
+	o->caisse[c] = false;
+	o->caisse[c + o->decalage[d]] = true;
+	*joueur = c;
+	return hist_ajouter(sortie, opt_poussees[d]);
+}
+
+/**
+* @brief passe d'une case numérotée avec pas à la numérotation de etat.h
+* @param o type : structure, entrée, optimiseur
+* @param q type : entier, entrée, case lig * pas + col
+* @return résultat : case lig * largeur + col
+*/
+
+static inline int opt_vers_etat(const t_optimiseur *o, int q){
+	return q / o->pas * o->largeur + q % o->pas;
+}
+
+/**
+* @brief passe d'une case de etat.h à la numérotation avec pas
+* @param o type : structure, entrée, optimiseur
+* @param q type : entier, entrée, case lig * largeur + col
+* @return résultat : case lig * pas + col
+*/
+
+static inline int opt_depuis_etat(const t_optimiseur *o, int q){
+	return q / o->largeur * o->pas + q % o->largeur;
+}
+
+/**
+* @brief code l'état courant : caisses de o->caisse et case exacte du joueur
+* @param o type : structure, entrée/sortie, optimiseur
+* @param joueur type : entier, entrée, case du joueur
+* @param etat type : tableau, sortie, o->codage.octets octets
+* @return résultat : état codé
+*/
+
+static inline void opt_coder(t_optimiseur *o, int joueur, unsigned char etat[]){
+	int nb = 0;
+
+	// les cases sont parcourues dans l'ordre : caisses déjà triées
+	for (int q = 0; q < o->nbCases && nb < o->codage.nbCaisses; q++) {
+		if (o->caisse[q]) {
+			o->caisses[nb++] = opt_vers_etat(o, q);
+		}
+	}
+	etat_coder(&o->codage, o->caisses, opt_vers_etat(o, joueur), etat);
+}
+
+/**
+* @brief cherche un état dans la table de la fenêtre et l'y ajoute s'il est nouveau
+* @param o type : structure, entrée/sortie, optimiseur
+* @param parent type : entier, entrée, état d'où vient le nouvel état
+* @param coup type : caractère, entrée, coup joué depuis le parent
+* @return résultat : indice de l'état ajouté, -1 s'il était connu, -2 si la
+	fenêtre est pleine. L'état est lu dans o->etats[o->noeuds].
+*/
+
+static inline int opt_ajouter(t_optimiseur *o, int parent, char coup){
+	const unsigned char *etat = &o->etats[(size_t)o->noeuds * o->codage.octets];
+	uint64_t h = 1469598103934665603ull;
+	int i;
+
+	for (int b = 0; b < o->codage.octets; b++) {
+		h = (h ^ etat[b]) * 1099511628211ull;
+	}
+	for (i = (int)(h & o->masque); o->table[i] != 0; i = (i + 1) & o->masque) {
+		if (memcmp(&o->etats[(size_t)(o->table[i] - 1) * o->codage.octets], etat, o->codage.octets) == 0) {
+			return -1;
+		}
+	}
+	if (o->noeuds + 1 >= o->maxNoeuds) {
+		return -2;
+	}
+	o->table[i] = o->noeuds + 1;
+	o->parents[o->noeuds] = parent;
+	o->coups[o->noeuds] = coup;
+	return o->noeuds++;
+}
+
+/**
+* @brief cherche la suite de coups la plus courte entre deux états codés
+* @param o type : structure, entrée/sortie, optimiseur
+* @param depart type : tableau, entrée, état de départ (joueur sur sa case exacte)
+* @param arrivee type : tableau, entrée, état à atteindre
+* @param maxCoups type : entier, entrée, coups au plus (le morceau d'origine)
+* @param sortie type : structure, entrée/sortie, coups ajoutés à la fin
+* @return résultat : nombre de coups ajoutés, -1 si aucune suite de moins de
+	maxCoups coups n'a été trouvée dans la limite d'états
+*/
+
+static inline int opt_fenetre(t_optimiseur *o, const unsigned char depart[], const unsigned char arrivee[],
+	int maxCoups, t_historique *sortie){
+	const int octets = o->codage.octets;
+	int profondeur = 0; // coups des états en cours de développement
+	int finEtage = 1; // premier état de l'étage suivant
+	char *chemin; // coups de la suite trouvée
+	int joueur = -1;
+	int trouve = -1;
+	int nb;
+	int v;
+	int w;
+	int i;
+
+	memset(o->table, 0, (o->masque + 1) * sizeof(int));
+	memset(o->caisse, 0, o->nbCases * sizeof(bool));
+	o->noeuds = 0;
+	memcpy(o->etats, depart, octets);
+	opt_ajouter(o, -1, '\0');
+	for (i = 0; i < o->noeuds && trouve < 0; i++) {
+		if (i == finEtage) {
+			profondeur++;
+			finEtage = o->noeuds;
+		}
+		if (profondeur + 1 >= maxCoups) {
+			break; // pas mieux que le morceau d'origine
+		}
+		etat_decoder(&o->codage, &o->etats[(size_t)i * octets], o->caisses, &joueur);
+		joueur = opt_depuis_etat(o, joueur);
+		for (int c = 0; c < o->codage.nbCaisses; c++) {
+			o->caisses[c] = opt_depuis_etat(o, o->caisses[c]);
+			o->caisse[o->caisses[c]] = true;
+		}
+		for (int d = 0; d < 4 && trouve < 0; d++) {
+			v = joueur + o->decalage[d];
+			if (v < 0 || v >= o->nbCases || o->mur[v]) {
+				continue;
+			}
+			// fils : caisses (numérotées comme etat.h) après le coup
+			for (int c = 0; c < o->codage.nbCaisses; c++) {
+				o->fils[c] = opt_vers_etat(o, o->caisses[c]);
+			}
+			if (o->caisse[v]) {
+				w = v + o->decalage[d];
+				if (!opt_libre(o, w) || o->mortes[w]) {
+					continue;
+				}
+				for (int c = 0; c < o->codage.nbCaisses; c++) {
+					if (o->caisses[c] == v) {
+						o->fils[c] = opt_vers_etat(o, w);
+					}
+				}
+				etat_trier(o->fils, o->codage.nbCaisses);
+			}
+			etat_coder(&o->codage, o->fils, opt_vers_etat(o, v), &o->etats[(size_t)o->noeuds * octets]);
+			nb = opt_ajouter(o, i, o->caisse[v] ? opt_poussees[d] : opt_marches[d]);
+			if (nb == -2) {
+				i = o->noeuds; // fenêtre pleine : abandon
+				break;
+			}
+			if (nb >= 0 && memcmp(&o->etats[(size_t)nb * octets], arrivee, octets) == 0) {
+				trouve = nb;
+			}
+		}
+		for (int c = 0; c < o->codage.nbCaisses; c++) {
+			o->caisse[o->caisses[c]] = false;
+		}
+	}
+	if (trouve < 0) {
+		return -1;
+	}
+	// coups relevés à l'envers puis ajoutés dans l'ordre
+	nb = profondeur + 1;
+	chemin = malloc(nb);
+	if (chemin == NULL) {
+		return -1;
+	}
+	for (i = trouve, v = nb; o->parents[i] >= 0; i = o->parents[i]) {
+		chemin[--v] = o->coups[i];
+	}
+	for (i = 0; i < nb && trouve >= 0; i++) {
+		trouve = hist_ajouter(sortie, chemin[i]) ? trouve : -1;
+	}
+	free(chemin);
+	return trouve < 0 ? -1 : nb;
+}
+
+/**
+* @brief remet les caisses de l'optimiseur dans un état codé
+* @param o type : structure, entrée/sortie, optimiseur
+* @param etat type : tableau, entrée, état codé par opt_coder
+* @param joueur type : entier, sortie, case du joueur
+* @return résultat : o->caisse reflète l'état
+*/
+
+static inline void opt_decoder(t_optimiseur *o, const unsigned char etat[], int *joueur){
+	memset(o->caisse, 0, o->nbCases * sizeof(bool));
+	etat_decoder(&o->codage, etat, o->caisses, joueur);
+	*joueur = opt_depuis_etat(o, *joueur);
+	for (int c = 0; c < o->codage.nbCaisses; c++) {
+		o->caisse[opt_depuis_etat(o, o->caisses[c])] = true;
+	}
+}
+
+#endif
@@ -0,0 +1,356 @@
+/**
+* @file paquet.h
+* @brief Chargement d'un niveau dans un recueil XSB de plusieurs niveaux
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Un recueil est un seul fichier texte qui contient des centaines ou des
+* milliers de niveaux, séparés par des lignes vides, des titres et des
+* commentaires (";"). Le fichier est projeté en mémoire (mmap) puis parcouru
+* une seule fois pour noter où commence chaque niveau et où est son titre :
+* aucun plateau n'est construit pendant ce parcours. Seul le niveau choisi
+* est ensuite analysé par niveau_analyser et copié dans l'arène.
+*
+* Un niveau d'un recueil est désigné par "recueil.xsb#N" (N à partir de 1).
+* Un nom sans "#N" est lu comme avant par niveau_lire.
+*
+* Titre d'un niveau : la valeur d'une ligne "Title:" du bloc de texte collé
+* sous le plateau ou placé avant lui, sinon la dernière ligne de texte qui
+* précède le plateau (sans ';' ni espaces de tête).
+*/
+
+#ifndef PAQUET_H
+#define PAQUET_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "niveau.h"
+
+#define PAQUET_NOM 256 // longueur maximale du nom du recueil
+#define PAQUET_SEPARATEUR '#' // entre le nom du recueil et le numéro du niveau
+
+//Définition de la position d'un niveau dans le texte du recueil
+typedef struct{
+	size_t debut; // premier octet du plateau
+	size_t taille; // octets du plateau, dernière ligne comprise
+	size_t titre; // premier octet du titre
+	int longueurTitre; // octets du titre (0 : pas de titre)
+} t_repere;
+
+//Définition d'un recueil ouvert
+typedef struct{
+	char nom[PAQUET_NOM]; // fichier projeté ("" : aucun)
+	const char *texte; // contenu du fichier, projeté en lecture seule
+	size_t taille; // octets du fichier
+	t_repere *niveaux; // un repère par niveau, dans l'ordre du fichier
+	int nb; // nombre de niveaux
+	int capacite; // taille allouée de niveaux
+} t_paquet;
+
+/**
+* @brief prépare un recueil fermé
+* @param p type : structure, sortie, recueil
+* @return résultat : recueil vide, rien n'est alloué
+*/
+
+static inline void paquet_init(t_paquet *p){
+	memset(p, 0, sizeof(t_paquet));
+}
+
+/**
+* @brief ferme le recueil : supprime la projection et l'index
+* @param p type : structure, entrée/sortie, recueil
+* @return résultat : recueil vide
+*/
+
+static inline void paquet_fermer(t_paquet *p){
+	if (p->texte != NULL) {
+		munmap((void *)p->texte, p->taille);
+	}
+	free(p->niveaux);
+	paquet_init(p);
+}
+
+/**
+* @brief reconnaît une ligne "Title:" (sans tenir compte des majuscules)
+* @param ligne type : chaine, entrée, début de la ligne
+* @param longueur type : entier, entrée, longueur utile de la ligne
+* @return résultat : nombre d'octets avant le titre, 0 si ce n'est pas un titre
+*/
+
+static inline int paquet_cle_titre(const char *ligne, int longueur){
+	const char cle[] = "title:";
+	int i;
+
+	for (i = 0; i < (int)sizeof(cle) - 1; i++) {
+		if (i >= longueur || tolower((unsigned char)ligne[i]) != cle[i]) {
+			return 0;
+		}
+	}
+	while (i < longueur && (ligne[i] == ' ' || ligne[i] == '\t')) {
+		i++;
+	}
+	return i;
+}
+
+/**
+* @brief note le titre d'un niveau : une ligne de texte sans "Title:", ';'
+* ni espaces de tête
+* @param p type : structure, entrée, recueil
+* @param r type : structure, sortie, repère du niveau
+* @param ligne type : chaine, entrée, début de la ligne
+* @param longueur type : entier, entrée, longueur utile de la ligne
+* @return résultat : titre noté dans le repère
+*/
+
+static inline void paquet_noter_titre(const t_paquet *p, t_repere *r, const char *ligne, int longueur){
+	int debut = paquet_cle_titre(ligne, longueur);
+
+	while (debut < longueur && (ligne[debut] == ';' || ligne[debut] == ' ' || ligne[debut] == '\t')) {
+		debut++;
+	}
+	r->titre = ligne + debut - p->texte;
+	r->longueurTitre = longueur - debut;
+}
+
+/**
+* @brief ajoute un niveau à l'index
+* @param p type : structure, entrée/sortie, recueil
+* @param debut type : entier, entrée, premier octet du plateau
+* @return résultat : repère du niveau, NULL si la mémoire manque
+*/
+
+static inline t_repere *paquet_ajouter(t_paquet *p, size_t debut){
+	t_repere *niveaux;
+
+	if (p->nb == p->capacite) {
+		p->capacite = p->capacite ? 2 * p->capacite : 256;
+		niveaux = realloc(p->niveaux, p->capacite * sizeof(t_repere));
+		if (niveaux == NULL) {
+			return NULL;
+		}
+		p->niveaux = niveaux;
+	}
+	p->niveaux[p->nb].debut = debut;
+	p->niveaux[p->nb].taille = 0;
+	p->niveaux[p->nb].longueurTitre = 0;
+	return &p->niveaux[p->nb++];
+}
+
+/**
+* @brief parcourt le texte une fois et note le début, la taille et le titre
+* de chaque niveau. Une ligne de plateau n'a que des cases et au moins un mur.
+* @param p type : structure, entrée/sortie, recueil projeté
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool paquet_indexer(t_paquet *p){
+	const char *fin = p->texte + p->taille;
+	const char *ligne = p->texte;
+	const char *suivante;
+	const char *avant = NULL; // titre trouvé avant le prochain plateau
+	int longueurAvant = 0;
+	t_repere *courant = NULL; // niveau dont on lit le plateau
+	t_repere *dernier = NULL; // niveau précédent, dont le texte suit le plateau
+	bool paragraphe = true; // la ligne commence un paragraphe de texte
+	bool explicite = false; // le titre noté dans avant vient d'une ligne "Title:"
+	bool cases;
+	int longueur;
+
+	while (ligne < fin) {
+		longueur = niveau_ligne(ligne, fin, &suivante, &cases);
+		if (longueur > 0 && cases && memchr(ligne, '#', longueur) != NULL) {
+			if (courant == NULL) {
+				courant = paquet_ajouter(p, ligne - p->texte);
+				if (courant == NULL) {
+					return false;
+				}
+				if (avant != NULL) {
+					paquet_noter_titre(p, courant, avant, longueurAvant);
+				}
+				avant = NULL;
+			}
+			courant->taille = suivante - p->texte - courant->debut;
+		}
+		else if (longueur == 0) {
+			// ligne vide : le texte qui suit ne décrit plus le niveau précédent
+			courant = NULL;
+			dernier = NULL;
+			paragraphe = true;
+		}
+		else {
+			if (courant != NULL) {
+				dernier = courant; // texte collé sous le plateau
+				courant = NULL;
+			}
+			if (dernier != NULL) {
+				if (paquet_cle_titre(ligne, longueur) > 0) {
+					paquet_noter_titre(p, dernier, ligne, longueur);
+				}
+			}
+			else if (paragraphe || !explicite) {
+				explicite = paquet_cle_titre(ligne, longueur) > 0;
+				avant = ligne;
+				longueurAvant = longueur;
+			}
+			paragraphe = false;
+		}
+		ligne = suivante;
+	}
+	return true;
+}
+
+/**
+* @brief projette un recueil en mémoire et l'indexe
+* @param p type : structure, sortie, recueil (fermé ou déjà ouvert)
+* @param fichier type : chaine, entrée, nom du fichier
+* @return résultat : faux si le fichier est absent, vide, sans niveau ou si
+	la mémoire manque
+*/
+
+static inline bool paquet_ouvrir(t_paquet *p, const char fichier[]){
+	struct stat infos;
+	void *texte;
+	int f;
+
+	paquet_fermer(p);
+	if (strlen(fichier) >= PAQUET_NOM) {
+		return false;
+	}
+	f = open(fichier, O_RDONLY);
+	if (f < 0) {
+		return false;
+	}
+	if (fstat(f, &infos) < 0 || infos.st_size <= 0) {
+		close(f);
+		return false;
+	}
+	texte = mmap(NULL, infos.st_size, PROT_READ, MAP_PRIVATE, f, 0);
+	close(f); // la projection reste valable
+	if (texte == MAP_FAILED) {
+		return false;
+	}
+	p->texte = texte;
+	p->taille = infos.st_size;
+	if (!paquet_indexer(p) || p->nb == 0) {
+		paquet_fermer(p);
+		return false;
+	}
+	strcpy(p->nom, fichier);
+	return true;
+}
+
+/**
+* @brief analyse un niveau du recueil : seules ses lignes sont lues
+* @param p type : structure, entrée, recueil ouvert
+* @param numero type : entier, entrée, numéro du niveau (à partir de 1)
+* @param a type : structure, entrée/sortie, arène qui recevra le plateau
+* @param plateau type : tableau, sortie, plateau lu
+* @param hauteur type : entier, sortie, nombre de lignes
+* @param largeur type : entier, sortie, nombre de colonnes
+* @return résultat : faux si le numéro n'existe pas ou plateau trop grand
+*/
+
+static inline bool paquet_lire(const t_paquet *p, int numero, t_arene *a,
+	char ***plateau, int *hauteur, int *largeur){
+	const t_repere *r;
+
+	if (numero < 1 || numero > p->nb) {
+		return false;
+	}
+	r = &p->niveaux[numero - 1];
+	return niveau_analyser(p->texte + r->debut, r->taille, a, plateau, hauteur, largeur);
+}
+
+/**
+* @brief copie le titre d'un niveau du recueil
+* @param p type : structure, entrée, recueil ouvert
+* @param numero type : entier, entrée, numéro du niveau (à partir de 1)
+* @param titre type : chaine, sortie, titre ("" s'il n'y en a pas)
+* @param taille type : entier, entrée, taille de la chaine titre
+* @return résultat : longueur du titre copié
+*/
+
+static inline int paquet_titre(const t_paquet *p, int numero, char titre[], size_t taille){
+	int longueur = 0;
+
+	if (numero >= 1 && numero <= p->nb && taille > 0) {
+		longueur = p->niveaux[numero - 1].longueurTitre;
+		if ((size_t)longueur > taille - 1) {
+			longueur = taille - 1;
+		}
+		memcpy(titre, p->texte + p->niveaux[numero - 1].titre, longueur);
+	}
+	if (taille > 0) {
+		titre[longueur] = '\0';
+	}
+	return longueur;
+}
+
+/**
+* @brief sépare "recueil.xsb#N" en nom de fichier et numéro de niveau
+* @param nom type : chaine, entrée, nom donné par l'utilisateur
+* @param fichier type : chaine, sortie, nom du fichier (PAQUET_NOM octets)
+* @param numero type : entier, sortie, numéro du niveau (0 : pas de numéro)
+* @return résultat : faux si le nom du fichier est trop long
+*/
+
+static inline bool paquet_separer(const char nom[], char fichier[], int *numero){
+	const char *separateur = strrchr(nom, PAQUET_SEPARATEUR);
+	const char *c;
+	size_t longueur = strlen(nom);
+
+	*numero = 0;
+	if (separateur != NULL && separateur[1] != '\0') {
+		for (c = separateur + 1; *c >= '0' && *c <= '9'; c++);
+		if (*c == '\0') {
+			*numero = atoi(separateur + 1);
+			longueur = separateur - nom;
+		}
+	}
+	if (longueur >= PAQUET_NOM) {
+		return false;
+	}
+	memcpy(fichier, nom, longueur);
+	fichier[longueur] = '\0';
+	return true;
+}
+
+/**
+* @brief charge un niveau désigné par "fichier.sok" ou "recueil.xsb#N". Le
+* recueil reste ouvert : recharger un de ses niveaux ne le relit pas.
+* @param p type : structure, entrée/sortie, dernier recueil ouvert
+* @param nom type : chaine, entrée, nom du niveau
+* @param a type : structure, entrée/sortie, arène qui recevra le plateau
+* @param plateau type : tableau, sortie, plateau lu
+* @param hauteur type : entier, sortie, nombre de lignes
+* @param largeur type : entier, sortie, nombre de colonnes
+* @return résultat : faux si le fichier ou le niveau est absent
+*/
+
+static inline bool paquet_charger(t_paquet *p, const char nom[], t_arene *a,
+	char ***plateau, int *hauteur, int *largeur){
+	char fichier[PAQUET_NOM];
+	int numero;
+
+	if (!paquet_separer(nom, fichier, &numero)) {
+		return false;
+	}
+	if (numero == 0) {
+		return niveau_lire(fichier, a, plateau, hauteur, largeur);
+	}
+	if (strcmp(p->nom, fichier) != 0 && !paquet_ouvrir(p, fichier)) {
+		return false;
+	}
+	return paquet_lire(p, numero, a, plateau, hauteur, largeur);
+}
+
+#endif
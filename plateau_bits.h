@@ -0,0 +1,244 @@
+/**
+* @file plateau_bits.h
+* @brief Représentation du plateau de sokoban en plans de bits
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Le plateau est rangé dans trois plans de bits (murs, caisses, cibles) et la
+* position du joueur. La case (lig, col) correspond au bit lig * pas + col,
+* avec pas = largeur + 1 : la dernière colonne est une colonne de murs pour que
+* les décalages d'une case à gauche ou à droite ne passent jamais d'une ligne
+* à l'autre. Les plans sont pris dans l'arène du niveau (voir niveau.h).
+* Les règles de déplacement et le comptage des caisses se font avec quelques
+* opérations sur des mots de 64 bits au lieu de comparer les caractères du
+* plateau ; le nombre de caisses hors cible est tenu à jour à chaque poussée
+* pour que le test de victoire ne parcoure pas les plans.
+*/
+
+#ifndef PLATEAU_BITS_H
+#define PLATEAU_BITS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include "niveau.h"
+
+// Résultat d'un déplacement sur le plateau de bits.
+#define BITS_BLOQUE 0 // déplacement impossible
+#define BITS_MARCHE 1 // déplacement du joueur seul
+#define BITS_POUSSEE 2 // déplacement du joueur avec une caisse
+
+//Définition du plateau en plans de bits
+typedef struct{
+	int hauteur; // nombre de lignes
+	int largeur; // nombre de colonnes
+	int pas; // décalage d'une ligne à la suivante (largeur + 1)
+	int nbCases; // nombre de cases, colonne de garde comprise
+	int nbMots; // nombre de mots de 64 bits par plan
+	uint64_t *murs; // cases de mur
+	uint64_t *caisses; // cases occupées par une caisse
+	uint64_t *cibles; // cases cibles
+	int joueur; // indice de la case du joueur
+	int restantes; // nombre de caisses hors cible, tenu à jour par bits_deplacer
+} t_plateau_bits;
+
+/**
+* @brief teste un bit d'un plan
+* @param plan type : tableau, entrée, plan de bits
+* @param i type : entier, entrée, indice de la case
+* @return résultat : vrai si le bit est à 1
+*/
+
+static inline bool bits_test(const uint64_t plan[], int i){
+	return (plan[i >> 6] >> (i & 63)) & 1;
+}
+
+/**
+* @brief inverse un bit d'un plan
+* @param plan type : tableau, entrée/sortie, plan de bits
+* @param i type : entier, entrée, indice de la case
+* @return résultat : bit inversé
+*/
+
+static inline void bits_inverser(uint64_t plan[], int i){
+	plan[i >> 6] ^= (uint64_t)1 << (i & 63);
+}
+
+/**
+* @brief compte les caisses qui ne sont pas sur une cible en parcourant les plans
+* @param b type : structure, entrée, plateau de bits
+* @return résultat : nombre de caisses restantes
+*/
+
+static inline int bits_caisses_restantes(const t_plateau_bits *b){
+	int nb = 0;
+
+	for (int m = 0; m < b->nbMots; m++) {
+		nb += __builtin_popcountll(b->caisses[m] & ~b->cibles[m]);
+	}
+	return nb;
+}
+
+/**
+* @brief prend les plans d'un plateau de bits dans une arène
+* @param b type : structure, sortie, plateau de bits
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @param a type : structure, entrée/sortie, arène
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool bits_allouer(t_plateau_bits *b, int hauteur, int largeur, t_arene *a){
+	b->hauteur = hauteur;
+	b->largeur = largeur;
+	b->pas = largeur + 1;
+	b->nbCases = hauteur * b->pas;
+	b->nbMots = (b->nbCases + 63) / 64;
+	b->murs = arene_allouer(a, 3 * b->nbMots * sizeof(uint64_t));
+	b->caisses = b->murs + b->nbMots;
+	b->cibles = b->caisses + b->nbMots;
+	b->joueur = 0;
+	return b->murs != NULL;
+}
+
+/**
+* @brief remplit le plateau de bits à partir du plateau de caractères
+* @param b type : structure, entrée/sortie, plateau de bits déjà alloué
+* @param plateau type : tableau, entrée, plateau de caractères de même taille
+* @return résultat : plans de bits remplis
+*/
+
+static inline void bits_depuis_plateau(t_plateau_bits *b, char **plateau){
+	int i;
+	char c;
+
+	for (int m = 0; m < b->nbMots; m++) {
+		b->murs[m] = 0;
+		b->caisses[m] = 0;
+		b->cibles[m] = 0;
+	}
+	b->joueur = 0;
+	for (int lig = 0; lig < b->hauteur; lig++) {
+		bits_inverser(b->murs, lig * b->pas + b->largeur); // colonne de garde
+		for (int col = 0; col < b->largeur; col++) {
+			i = lig * b->pas + col;
+			c = plateau[lig][col];
+			if (c == '#') {
+				bits_inverser(b->murs, i);
+			}
+			if (c == '$' || c == '*') {
+				bits_inverser(b->caisses, i);
+			}
+			if (c == '.' || c == '*' || c == '+') {
+				bits_inverser(b->cibles, i);
+			}
+			if (c == '@' || c == '+') {
+				b->joueur = i;
+			}
+		}
+	}
+	b->restantes = bits_caisses_restantes(b);
+}
+
+/**
+* @brief reconstruit le plateau de caractères (affichage, sauvegarde)
+* @param b type : structure, entrée, plateau de bits
+* @param plateau type : tableau, sortie, plateau de caractères
+* @return résultat : plateau de caractères rempli
+*/
+
+static inline void bits_vers_plateau(const t_plateau_bits *b, char **plateau){
+	int i;
+	bool cible;
+
+	for (int lig = 0; lig < b->hauteur; lig++) {
+		for (int col = 0; col < b->largeur; col++) {
+			i = lig * b->pas + col;
+			cible = bits_test(b->cibles, i);
+			if (bits_test(b->murs, i)) {
+				plateau[lig][col] = '#';
+			}
+			else if (bits_test(b->caisses, i)) {
+				plateau[lig][col] = cible ? '*' : '$';
+			}
+			else if (i == b->joueur) {
+				plateau[lig][col] = cible ? '+' : '@';
+			}
+			else {
+				plateau[lig][col] = cible ? '.' : ' ';
+			}
+		}
+	}
+}
+
+/**
+* @brief donne le décalage d'indice correspondant à un caractère de déplacement
+* @param b type : structure, entrée, plateau de bits
+* @param lettre type : caractère, entrée, g/d/h/b en minuscule ou majuscule
+* @return résultat : décalage de la case, 0 si ce n'est pas un déplacement
+*/
+
+static inline int bits_decalage(const t_plateau_bits *b, char lettre){
+	int decalage = 0;
+
+	switch (tolower(lettre)) {
+		case 'h':
+			decalage = -b->pas;
+			break;
+		case 'b':
+			decalage = b->pas;
+			break;
+		case 'g':
+			decalage = -1;
+			break;
+		case 'd':
+			decalage = 1;
+			break;
+		default:
+			break;
+	}
+	return decalage;
+}
+
+/**
+* @brief déplace le joueur, et la caisse devant lui s'il y en a une
+* @param b type : structure, entrée/sortie, plateau de bits
+* @param decalage type : entier, entrée, décalage donné par bits_decalage
+* @return résultat : BITS_BLOQUE, BITS_MARCHE ou BITS_POUSSEE
+*/
+
+static inline int bits_deplacer(t_plateau_bits *b, int decalage){
+	int dest = b->joueur + decalage; // case de destination du joueur
+	int cas = dest + decalage; // case de destination de la caisse
+	int statut = BITS_BLOQUE;
+
+	// les bords haut et bas du plateau comptent comme des murs
+	if (dest >= 0 && dest < b->nbCases && !bits_test(b->murs, dest)) {
+		if (!bits_test(b->caisses, dest)) {
+			b->joueur = dest;
+			statut = BITS_MARCHE;
+		}
+		else if (cas >= 0 && cas < b->nbCases &&
+			!bits_test(b->murs, cas) && !bits_test(b->caisses, cas)) {
+			bits_inverser(b->caisses, dest);
+			bits_inverser(b->caisses, cas);
+			b->restantes += bits_test(b->cibles, dest) - bits_test(b->cibles, cas);
+			b->joueur = dest;
+			statut = BITS_POUSSEE;
+		}
+	}
+	return statut;
+}
+
+/**
+* @brief vérifie si toutes les caisses sont sur des cibles
+* @param b type : structure, entrée, plateau de bits
+* @return résultat : vrai si la partie est gagnée
+*/
+
+static inline bool bits_gagner(const t_plateau_bits *b){
+	return b->restantes == 0;
+}
+
+#endif
@@ -0,0 +1,338 @@
+/**
+* @file remplissage.h
+* @brief Cases que le joueur peut atteindre sans pousser, par remplissage des
+* plans de bits
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Le remplissage part de la case du joueur et s'étend aux cases libres (ni
+* mur ni caisse) du plateau de bits de plateau_bits.h, sans file de cases :
+* chaque étape décale tout le plan atteint et le masque par le plan libre.
+*
+* Un décalage d'une seule case par étape demanderait autant d'étapes que le
+* plus long chemin. Le remplissage avance donc par doublement (Kogge-Stone) :
+* avec g les cases atteintes et p les cases libres,
+*     g |= p & (g << s) ; p &= p << s ;   pour s = 1, 2, 4, ...
+* remplit en log2(largeur) étapes chaque tronçon libre d'une ligne qui touche
+* une case atteinte, et de même en colonne avec s = pas, 2 pas, 4 pas...
+* Un tour fait les quatre directions ; on recommence tant que le tour ajoute
+* des cases, soit environ une fois par tournant des chemins.
+*
+* Un décalage de s bits du plan se fait mot par mot : le mot m reçoit les
+* mots m - s/64 et m - s/64 - 1 décalés de s % 64 bits. Ces décalages sont
+* les mêmes pour tous les mots : avec AVX2 (ou SSE2) quatre mots (ou deux)
+* sont traités par instruction, sinon le calcul se fait sur un mot à la fois.
+* Le choix se fait à la compilation (gcc -mavx2 ou -march=native pour
+* AVX2, SSE2 est toujours présent en x86-64).
+*
+* rempl_par_file fait le même calcul par un parcours en largeur avec une file
+* de cases : c'est la référence des mesures (sokoban -suite) et des essais.
+*/
+
+#ifndef REMPLISSAGE_H
+#define REMPLISSAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "niveau.h"
+#include "plateau_bits.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define REMPL_VECTEUR 4 // mots de 64 bits par instruction
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define REMPL_VECTEUR 2
+#else
+#define REMPL_VECTEUR 1
+#endif
+
+//Définition des plans de travail du remplissage
+typedef struct{
+	int nbMots; // mots de 64 bits par plan (comme le plateau de bits)
+	uint64_t *libres; // cases sans mur ni caisse
+	uint64_t *masque; // cases libres restantes pendant un remplissage (p)
+	int *file; // file de cases de rempl_par_file
+	bool vectoriel; // faux : calcul sur un mot à la fois même avec SSE2/AVX2
+} t_remplissage;
+
+/**
+* @brief prend les plans de travail dans une arène
+* @param r type : structure, sortie, plans de travail
+* @param b type : structure, entrée, plateau de bits déjà alloué
+* @param a type : structure, entrée/sortie, arène
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool rempl_allouer(t_remplissage *r, const t_plateau_bits *b, t_arene *a){
+	r->nbMots = b->nbMots;
+	r->libres = arene_allouer(a, 2 * b->nbMots * sizeof(uint64_t));
+	r->masque = (r->libres != NULL) ? r->libres + b->nbMots : NULL;
+	r->file = arene_allouer(a, b->nbCases * sizeof(int));
+	r->vectoriel = REMPL_VECTEUR > 1;
+	return r->libres != NULL && r->file != NULL;
+}
+
+/**
+* @brief mot m du plan décalé vers les indices croissants (x << s)
+* @param x type : tableau, entrée, plan de bits
+* @param m type : entier, entrée, indice du mot
+* @param q type : entier, entrée, s / 64
+* @param d type : entier, entrée, s % 64
+* @return résultat : mot décalé, les bits venus d'avant le plan sont nuls
+*/
+
+static inline uint64_t rempl_mot_haut(const uint64_t x[], int m, int q, int d){
+	uint64_t haut = (m - q >= 0) ? x[m - q] : 0;
+	uint64_t bas = (m - q - 1 >= 0) ? x[m - q - 1] : 0;
+
+	return (d == 0) ? haut : (haut << d) | (bas >> (64 - d));
+}
+
+/**
+* @brief mot m du plan décalé vers les indices décroissants (x >> s)
+* @param x type : tableau, entrée, plan de bits
+* @param n type : entier, entrée, nombre de mots du plan
+* @param m type : entier, entrée, indice du mot
+* @param q type : entier, entrée, s / 64
+* @param d type : entier, entrée, s % 64
+* @return résultat : mot décalé, les bits venus d'après le plan sont nuls
+*/
+
+static inline uint64_t rempl_mot_bas(const uint64_t x[], int n, int m, int q, int d){
+	uint64_t bas = (m + q < n) ? x[m + q] : 0;
+	uint64_t haut = (m + q + 1 < n) ? x[m + q + 1] : 0;
+
+	return (d == 0) ? bas : (bas >> d) | (haut << (64 - d));
+}
+
+/**
+* @brief une étape de doublement vers les indices croissants, sur place :
+* g |= p & (g << s) ; p &= p << s. Les mots sont pris du dernier au premier,
+* chacun ne lit que des mots pas encore modifiés.
+* @param g type : tableau, entrée/sortie, cases atteintes
+* @param p type : tableau, entrée/sortie, cases libres restantes
+* @param n type : entier, entrée, nombre de mots
+* @param s type : entier, entrée, décalage en bits
+* @param vectoriel type : booléen, entrée, faux pour un mot à la fois
+* @return résultat : plans mis à jour
+*/
+
+static inline void rempl_etape_haut(uint64_t g[], uint64_t p[], int n, int s, bool vectoriel){
+	int q = s / 64;
+	int d = s % 64;
+	int m = n - 1;
+	uint64_t sg;
+	uint64_t sp;
+
+#if REMPL_VECTEUR == 4
+	__m128i gauche = _mm_cvtsi32_si128(d);
+	__m128i droite = _mm_cvtsi32_si128(64 - d); // 64 donne 0 : pas de cas à part
+	__m256i vg;
+	__m256i vp;
+
+	// quatre mots m-3..m à la fois tant que le mot m-q-4 existe
+	for (; vectoriel && m - 3 - q - 1 >= 0; m -= 4) {
+		vg = _mm256_or_si256(_mm256_sll_epi64(_mm256_loadu_si256((const __m256i *)&g[m - 3 - q]), gauche),
+			_mm256_srl_epi64(_mm256_loadu_si256((const __m256i *)&g[m - 4 - q]), droite));
+		vp = _mm256_or_si256(_mm256_sll_epi64(_mm256_loadu_si256((const __m256i *)&p[m - 3 - q]), gauche),
+			_mm256_srl_epi64(_mm256_loadu_si256((const __m256i *)&p[m - 4 - q]), droite));
+		vp = _mm256_and_si256(vp, _mm256_loadu_si256((const __m256i *)&p[m - 3]));
+		vg = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)&g[m - 3]),
+			_mm256_and_si256(vg, _mm256_loadu_si256((const __m256i *)&p[m - 3])));
+		_mm256_storeu_si256((__m256i *)&g[m - 3], vg);
+		_mm256_storeu_si256((__m256i *)&p[m - 3], vp);
+	}
+#elif REMPL_VECTEUR == 2
+	__m128i gauche = _mm_cvtsi32_si128(d);
+	__m128i droite = _mm_cvtsi32_si128(64 - d); // 64 donne 0 : pas de cas à part
+	__m128i vg;
+	__m128i vp;
+
+	// deux mots m-1..m à la fois tant que le mot m-q-2 existe
+	for (; vectoriel && m - 1 - q - 1 >= 0; m -= 2) {
+		vg = _mm_or_si128(_mm_sll_epi64(_mm_loadu_si128((const __m128i *)&g[m - 1 - q]), gauche),
+			_mm_srl_epi64(_mm_loadu_si128((const __m128i *)&g[m - 2 - q]), droite));
+		vp = _mm_or_si128(_mm_sll_epi64(_mm_loadu_si128((const __m128i *)&p[m - 1 - q]), gauche),
+			_mm_srl_epi64(_mm_loadu_si128((const __m128i *)&p[m - 2 - q]), droite));
+		vp = _mm_and_si128(vp, _mm_loadu_si128((const __m128i *)&p[m - 1]));
+		vg = _mm_or_si128(_mm_loadu_si128((const __m128i *)&g[m - 1]),
+			_mm_and_si128(vg, _mm_loadu_si128((const __m128i *)&p[m - 1])));
+		_mm_storeu_si128((__m128i *)&g[m - 1], vg);
+		_mm_storeu_si128((__m128i *)&p[m - 1], vp);
+	}
+#else
+	(void)vectoriel;
+#endif
+	// début du plan (et tout le plan sans SSE2/AVX2)
+	for (; m >= 0; m--) {
+		sg = rempl_mot_haut(g, m, q, d);
+		sp = rempl_mot_haut(p, m, q, d);
+		g[m] |= p[m] & sg;
+		p[m] &= sp;
+	}
+}
+
+/**
+* @brief une étape de doublement vers les indices décroissants, sur place :
+* g |= p & (g >> s) ; p &= p >> s. Les mots sont pris du premier au dernier.
+* @param g type : tableau, entrée/sortie, cases atteintes
+* @param p type : tableau, entrée/sortie, cases libres restantes
+* @param n type : entier, entrée, nombre de mots
+* @param s type : entier, entrée, décalage en bits
+* @param vectoriel type : booléen, entrée, faux pour un mot à la fois
+* @return résultat : plans mis à jour
+*/
+
+static inline void rempl_etape_bas(uint64_t g[], uint64_t p[], int n, int s, bool vectoriel){
+	int q = s / 64;
+	int d = s % 64;
+	int m = 0;
+	uint64_t sg;
+	uint64_t sp;
+
+#if REMPL_VECTEUR == 4
+	__m128i droite = _mm_cvtsi32_si128(d);
+	__m128i gauche = _mm_cvtsi32_si128(64 - d);
+	__m256i vg;
+	__m256i vp;
+
+	// quatre mots m..m+3 à la fois tant que le mot m+3+q+1 existe
+	for (; vectoriel && m + 3 + q + 1 < n; m += 4) {
+		vg = _mm256_or_si256(_mm256_srl_epi64(_mm256_loadu_si256((const __m256i *)&g[m + q]), droite),
+			_mm256_sll_epi64(_mm256_loadu_si256((const __m256i *)&g[m + q + 1]), gauche));
+		vp = _mm256_or_si256(_mm256_srl_epi64(_mm256_loadu_si256((const __m256i *)&p[m + q]), droite),
+			_mm256_sll_epi64(_mm256_loadu_si256((const __m256i *)&p[m + q + 1]), gauche));
+		vp = _mm256_and_si256(vp, _mm256_loadu_si256((const __m256i *)&p[m]));
+		vg = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)&g[m]),
+			_mm256_and_si256(vg, _mm256_loadu_si256((const __m256i *)&p[m])));
+		_mm256_storeu_si256((__m256i *)&g[m], vg);
+		_mm256_storeu_si256((__m256i *)&p[m], vp);
+	}
+#elif REMPL_VECTEUR == 2
+	__m128i droite = _mm_cvtsi32_si128(d);
+	__m128i gauche = _mm_cvtsi32_si128(64 - d);
+	__m128i vg;
+	__m128i vp;
+
+	// deux mots m..m+1 à la fois tant que le mot m+1+q+1 existe
+	for (; vectoriel && m + 1 + q + 1 < n; m += 2) {
+		vg = _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128((const __m128i *)&g[m + q]), droite),
+			_mm_sll_epi64(_mm_loadu_si128((const __m128i *)&g[m + q + 1]), gauche));
+		vp = _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128((const __m128i *)&p[m + q]), droite),
+			_mm_sll_epi64(_mm_loadu_si128((const __m128i *)&p[m + q + 1]), gauche));
+		vp = _mm_and_si128(vp, _mm_loadu_si128((const __m128i *)&p[m]));
+		vg = _mm_or_si128(_mm_loadu_si128((const __m128i *)&g[m]),
+			_mm_and_si128(vg, _mm_loadu_si128((const __m128i *)&p[m])));
+		_mm_storeu_si128((__m128i *)&g[m], vg);
+		_mm_storeu_si128((__m128i *)&p[m], vp);
+	}
+#else
+	(void)vectoriel;
+#endif
+	// fin du plan (et tout le plan sans SSE2/AVX2)
+	for (; m < n; m++) {
+		sg = rempl_mot_bas(g, n, m, q, d);
+		sp = rempl_mot_bas(p, n, m, q, d);
+		g[m] |= p[m] & sg;
+		p[m] &= sp;
+	}
+}
+
+/**
+* @brief remplit dans une direction tous les tronçons libres qui touchent une
+* case atteinte
+* @param r type : structure, entrée/sortie, plans de travail (libres calculé)
+* @param atteintes type : tableau, entrée/sortie, cases atteintes
+* @param unite type : entier, entrée, 1 pour les lignes, pas pour les colonnes
+* @param limite type : entier, entrée, décalage au-delà duquel on s'arrête
+* @param haut type : booléen, entrée, vrai vers les indices croissants
+* @return résultat : cases atteintes complétées
+*/
+
+static inline void rempl_direction(t_remplissage *r, uint64_t atteintes[], int unite, int limite, bool haut){
+	for (int m = 0; m < r->nbMots; m++) {
+		r->masque[m] = r->libres[m];
+	}
+	for (int s = unite; s < limite; s *= 2) {
+		if (haut) {
+			rempl_etape_haut(atteintes, r->masque, r->nbMots, s, r->vectoriel);
+		}
+		else {
+			rempl_etape_bas(atteintes, r->masque, r->nbMots, s, r->vectoriel);
+		}
+	}
+}
+
+/**
+* @brief calcule les cases que le joueur peut atteindre sans pousser de caisse
+* @param r type : structure, entrée/sortie, plans de travail
+* @param b type : structure, entrée, plateau de bits
+* @param atteintes type : tableau, sortie, plan des cases atteintes (b->nbMots mots)
+* @return résultat : nombre de cases atteintes, case du joueur comprise
+*/
+
+static inline int rempl_joueur(t_remplissage *r, const t_plateau_bits *b, uint64_t atteintes[]){
+	int nb = 1;
+	int avant = 0;
+
+	for (int m = 0; m < b->nbMots; m++) {
+		r->libres[m] = ~(b->murs[m] | b->caisses[m]);
+		atteintes[m] = 0;
+	}
+	// les bits après la dernière case ne sont pas des cases
+	if (b->nbCases % 64 != 0) {
+		r->libres[b->nbMots - 1] &= ((uint64_t)1 << (b->nbCases % 64)) - 1;
+	}
+	bits_inverser(atteintes, b->joueur);
+	while (nb != avant) {
+		avant = nb;
+		rempl_direction(r, atteintes, 1, b->pas, true);
+		rempl_direction(r, atteintes, 1, b->pas, false);
+		rempl_direction(r, atteintes, b->pas, b->nbCases, true);
+		rempl_direction(r, atteintes, b->pas, b->nbCases, false);
+		nb = 0;
+		for (int m = 0; m < b->nbMots; m++) {
+			nb += __builtin_popcountll(atteintes[m]);
+		}
+	}
+	return nb;
+}
+
+/**
+* @brief même calcul que rempl_joueur par un parcours en largeur avec une
+* file de cases (référence des mesures)
+* @param r type : structure, entrée/sortie, plans de travail
+* @param b type : structure, entrée, plateau de bits
+* @param atteintes type : tableau, sortie, plan des cases atteintes
+* @return résultat : nombre de cases atteintes, case du joueur comprise
+*/
+
+static inline int rempl_par_file(t_remplissage *r, const t_plateau_bits *b, uint64_t atteintes[]){
+	const int decalages[4] = {-b->pas, b->pas, -1, 1};
+	int debut = 0;
+	int fin = 0;
+	int c;
+	int v;
+
+	for (int m = 0; m < b->nbMots; m++) {
+		atteintes[m] = 0;
+	}
+	bits_inverser(atteintes, b->joueur);
+	r->file[fin++] = b->joueur;
+	while (debut < fin) {
+		c = r->file[debut++];
+		for (int d = 0; d < 4; d++) {
+			v = c + decalages[d];
+			if (v >= 0 && v < b->nbCases && !bits_test(atteintes, v) &&
+				!bits_test(b->murs, v) && !bits_test(b->caisses, v)) {
+				bits_inverser(atteintes, v);
+				r->file[fin++] = v;
+			}
+		}
+	}
+	return fin;
+}
+
+#endif
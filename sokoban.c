@@ -9,6 +9,9 @@
 * l'utilisateur contenant des caractères en majuscules ou minuscules afin de déplacer
 * le personnage en fonction de la lettre.
 * 
+* Compilation : gcc sokoban.c -o Sokoban -lpthread
+* Version de mesure (sokoban -suite compte les allocations) :
+*               gcc -O2 -DBANC_ALLOCATIONS sokoban.c -o sokoban_banc -lpthread
 *
 */
 
@@ -19,25 +22,133 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <ctype.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 
 // Définition de la taille du tableau.
-#define MAXLIG 12
-#define MAXDEP 10000
 #define TAILLE_FICHIER 50
+#define TAILLE_LIGNE 256
+#define MAXTHREADS 256
+#define REPETITIONS_BANC 20000
+#define BANC_ESSAIS 3 // essais de chaque mesure de la suite, le plus rapide compte
+#define REPRISE_PAS 256 // coups entre deux points de reprise du rejeu
+#define LECTURE_MS 500 // durée d'un coup pendant la lecture du rejeu
 
-typedef char t_plateau[MAXLIG][MAXLIG];
-typedef char typeDeplacements[MAXDEP];
+#include "banc.h" // en premier : compte les allocations des autres en-têtes (BANC_ALLOCATIONS)
+#include "niveau.h"
+#include "paquet.h"
+#include "historique.h"
+#include "journal.h"
+#include "transitions.h"
+#include "binaire.h"
+#include "plateau_bits.h"
+#include "impasses.h"
+#include "etat.h"
+#include "ecran.h"
+#include "clavier.h"
+#include "optimiseur.h"
+#include "remplissage.h"
+#include "compteurs.h"
+
+// Résultat de l'application d'un caractère de déplacement.
+#define DEP_IGNORE 0 // caractère qui n'est pas un déplacement
+#define DEP_ILLEGAL 1 // déplacement bloqué par un mur ou une caisse
+#define DEP_SIMPLE 2 // déplacement du joueur seul
+#define DEP_POUSSEE 3 // déplacement du joueur avec une caisse
+#define DEP_ANNULE 4 // retour sur le déplacement précédent
+
+typedef char **t_plateau; // lignes du plateau, taille lue dans le fichier
+
+//Définition des points de reprise du rejeu pas à pas : le plateau codé
+//(voir etat.h, joueur sur sa case exacte) tous les REPRISE_PAS coups, et les
+//coups du journal que les annulations 'u' qui suivent défont
+typedef struct{
+	t_codage codage; // codage des plateaux du niveau
+	unsigned char *etats; // plateaux codés, codage.octets chacun
+	t_delta *annules; // coups du journal repris à chaque point, bout à bout
+	int *premiers; // indice dans annules des coups de chaque point (nb + 1 valeurs)
+	int nbAnnules; // coups gardés dans annules
+	int capaciteAnnules; // taille allouée de annules
+	int nb; // nombre de points de reprise
+	int fin; // nombre de coups du rejeu (arrêt à la victoire)
+	bool gagne; // le rejeu se termine sur une victoire
+	double dureeSaut; // durée du dernier saut en microsecondes
+} t_reprises;
 
 //Définition de la structure de jeu
 typedef struct{
 	int posx; // position horizontale du joueur
 	int posy; // position verticale du joueur
 	int nbDep; // nombre de déplacements effectués
+	int nbCaisses; // nombre de caisses qui ne sont pas sur une cible
 	int animation; // nombre de jeu->animations sur l'entête
+	int hauteur; // nombre de lignes du plateau
+	int largeur; // nombre de colonnes du plateau
+	t_arene *arene; // mémoire qui contient le plateau
+	t_paquet *paquet; // dernier recueil ouvert (niveaux recueil.xsb#N)
 	t_plateau plateau; // déclaration du plateau de jeu
-	typeDeplacements historiqueDep; // déclaration du tableau des déplacements
+	uint64_t empreinte; // empreinte du niveau chargé (voir binaire.h)
+	bool *mortes; // cases mortes, indice lig * (largeur + 1) + col (voir impasses.h)
+	bool impasse; // le dernier coup a poussé une caisse dans une impasse
+	t_historique historiqueDep; // déplacements du fichier, sans limite de taille
+	t_journal journal; // changements des coups joués, pour les annulations 'u'
+	t_ecran ecran; // image affichée pendant l'analyse pas à pas
+	t_reprises reprises; // points de reprise de l'analyse pas à pas
 } t_partie;
 
+//Définition du résultat de l'analyse d'un couple niveau / déplacements
+typedef struct{
+	bool valide; // les déplacements résolvent le niveau
+	int nbCoups; // nombre de déplacements effectués
+	int nbPoussees; // nombre de caisses poussées
+	int nbAnnulations; // nombre de retours effectués
+	int premierIllegal; // indice du premier déplacement illégal (-1 si aucun)
+	int premiereImpasse; // indice de la première poussée qui mène à une impasse (-1 si aucune)
+	int nbLus; // nombre de caractères analysés
+	double duree; // durée de l'analyse en microsecondes
+} t_resultat;
+
+//Définition d'une tâche d'analyse (un couple niveau / déplacements)
+typedef struct{
+	char fichier[TAILLE_LIGNE]; // le nom du fichier de la partie
+	char deplacements[TAILLE_LIGNE]; // le nom du fichier des déplacements
+	bool lu; // les deux fichiers ont pu être lus et analysés
+	t_resultat res; // résultat de l'analyse
+} t_tache;
+
+//Définition de la liste des tâches d'un lot
+typedef struct{
+	t_tache *taches; // tableau des tâches, dans l'ordre d'affichage
+	int nb; // nombre de tâches
+	int capacite; // taille allouée du tableau
+} t_lot;
+
+//Définition d'une file de vol de tâches (deque de Chase-Lev).
+//Le propriétaire retire par le bas, les autres volent par le haut.
+typedef struct{
+	int *indices; // indices des tâches dans le lot
+	atomic_long haut; // prochaine tâche à voler
+	atomic_long bas; // fin de la file côté propriétaire
+} t_file_vol;
+
+//Définition du contexte partagé par les threads d'analyse
+typedef struct{
+	t_lot *lot; // tâches à analyser
+	t_file_vol *files; // une file par thread
+	int nbThreads; // nombre de threads
+	atomic_int aDistribuer; // tâches encore dans les files (aucune n'y est ajoutée ensuite)
+} t_pool;
+
+//Définition des arguments d'un thread d'analyse
+typedef struct{
+	t_pool *pool; // contexte partagé
+	int numero; // numéro du thread (et de sa file)
+} t_ouvrier;
+
 
 // Définition des caractères constantes.
 const char CAISSE = '$';
@@ -61,146 +172,351 @@ const char CAISSE_BAS = 'B';
 
 
 // liste des procédures déclarées
-void chargerPartie(t_plateau plateau, char fichier[]);
-void chargerDeplacements(typeDeplacements t, char fichier[], int * nb);
+bool chargerPartie(t_partie *jeu, char fichier[]);
+bool chargerDeplacements(t_historique *t, char fichier[], int * nb, uint64_t empreinte);
+bool coder_partie(t_partie *jeu, t_codage *codage, bool coin, unsigned char etat[]);
+bool decoder_partie(t_partie *jeu, const t_codage *codage, const unsigned char etat[]);
 void afficher_entete(t_partie *jeu, char fichier[], char deplacements[]);
 void afficher_plateau(t_partie *jeu);
 void chercher_joueur(t_partie *jeu);
-void conditions_dep(t_partie *jeu, int depx, int depy, char touche);
-void deplacer_joueur(t_partie *jeu, int depx, int depy);
-void deplacer_caisse(t_partie *jeu, int depx, int depy, int casx, int casy);
-void annuler_deplacer(t_partie *jeu, char last);
+bool dans_plateau(t_partie *jeu, int lig, int col);
+int conditions_dep(t_partie *jeu, int depx, int depy, char touche);
+bool annuler_deplacer(t_partie *jeu);
+int appliquer_deplacement(t_partie *jeu);
+bool car_lire_mur(const void *partie, int c);
+bool car_lire_caisse(const void *partie, int c);
+bool car_lire_cible(const void *partie, int c);
+bool poussee_impasse(t_partie *jeu, int lig, int col);
+int jouer_coup(t_partie *jeu, char coup);
+int appliquer_coups(t_partie *jeu, const char coups[], int nb, t_bilan *bilan);
+void rejouer_historique(t_partie *jeu, int fin, t_bilan *bilan);
 void Analyse(t_partie *jeu, char fichier[], char deplacements[]);
+bool garder_annule(t_reprises *r, const t_delta *delta);
+void ordonner_annules(t_reprises *r);
+bool preparer_reprises(t_partie *jeu, int maxTaille);
+void aller_au_coup(t_partie *jeu, int coup);
+void liberer_reprises(t_partie *jeu);
+int banc_saut(int argc, char *argv[]);
+bool verifier_journal();
+int verifier();
+bool ecrire_niveau_test(char fichier[], int taille);
+void noter_mesure(t_releve *serie, char nom[], double nbOps, double duree, long allocations);
+int banc_suite(int argc, char *argv[]);
+int convertir_deplacements(int argc, char *argv[]);
+int optimiser_deplacements(int argc, char *argv[]);
 bool gagner(t_partie *jeu);
+bool analyser_couple(char fichier[], char deplacements[], t_resultat *res, t_arene *arene, t_paquet *paquet);
+bool rejouer_bits(t_partie *jeu, int maxTaille, t_resultat *res);
+bool bits_lire_mur(const void *plateau, int c);
+bool bits_lire_caisse(const void *plateau, int c);
+bool bits_lire_cible(const void *plateau, int c);
+int banc_essai(int argc, char *argv[]);
+void afficher_resultat(char fichier[], char deplacements[], t_resultat *res);
+void ajouter_tache(t_lot *lot, char fichier[], char deplacements[]);
+bool lire_manifeste(t_lot *lot, char manifeste[]);
+bool lire_dossier(t_lot *lot, char dossier[]);
+int comparer_taches(const void *a, const void *b);
+int retirer_tache(t_file_vol *file);
+int voler_tache(t_file_vol *file);
+void *analyser_taches(void *arg);
+bool analyser_lot_parallele(t_lot *lot, int nbThreads);
+int analyse_lot(int argc, char *argv[]);
+double temps_us();
 
 /**
 * @brief coeur du programme
-* Initialise la partie, charge le niveau et lance le jeu.
+* Initialise la partie, charge le niveau et lance le jeu. Si des fichiers
+* sont passés en arguments, l'analyse se fait sans affichage (voir analyse_lot).
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
 * @return EXIT_SUCCESS: arrêt normal du programme
 */
 
-int main(){
+int main(int argc, char *argv[]){
+	cpt_demarrer("sokoban"); // compteurs écrits en JSON si SOKOBAN_COMPTEURS est défini
+	if (argc > 1 && strcmp(argv[1], "-bench") == 0) {
+		return banc_essai(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "-saut") == 0) {
+		return banc_saut(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "-suite") == 0) {
+		return banc_suite(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "-verifier") == 0) {
+		return verifier();
+	}
+	if (argc > 1 && (strcmp(argv[1], "-binaire") == 0 || strcmp(argv[1], "-texte") == 0)) {
+		return convertir_deplacements(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "-optimiser") == 0) {
+		return optimiser_deplacements(argc, argv);
+	}
+	if (argc > 1) {
+		return analyse_lot(argc, argv);
+	}
+
 	t_partie jeu;
+	t_arene arene; // mémoire du plateau
+	t_paquet paquet; // recueil de niveaux (fichier.xsb#N)
+	arene_init(&arene);
+	paquet_init(&paquet);
+	jeu.arene = &arene;
+	jeu.paquet = &paquet;
 	jeu.posx = 0; // initialisation de la position
 	jeu.posy = 0; 
 	jeu.nbDep = 0; // initialisation du nombre de déplacements
 	jeu.animation = 1;
-	int maxTaille; // nombre de caractères dans le tableau des déplacements
+	hist_init(&jeu.historiqueDep);
+	jour_init(&jeu.journal);
+	ecran_init(&jeu.ecran);
+	int maxTaille = 0; // nombre de caractères dans le tableau des déplacements
 	char fichier[TAILLE_FICHIER]; // le nom du fichier de la partie
 	char deplacements[TAILLE_FICHIER]; // le nom du fichier des déplacements
+	int lu; // touche lue ou CLAVIER_AUCUNE / CLAVIER_FIN
+	int coup; // coup à afficher
+	bool lecture = true; // les coups avancent seuls
+	bool entreeFermee = false; // plus aucune touche ne viendra
+	bool quitter = false;
 
 	// sélection du niveau
-	printf("Quel niveau voulez vous charger ? (ex: niveau1.sok) : ");
+	printf("Quel niveau voulez vous charger ? (ex: niveau1.sok ou recueil.xsb#12) : ");
 	scanf("%s", fichier); // sélection du fichier de la partie
-	chargerPartie(jeu.plateau, fichier); // charge le fichier du plateau
+	// charge le fichier du plateau
+	if (!chargerPartie(&jeu, fichier)) {
+		printf("ERREUR SUR FICHIER");
+		exit(EXIT_FAILURE);
+	}
 	
 	printf("Entrez le nom du fichier de déplacements (ex: niveau1.sok) : ");
 	scanf("%s", deplacements); // sélection du fichier des déplacements
-	chargerDeplacements(jeu.historiqueDep, deplacements, &maxTaille);
+	if (!chargerDeplacements(&jeu.historiqueDep, deplacements, &maxTaille, jeu.empreinte)) {
+		printf("FICHIER NON TROUVE\n");
+	}
+	else if (maxTaille == 0) {
+		printf("FICHIER VIDE\n");
+	}
 
-	system("clear");
+	chercher_joueur(&jeu);
+	// rejeu complet sans affichage : points de reprise pour les sauts
+	if (!preparer_reprises(&jeu, maxTaille)) {
+		printf("MEMOIRE INSUFFISANTE\n");
+		exit(EXIT_FAILURE);
+	}
+	while (getchar() != '\n' && !feof(stdin)); // reste de la ligne
+	clavier_brut();
 	afficher_entete(&jeu, fichier, deplacements); 
 	afficher_plateau(&jeu);
-	chercher_joueur(&jeu);
 
-	// tant qu'il y a des caisses à déplacer
-	while (jeu.nbDep < maxTaille && !gagner(&jeu)) {
-		usleep(500000); // pause de 0.25 seconde
-		Analyse(&jeu, fichier, deplacements); //
-		jeu.nbDep++;
+	// lecture coup par coup, ou saut vers un coup demandé au clavier
+	while (!quitter) {
+		if (entreeFermee) {
+			lu = CLAVIER_AUCUNE;
+			usleep(LECTURE_MS * 1000);
+		}
+		else {
+			lu = clavier_attendre(lecture ? LECTURE_MS : CLAVIER_INFINI);
+		}
+		if (lu == CLAVIER_FIN) {
+			entreeFermee = true;
+			lecture = true; // lecture jusqu'au bout, comme sans clavier
+			continue;
+		}
+		coup = jeu.nbDep;
+		switch (lu) {
+			case CLAVIER_AUCUNE:
+				coup++;
+				break;
+			case ' ':
+				lecture = !lecture;
+				break;
+			case 'd':
+				coup++;
+				lecture = false;
+				break;
+			case 'q':
+				coup--;
+				lecture = false;
+				break;
+			case 's':
+				coup += jeu.reprises.fin / 10 + 1;
+				break;
+			case 'z':
+				coup -= jeu.reprises.fin / 10 + 1;
+				break;
+			case 'a':
+				coup = 0;
+				break;
+			case 'e':
+				coup = jeu.reprises.fin;
+				break;
+			case 'x':
+				quitter = true;
+				break;
+			default:
+				break;
+		}
+		if (coup > jeu.reprises.fin) {
+			coup = jeu.reprises.fin;
+		}
+		if (coup < 0) {
+			coup = 0;
+		}
+		// un nouveau tronçon repart de son point de reprise (voir aller_au_coup)
+		if (coup == jeu.nbDep + 1 && coup % REPRISE_PAS != 0 && lu == CLAVIER_AUCUNE) {
+			Analyse(&jeu, fichier, deplacements); // coup suivant de la lecture
+			jeu.nbDep++;
+		}
+		else if (coup != jeu.nbDep) {
+			aller_au_coup(&jeu, coup);
+			afficher_entete(&jeu, fichier, deplacements);
+			afficher_plateau(&jeu);
+		}
+		if (jeu.nbDep == jeu.reprises.fin) {
+			lecture = false;
+			quitter = quitter || entreeFermee;
+		}
 	}
+	clavier_normal();
 
-	// affichage des résultats
-	if (gagner(&jeu)) {
+	// affichage des résultats, pour le rejeu complet
+	if (jeu.reprises.gagne) {
 		printf("La suite de déplacements %s est bien une solution pour la partie %s.\n", fichier, deplacements);
-		if (jeu.nbDep < maxTaille){
+		if (jeu.reprises.fin < maxTaille){
 			printf("Elle contenait de base %d caractères.\n", maxTaille);
 		}
-		printf("La partie contient actuellement %d déplacements.\n", jeu.nbDep);
+		printf("La partie contient actuellement %d déplacements.\n", jeu.reprises.fin);
 	} 
 	
 	else {
 		printf("La suite de déplacements %s N'EST PAS une solution pour la partie %s! \n", fichier, deplacements);
 	}
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	hist_liberer(&jeu.historiqueDep);
+	jour_liberer(&jeu.journal);
+	ecran_liberer(&jeu.ecran);
+	liberer_reprises(&jeu);
 	return EXIT_SUCCESS;
 }
 
 /**
-* @brief charge les caractères sur lignes et colonnes de la partie
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param fichier type : entier, entrée, fichier de la partie chargée
-* @return résultat : chargement de la partie
+* @brief charge le plateau de la partie, de taille quelconque, dans l'arène
+	de la partie et compte les caisses qui ne sont pas sur une cible
+* @param jeu type : structure, entrée/sortie, partie à charger
+* @param fichier type : entier, entrée, fichier de la partie chargée (ou
+	recueil.xsb#N, voir paquet.h)
+* @return résultat : vrai si la partie a été chargée, faux si fichier absent
 */
 
-void chargerPartie(t_plateau plateau, char fichier[]){
-    FILE * f;
-    char finDeLigne;
-	int TAILLE = 12;
+bool chargerPartie(t_partie *jeu, char fichier[]){
+	uint64_t debut = cpt_maintenant();
 
-    f = fopen(fichier, "r");
-    if (f==NULL){
-        printf("ERREUR SUR FICHIER");
-        exit(EXIT_FAILURE);
-    } else {
-        for (int ligne=0 ; ligne<TAILLE ; ligne++){
-            for (int colonne=0 ; colonne<TAILLE ; colonne++){
-                fread(&plateau[ligne][colonne], sizeof(char), 1, f);
-            }
-            fread(&finDeLigne, sizeof(char), 1, f);
-        }
-        fclose(f);
-    }
+	arene_vider(jeu->arene);
+	if (!paquet_charger(jeu->paquet, fichier, jeu->arene, &jeu->plateau, &jeu->hauteur, &jeu->largeur)){
+		return false;
+	}
+	// cases d'où une caisse ne peut plus atteindre de cible, numérotées comme
+	// le plateau de bits pour que rejouer_bits les lise directement
+	jeu->mortes = arene_allouer(jeu->arene, (size_t)jeu->hauteur * (jeu->largeur + 1) * sizeof(bool));
+	if (jeu->mortes == NULL ||
+		!impasse_cases_mortes(jeu->plateau, jeu->hauteur, jeu->largeur, jeu->largeur + 1, jeu->mortes)) {
+		return false;
+	}
+	jeu->empreinte = bin_empreinte(jeu->plateau, jeu->hauteur, jeu->largeur);
+	jeu->nbCaisses = 0;
+	for (int lig=0; lig < jeu->hauteur; lig++) {
+		for (int col=0; col < jeu->largeur; col++) {
+			if (jeu->plateau[lig][col] == CAISSE) {
+				jeu->nbCaisses++;
+			}
+		}
+	}
+	cpt_fin(CPT_NIVEAUX, debut);
+	return true;
 }
 
 /**
-* @brief charge les caractères sur lignes et colonnes de la partie
-* @param t type : tableau, entrée/sortie, importe le tableau des déplacements
+* @brief code l'état d'une partie (caisses et joueur) en codage->octets
+* octets, voir etat.h
+* @param jeu type : structure, entrée, partie en cours
+* @param codage type : structure, entrée/sortie, codage préparé par etat_init
+* @param coin type : booléen, entrée, ramener le joueur au coin de sa zone
+* @param etat type : tableau, sortie, état codé
+* @return résultat : faux si la partie n'a pas les caisses du codage
+*/
+
+bool coder_partie(t_partie *jeu, t_codage *codage, bool coin, unsigned char etat[]){
+	return etat_depuis_plateau(codage, jeu->plateau, jeu->posx, jeu->posy, coin, etat);
+}
+
+/**
+* @brief remet une partie dans un état codé par coder_partie
+* @param jeu type : structure, entrée/sortie, partie du même niveau
+* @param codage type : structure, entrée, codage préparé par etat_init
+* @param etat type : tableau, entrée, état codé
+* @return résultat : faux si la mémoire manque
+*/
+
+bool decoder_partie(t_partie *jeu, const t_codage *codage, const unsigned char etat[]){
+	int restantes = etat_vers_plateau(codage, etat, jeu->plateau, &jeu->posx, &jeu->posy);
+
+	if (restantes < 0) {
+		return false;
+	}
+	jeu->nbCaisses = restantes;
+	return true;
+}
+
+/**
+* @brief charge tous les caractères du fichier des déplacements, texte (.dep)
+	ou binaire (voir binaire.h)
+* @param t type : structure, entrée/sortie, historique vidé puis rempli
 * @param fichier type : chaine, entrée, fichier des déplacements 
 * @param nb type : entier, entrée/sortie, nombre de caractères chargés
-* @return résultat : chargement du fichier des caractères
+* @param empreinte type : entier, entrée, empreinte du niveau chargé
+* @return résultat : vrai si le fichier a été lu, faux si fichier absent,
+	mémoire insuffisante ou fichier binaire d'un autre niveau
 */
 
-void chargerDeplacements(typeDeplacements t, char fichier[], int * nb){
+bool chargerDeplacements(t_historique *t, char fichier[], int * nb, uint64_t empreinte){
     FILE * f;
-    char dep;
+    bool lu;
+    uint64_t niveau; // empreinte lue dans un fichier binaire
+    uint64_t debut = cpt_maintenant();
     *nb = 0;
 
+    if (bin_charger(t, fichier, &niveau)) {
+        *nb = t->nb;
+        cpt_fin(CPT_FICHIERS_DEP, debut);
+        return niveau == 0 || niveau == empreinte;
+    }
     f = fopen(fichier, "r");
     if (f==NULL){
-        printf("FICHIER NON TROUVE\n");
-    } else {
-        fread(&dep, sizeof(char), 1, f);
-        if (feof(f)){
-            printf("FICHIER VIDE\n");
-        } else {
-            while (!feof(f)){
-                t[*nb] = dep;
-                (*nb)++;
-                fread(&dep, sizeof(char), 1, f);
-            }
-        }
+        return false;
     }
+    hist_vider(t);
+    lu = hist_lire_fichier(t, f); // lecture par morceaux entiers
     fclose(f);
+    *nb = t->nb;
+    cpt_fin(CPT_FICHIERS_DEP, debut);
+    return lu;
 }
 
 /**
 * @brief enregistre les caractères de chaque ligne et colonne de la partie
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
+* @param jeu type : structure, entrée, partie à enregistrer
 * @param fichier type : entier, entrée, fichier de la partie chargée
 * @return résultat : affichage du plateau
 */
 
-void enregistrerPartie(t_plateau plateau, char fichier[]){
+void enregistrerPartie(t_partie *jeu, char fichier[]){
     FILE * f;
     char finDeLigne='\n';
-	int TAILLE = 12;
-
 
     f = fopen(fichier, "w");
-    for (int ligne=0 ; ligne<TAILLE ; ligne++){
-        for (int colonne=0 ; colonne<TAILLE ; colonne++){
-            fwrite(&plateau[ligne][colonne], sizeof(char), 1, f);
-        }
+    for (int ligne=0 ; ligne<jeu->hauteur ; ligne++){
+        fwrite(jeu->plateau[ligne], sizeof(char), jeu->largeur, f);
         fwrite(&finDeLigne, sizeof(char), 1, f);
     }
     fclose(f);
@@ -222,19 +538,22 @@ void afficher_entete(t_partie *jeu, char fichier[], char deplacements[]){
         jeu->animation = 1;
     }
 
-	system("clear");
-	printf(" Nom de la partie : %s\n\n", fichier);
-	printf(" Nom du fichier de déplacements : %s\n\n", deplacements);
-	printf(" Nombre de déplacement : %d\n\n", jeu->nbDep);
+	ecran_debut(&jeu->ecran); // l'image est envoyée par afficher_plateau
+	ecran_printf(&jeu->ecran, " Nom de la partie : %s\n\n", fichier);
+	ecran_printf(&jeu->ecran, " Nom du fichier de déplacements : %s\n\n", deplacements);
+	ecran_printf(&jeu->ecran, " Nombre de déplacement : %d / %d (saut en %.1f us)\n\n",
+		jeu->nbDep, jeu->reprises.fin, jeu->reprises.dureeSaut);
+	ecran_printf(&jeu->ecran, " Lecture/pause : espace, coup suivant/précédent : d/q\n");
+	ecran_printf(&jeu->ecran, " Saut de 10 %% : s/z, début/fin : a/e, quitter : x\n\n");
 
 	if (jeu->animation == 1){
-		printf(" Analyse en cours.\n\n");
+		ecran_printf(&jeu->ecran, " Analyse en cours.\n\n");
 	} 
 	else if (jeu->animation == 2){
-		printf(" Analyse en cours..\n\n");
+		ecran_printf(&jeu->ecran, " Analyse en cours..\n\n");
 	}
 	else if (jeu->animation == 3){
-		printf(" Analyse en cours...\n\n");
+		ecran_printf(&jeu->ecran, " Analyse en cours...\n\n");
 	}
 	jeu->animation++;
 }
@@ -247,22 +566,26 @@ void afficher_entete(t_partie *jeu, char fichier[], char deplacements[]){
 
 void afficher_plateau(t_partie *jeu) {
 	char caractere;
-	for (int lig=0; lig < MAXLIG; lig++) {
-		for (int col=0; col < MAXLIG; col++) {
+	for (int lig=0; lig < jeu->hauteur; lig++) {
+		for (int col=0; col < jeu->largeur; col++) {
 			caractere = jeu->plateau[lig][col];
 			// pour afficher correctement le joueur et la caisse sur cible 
 			if (caractere == JOUEUR_CIBLE) {
-				printf("%c", JOUEUR);
+				ecran_car(&jeu->ecran, JOUEUR);
 			}
 			else if (caractere == CAISSE_CIBLE) {
-				printf("%c", CAISSE);
+				ecran_car(&jeu->ecran, CAISSE);
 			}
 			else{
-				printf("%c", caractere);
+				ecran_car(&jeu->ecran, caractere);
 			}
 		}
-		printf("\n");
+		ecran_car(&jeu->ecran, '\n');
 	}
+	ecran_afficher(&jeu->ecran); // seules les cases changées sont envoyées
+	cpt_ajouter(CPT_IMAGES, 1);
+	cpt_duree(CPT_IMAGES, (uint64_t)(jeu->ecran.duree * 1e3));
+	cpt_ajouter(CPT_OCTETS, jeu->ecran.nbSortie);
 }
 
 /**
@@ -274,8 +597,8 @@ void afficher_plateau(t_partie *jeu) {
 */
 
 void chercher_joueur(t_partie *jeu){
-	for (int lig=0; lig < MAXLIG; lig++) {
-		for (int col=0; col < MAXLIG; col++) {
+	for (int lig=0; lig < jeu->hauteur; lig++) {
+		for (int col=0; col < jeu->largeur; col++) {
 			// si on trouve le joueur
 			if ((jeu->plateau[lig][col] == JOUEUR) ||
 				 (jeu->plateau[lig][col] == JOUEUR_CIBLE)) {
@@ -286,6 +609,18 @@ void chercher_joueur(t_partie *jeu){
 	}
 }
 
+/**
+* @brief vérifie qu'une case est dans le plateau
+* @param jeu type : structure, entrée, partie en cours
+* @param lig type : entier, entrée, ligne de la case
+* @param col type : entier, entrée, colonne de la case
+* @return résultat : vrai si la case existe (les autres comptent comme des murs)
+*/
+
+bool dans_plateau(t_partie *jeu, int lig, int col){
+	return lig >= 0 && lig < jeu->hauteur && col >= 0 && col < jeu->largeur;
+}
+
 /**
 * @brief introduit les conditions de déplacement de la caisse
 * @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
@@ -299,15 +634,16 @@ void chercher_joueur(t_partie *jeu){
 	ou position de la caisse
 * @param nbDep type : entier, entrée/sortie, nombre de déplacements effectués
 * @param last type : caractère, entrée, dernier caractère de déplacement
-* @return résultat : déplacement ou non dans le plateau
+* @return résultat : DEP_SIMPLE, DEP_POUSSEE ou DEP_ILLEGAL si bloqué
 */
 
-void conditions_dep(t_partie *jeu, int depx, int depy, char last){
+int conditions_dep(t_partie *jeu, int depx, int depy, char last){
 	
 	int casx; // case de destination de la caisse
 	int casy; 
+	int statut = DEP_ILLEGAL; // statut du déplacement
 
-	if (jeu->plateau[depx][depy] != MUR) {
+	if (dans_plateau(jeu, depx, depy) && jeu->plateau[depx][depy] != MUR) {
 
 		if (last == CAISSE_HAUT ||
 			last == CAISSE_BAS ||
@@ -318,171 +654,122 @@ void conditions_dep(t_partie *jeu, int depx, int depy, char last){
 			casx = depx + (depx - jeu->posx);
 			casy = depy + (depy - jeu->posy);
 			// colision avec un mur ou une autre caisse
-			if ((jeu->plateau[casx][casy] != MUR) && 
-				(jeu->plateau[casx][casy] != CAISSE) && 
-				(jeu->plateau[casx][casy] != CAISSE_CIBLE)) {
-				deplacer_caisse(jeu, depx, depy, casx, casy);
-				deplacer_joueur(jeu, depx, depy);
+			if (dans_plateau(jeu, casx, casy) &&
+				trans_accueille(jeu->plateau[casx][casy])) {
+				trans_caisse(jeu->plateau, depx, depy, casx, casy, &jeu->nbCaisses);
+				trans_joueur(jeu->plateau, &jeu->posx, &jeu->posy, depx, depy);
+				statut = DEP_POUSSEE;
 			}
 		}
 		// Uniquement les déplacements du joueur
 		else {
-			deplacer_joueur(jeu, depx, depy);
+			trans_joueur(jeu->plateau, &jeu->posx, &jeu->posy, depx, depy);
+			statut = DEP_SIMPLE;
 		}
 	}
+	return statut;
 }
 
 /**
-* @brief introduit les conditions de déplacement du joueur
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param depx type : entier, entrée, case de déplacement horizontale joueur
-* @param depy type : entier, entrée, case de déplacement verticale joueur
-* @param casx type : entier, entrée/sortie, case de déplacement horizontale caisse
-* @param casy type : entier, entrée/sortie, case de déplacement verticale caisse
-* @return résultat : le joueur peut/peut pas se déplacer
+* @brief annule le dernier coup qui a changé le plateau (voir journal.h) :
+* plusieurs 'u' de suite reviennent d'autant de coups en arrière
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @return résultat : faux s'il n'y a plus de coup à annuler
 */
 
-void deplacer_joueur(t_partie *jeu, int depx, int depy){
-	// si le joueur est déplacé depuis une cible
-	if (jeu->plateau[jeu->posx][jeu->posy] == JOUEUR_CIBLE) {
-		jeu->plateau[jeu->posx][jeu->posy] = CIBLE;
-	}
-	else {
-		jeu->plateau[jeu->posx][jeu->posy] = CASE;
-	}
-	jeu->posx = depx; // mise à jour de la position du joueur
-	jeu->posy = depy;
-	// si le joueur est déplacé sur une cible
-	if (jeu->plateau[depx][depy] == CIBLE) {
-		jeu->plateau[jeu->posx][jeu->posy] = JOUEUR_CIBLE;
-	}
-	else {
-		jeu->plateau[jeu->posx][jeu->posy] = JOUEUR;
-	}
+bool annuler_deplacer(t_partie *jeu){
+	return jour_annuler(&jeu->journal, jeu->plateau, &jeu->posx, &jeu->posy, &jeu->nbCaisses) != '\0';
 }
 
 /**
-* @brief introduit les conditions de déplacement de la caisse
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param depx type : entier, entrée, case initiale horizontale caisse
-* @param depy type : entier, entrée, case initiale verticale caisse
-* @param casx type : entier, entrée, case de déplacement horizontale caisse
-* @param casy type : entier, entrée, case de déplacement verticale caisse
-* @return résultat : la caisse peut/peut pas se déplacer
+* @brief applique le caractère de déplacement courant, sans affichage
+* @param jeu type : structure, entrée/sortie, partie en cours d'analyse
+* @return résultat : DEP_IGNORE, DEP_ILLEGAL, DEP_SIMPLE, DEP_POUSSEE ou DEP_ANNULE
 */
 
-void deplacer_caisse(t_partie *jeu, int depx, int depy, int casx, int casy){
-	// si la caisse est déplacée depuis une cible
-	if (jeu->plateau[depx][depy] == CAISSE_CIBLE) {
-		jeu->plateau[depx][depy] = CIBLE;
-	// si la caisse sur cible est déplacée sur une cible
-		if (jeu->plateau[casx][casy] == CIBLE) {
-			jeu->plateau[casx][casy] = CAISSE_CIBLE; 
-			}
-		else {
-			jeu->plateau[casx][casy] = CAISSE; 
-		}
-	}
-	// si la caisse est déplacée sur une cible
-	else if (jeu->plateau[casx][casy] == CIBLE) {
-		jeu->plateau[casx][casy] = CAISSE_CIBLE; 
-	}
-	else {
-		jeu->plateau[casx][casy] = CAISSE; 
-	}
+int appliquer_deplacement(t_partie *jeu){
+	return jouer_coup(jeu, hist_lire(&jeu->historiqueDep, jeu->nbDep));
 }
 
 /**
-* @brief cette procédure permet d'annuler les déplacements précédents
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param posx type : entier, entrée/sortie, position verticale du joueur
-* @param posy type : entier, entrée/sortie, position horizontale du joueur
-* @param last type : caractère, entrée, stocke le caractère de déplacement
-* @return résultat : retourne le perso et/ou caisse sur l'ancien deplacement
+* @brief fonctions de lecture du plateau de caractères pour le test de gel,
+* cases numérotées lig * (largeur + 1) + col comme jeu->mortes (la colonne
+* largeur compte comme un mur)
+* @param partie type : structure, entrée, partie en cours (t_partie)
+* @param c type : entier, entrée, indice de la case
+* @return résultat : vrai si la case est un mur, porte une caisse ou est une cible
 */
 
-void annuler_deplacer(t_partie *jeu, char last){
+bool car_lire_mur(const void *partie, int c){
+	const t_partie *jeu = partie;
+	int col = c % (jeu->largeur + 1);
 
-	int depx = jeu->posx; // case de déplacement horizontale
-	int depy = jeu->posy; // case de déplacement verticale
-	int casx; // case de déplacement de la caisse
-	int casy; 
-	int ancienx; // ancienne case de la caisse
-	int ancieny; 
-	int undoCase = 0; // case précédente
-	int retour = 1; // retour du dernier déplacement
+	return col == jeu->largeur || jeu->plateau[c / (jeu->largeur + 1)][col] == MUR;
+}
 
-	// tant que le caractère correspond à un retour
-	while(last == 'u'){
-		undoCase++; // observation du caractère précédent
-		last = jeu->historiqueDep[jeu->nbDep-undoCase]; // stocke le caractère précédent
-		if (last == 'u'){ // si la case précédente est toujours un retour
-			retour = retour + 2; // dernier déplacement potentiel
-		}
-	}
+bool car_lire_caisse(const void *partie, int c){
+	const t_partie *jeu = partie;
+	int col = c % (jeu->largeur + 1);
 
-	// incrémentation du dernier déplacement effectué
-	last = jeu->historiqueDep[jeu->nbDep-retour];
+	return col < jeu->largeur && trans_est_caisse(jeu->plateau[c / (jeu->largeur + 1)][col]);
+}
 
-	if (last == DEP_HAUT || last == CAISSE_HAUT) {
-		depx++; // déplacement vers le Haut
-	}
-	else if (last == DEP_BAS || last == CAISSE_BAS) {
-		depx--; // déplacement vers le Bas
-	}
-	else if (last == DEP_GAUCHE || last == CAISSE_GAUCHE) {
-		depy++; // déplacement à Droite
-	}
-	else if (last == DEP_DROITE || last == CAISSE_DROITE) {
-		depy--; // déplacement à Gauche
-	}
-	// la case de destination de la caisse correspond a l'ancienne du personnage
-	casx = jeu->posx;
-	casy = jeu->posy;
-	// changement de position du caractère
-	if (jeu->plateau[depx][depy] != MUR){
-	deplacer_joueur(jeu, depx, depy);
-	}
-	// si les anciens déplacements correspondent à celui d'une caisse
-	if (last == CAISSE_HAUT || last == CAISSE_BAS ||
-		last == CAISSE_GAUCHE || last == CAISSE_DROITE) {
-		// ancienne position de la caisse
-		ancienx = casx + (casx - jeu->posx);
-		ancieny = casy + (casy - jeu->posy);
-		// si ancienne position de la caisse = cible
-		if (jeu->plateau[ancienx][ancieny] == CAISSE_CIBLE) {
-			jeu->plateau[ancienx][ancieny] = CIBLE;
-		}
-		else {
-			jeu->plateau[ancienx][ancieny] = CASE;
-		}
-		//déplacement de la caisse
-		deplacer_caisse(jeu, ancienx, ancieny, casx, casy);
+bool car_lire_cible(const void *partie, int c){
+	const t_partie *jeu = partie;
+	int col = c % (jeu->largeur + 1);
+	char car;
+
+	if (col == jeu->largeur) {
+		return false;
 	}
+	car = jeu->plateau[c / (jeu->largeur + 1)][col];
+	return car == CIBLE || car == JOUEUR_CIBLE || car == CAISSE_CIBLE;
 }
 
 /**
-* @brief cette procédure contient les touches et conditions pour Analyse.
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
-* @param historiqueDep type : tableau, entrée/sortie, importe le 
-	tableau des déplacements
-* @param posx type : entier, entrée/sortie, position verticale du joueur
-* @param posy type : entier, entrée/sortie, position horizontale du joueur
-* @param nbDep type : entier, entrée/sortie, nombre de déplacements
-* @param fichier type : chaine, entrée, fichier de sauvegarde
-* @return résultat : permet de Analyse au jeu
+* @brief teste si la caisse qui vient d'arriver sur une case est dans une
+* impasse : case morte ou caisse gelée hors cible (voir impasses.h), le même
+* test que rejouer_bits sur le plateau de bits
+* @param jeu type : structure, entrée, partie en cours, cases mortes calculées
+* @param lig type : entier, entrée, ligne de la caisse
+* @param col type : entier, entrée, colonne de la caisse
+* @return résultat : vrai si la partie ne peut plus être gagnée sans retour
 */
 
-void Analyse(t_partie *jeu, char fichier[], char deplacements[]){
+bool poussee_impasse(t_partie *jeu, int lig, int col){
+	t_gel gel;
+	int c = lig * (jeu->largeur + 1) + col;
+
+	gel.pas = jeu->largeur + 1;
+	gel.nbCases = jeu->hauteur * gel.pas;
+	gel.mortes = jeu->mortes;
+	gel.mur = car_lire_mur;
+	gel.caisse = car_lire_caisse;
+	gel.cible = car_lire_cible;
+	gel.plateau = jeu;
+	return jeu->mortes[c] || impasse_gel(&gel, c);
+}
+
+/**
+* @brief applique un caractère de déplacement, sans affichage. Après une
+* poussée, jeu->impasse indique si la caisse est dans une impasse.
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @param coup type : caractère, entrée, déplacement (g d h b, G D H B ou u)
+* @return résultat : DEP_IGNORE, DEP_ILLEGAL, DEP_SIMPLE, DEP_POUSSEE ou DEP_ANNULE
+*/
 
+int jouer_coup(t_partie *jeu, char coup){
 
 	char last; // caractère des déplacements du joueur
 	int depx = jeu->posx;  // case de déplacement du joueur
 	int depy = jeu->posy;
+	int statut = DEP_IGNORE; // statut du déplacement
+	int casx; // case où une caisse poussée arrive
+	int casy;
+	t_delta *delta; // cases que le coup peut changer
 
-	// scan du caractère du tableau des déplacements
-	last = jeu->historiqueDep[jeu->nbDep];
-	last = tolower(last); // conversion en minuscule
+	jeu->impasse = false;
+	last = tolower(coup); // conversion en minuscule
 	// déplacement selon le caractère scanné
 		switch (last) {
 			case 'h' :
@@ -498,7 +785,8 @@ void Analyse(t_partie *jeu, char fichier[], char deplacements[]){
 				depy++; // déplacement à Gauche
 				break;
 			case 'u' :
-				annuler_deplacer(jeu, last); 
+				// rien à annuler : le retour est compté comme un coup illégal
+				statut = annuler_deplacer(jeu) ? DEP_ANNULE : DEP_ILLEGAL;
 				break;
 			default:
 				break;
@@ -509,39 +797,1718 @@ void Analyse(t_partie *jeu, char fichier[], char deplacements[]){
 		if (last == 'd' || last == 'b' ||
 			last == 'h' || last == 'g'){
 			// si la case de déplacement correspond à une caisse ou une caisse sur cible
-			if (jeu->plateau[depx][depy] == CAISSE ||
-				jeu->plateau[depx][depy] == CAISSE_CIBLE) {
+			if (dans_plateau(jeu, depx, depy) && trans_est_caisse(jeu->plateau[depx][depy])) {
 				last = toupper(last); // conversion en majuscule
 			}
-			conditions_dep(jeu, depx, depy, last);
+			// le joueur, la case visée et celle d'après, pour une annulation
+			casx = 2 * depx - jeu->posx;
+			casy = 2 * depy - jeu->posy;
+			delta = jour_ouvrir(&jeu->journal, jeu->posx, jeu->posy, jeu->nbCaisses);
+			if (delta != NULL) {
+				jour_noter(delta, jeu->plateau, jeu->posx, jeu->posy);
+				if (dans_plateau(jeu, depx, depy)) {
+					jour_noter(delta, jeu->plateau, depx, depy);
+				}
+				if (dans_plateau(jeu, casx, casy)) {
+					jour_noter(delta, jeu->plateau, casx, casy);
+				}
 			}
+			statut = conditions_dep(jeu, depx, depy, last);
+			if (delta != NULL) {
+				jour_fermer(&jeu->journal, jeu->plateau, jeu->posx, jeu->posy, jeu->nbCaisses, last);
+			}
+			// cases mortes absentes : plateau construit sans chargerPartie
+			jeu->impasse = statut == DEP_POUSSEE && jeu->mortes != NULL && poussee_impasse(jeu, casx, casy);
+			}
+	if (statut == DEP_SIMPLE || statut == DEP_POUSSEE) {
+		cpt_ajouter(CPT_COUPS, 1);
+		if (statut == DEP_POUSSEE) {
+			cpt_ajouter(CPT_POUSSEES, 1);
+		}
+	}
+	else if (statut == DEP_ANNULE) {
+		cpt_ajouter(CPT_ANNULATIONS, 1);
+	}
+	return statut;
+}
+
+/**
+* @brief applique une suite de coups d'un bloc (fichier .dep, solveur,
+* macro), sans affichage ni pause. La suite s'arrête au premier coup
+* illégal, qui n'est pas compté dans les caractères appliqués, ou dès que
+* la partie est gagnée.
+* @param jeu type : structure, entrée/sortie, partie en cours, état final en sortie
+* @param coups type : tableau, entrée, caractères de déplacement
+* @param nb type : entier, entrée, nombre de caractères
+* @param bilan type : structure, sortie, caractères appliqués, coups,
+	poussées, annulations, indices du coup illégal et de la première poussée
+	vers une impasse (-1 si aucun)
+* @return résultat : nombre de caractères appliqués
+*/
+
+int appliquer_coups(t_partie *jeu, const char coups[], int nb, t_bilan *bilan){
+	uint64_t debut = cpt_maintenant();
+	int statut; // statut du dernier coup
+	int i;
+
+	trans_bilan_init(bilan);
+	for (i = 0; i < nb && !gagner(jeu); i++) {
+		statut = jouer_coup(jeu, coups[i]);
+		if (statut == DEP_ILLEGAL) {
+			bilan->illegal = i;
+			break;
+		}
+		bilan->nbCoups += (statut == DEP_SIMPLE || statut == DEP_POUSSEE);
+		bilan->nbPoussees += (statut == DEP_POUSSEE);
+		bilan->nbAnnulations += (statut == DEP_ANNULE);
+		if (jeu->impasse && bilan->impasse < 0) {
+			bilan->impasse = i;
+		}
+	}
+	cpt_ajouter(CPT_GAGNER, i < nb ? i + 1 : i); // un test par tour, comptés d'un bloc
+	cpt_duree(CPT_GAGNER, cpt_maintenant() - debut); // la boucle entière, tests compris
+	bilan->nbLus = i;
+	return i;
+}
+
+/**
+* @brief rejoue les déplacements de l'historique depuis jeu->nbDep, par
+* morceaux appliqués d'un bloc : un coup illégal arrête le bloc, il est
+* noté, sauté, puis la suite reprend (comme dans l'analyse animée)
+* @param jeu type : structure, entrée/sortie, partie en cours
+* @param fin type : entier, entrée, indice où s'arrêter
+* @param bilan type : structure, sortie, bilan cumulé (illegal et impasse : les premiers)
+* @return résultat : jeu->nbDep à fin, ou à la victoire
+*/
+
+void rejouer_historique(t_partie *jeu, int fin, t_bilan *bilan){
+	t_bilan morceau; // bilan d'un bloc
+	const char *coups;
+	int nb;
+
+	trans_bilan_init(bilan);
+	while (jeu->nbDep < fin && !gagner(jeu)) {
+		coups = hist_suite(&jeu->historiqueDep, jeu->nbDep, &nb);
+		if (coups == NULL) {
+			// après la fin de l'historique, les caractères sont ignorés
+			bilan->nbLus += fin - jeu->nbDep;
+			jeu->nbDep = fin;
+			break;
+		}
+		if (nb > fin - jeu->nbDep) {
+			nb = fin - jeu->nbDep;
+		}
+		appliquer_coups(jeu, coups, nb, &morceau);
+		if (morceau.impasse >= 0 && bilan->impasse < 0) {
+			bilan->impasse = jeu->nbDep + morceau.impasse;
+		}
+		bilan->nbCoups += morceau.nbCoups;
+		bilan->nbPoussees += morceau.nbPoussees;
+		bilan->nbAnnulations += morceau.nbAnnulations;
+		jeu->nbDep += morceau.nbLus;
+		bilan->nbLus += morceau.nbLus;
+		if (morceau.illegal >= 0) {
+			if (bilan->illegal < 0) {
+				bilan->illegal = jeu->nbDep;
+			}
+			jeu->nbDep++;
+			bilan->nbLus++;
+		}
+	}
+}
+
+/**
+* @brief cette procédure contient les touches et conditions pour Analyse.
+* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
+* @param historiqueDep type : tableau, entrée/sortie, importe le 
+	tableau des déplacements
+* @param posx type : entier, entrée/sortie, position verticale du joueur
+* @param posy type : entier, entrée/sortie, position horizontale du joueur
+* @param nbDep type : entier, entrée/sortie, nombre de déplacements
+* @param fichier type : chaine, entrée, fichier de sauvegarde
+* @return résultat : permet de Analyse au jeu
+*/
+
+void Analyse(t_partie *jeu, char fichier[], char deplacements[]){
+
+		appliquer_deplacement(jeu);
 		
-		
-		system("clear");
 		afficher_entete(jeu, fichier, deplacements);
 		afficher_plateau(jeu);
 }
 
+/**
+* @brief garde un coup du journal d'un point de reprise, défait par une
+* annulation avant le point suivant
+* @param r type : structure, entrée/sortie, points de reprise
+* @param delta type : structure, entrée, coup du journal
+* @return résultat : faux si la mémoire manque
+*/
+
+bool garder_annule(t_reprises *r, const t_delta *delta){
+	t_delta *agrandi;
+
+	if (r->nbAnnules == r->capaciteAnnules) {
+		r->capaciteAnnules = r->capaciteAnnules ? 2 * r->capaciteAnnules : 64;
+		agrandi = realloc(r->annules, r->capaciteAnnules * sizeof(t_delta));
+		if (agrandi == NULL) {
+			return false;
+		}
+		r->annules = agrandi;
+	}
+	r->annules[r->nbAnnules++] = *delta;
+	return true;
+}
+
+/**
+* @brief remet dans l'ordre du journal les coups gardés pour le dernier point
+* de reprise, notés du dernier défait au plus ancien
+* @param r type : structure, entrée/sortie, points de reprise
+* @return résultat : coups du dernier point du plus ancien au plus récent
+*/
+
+void ordonner_annules(t_reprises *r){
+	t_delta echange;
+
+	for (int i = r->premiers[r->nb - 1], k = r->nbAnnules - 1; i < k; i++, k--) {
+		echange = r->annules[i];
+		r->annules[i] = r->annules[k];
+		r->annules[k] = echange;
+	}
+}
 
 /**
-* @brief vérifie si il n'y a plus de caisses à déplacer sur les cibles
-* @param plateau type : tableau, entrée/sortie, importe le tableau de jeu
+* @brief rejoue tous les déplacements sans affichage et code le plateau tous
+* les REPRISE_PAS coups, puis revient au coup 0. Pour chaque point de
+* reprise, les coups du journal que les annulations 'u' jusqu'au point
+* suivant défont sont gardés : un saut recharge le plateau et ces coups, et
+* ne rejoue jamais plus de REPRISE_PAS coups. Une annulation en défait un au
+* plus, il n'y en a donc pas plus que de 'u' dans le fichier.
+* @param jeu type : structure, entrée/sortie, partie chargée, au coup 0
+* @param maxTaille type : entier, entrée, nombre de caractères de déplacement
+* @return résultat : faux si la mémoire manque
+*/
+
+bool preparer_reprises(t_partie *jeu, int maxTaille){
+	t_reprises *r = &jeu->reprises;
+	int bas = 0; // plus petite profondeur du journal depuis le dernier point
+	uint64_t debut;
+
+	memset(r, 0, sizeof(t_reprises));
+	jour_vider(&jeu->journal);
+	if (!etat_init(&r->codage, jeu->plateau, jeu->hauteur, jeu->largeur)) {
+		return false;
+	}
+	r->etats = malloc(((size_t)maxTaille / REPRISE_PAS + 1) * r->codage.octets + 1);
+	r->premiers = malloc(((size_t)maxTaille / REPRISE_PAS + 2) * sizeof(int));
+	if (r->etats == NULL || r->premiers == NULL) {
+		return false;
+	}
+	debut = cpt_maintenant();
+	for (jeu->nbDep = 0; ; jeu->nbDep++) {
+		if (jeu->nbDep % REPRISE_PAS == 0) {
+			if (r->nb > 0) {
+				ordonner_annules(r);
+			}
+			if (!coder_partie(jeu, &r->codage, false, &r->etats[(size_t)r->nb * r->codage.octets])) {
+				return false;
+			}
+			r->premiers[r->nb++] = r->nbAnnules;
+			bas = jeu->journal.courant;
+		}
+		if (jeu->nbDep >= maxTaille || gagner(jeu)) {
+			break;
+		}
+		appliquer_deplacement(jeu);
+		// un coup d'avant le point est défait : il est encore dans le journal
+		if (jeu->journal.courant < bas) {
+			bas = jeu->journal.courant;
+			if (!garder_annule(r, &jeu->journal.deltas[bas])) {
+				return false;
+			}
+		}
+	}
+	ordonner_annules(r);
+	cpt_ajouter(CPT_GAGNER, jeu->nbDep + 1); // un test par tour, comptés d'un bloc
+	cpt_duree(CPT_GAGNER, cpt_maintenant() - debut); // la boucle entière, tests compris
+	r->premiers[r->nb] = r->nbAnnules;
+	r->fin = jeu->nbDep;
+	r->gagne = gagner(jeu);
+	aller_au_coup(jeu, 0);
+	return true;
+}
+
+/**
+* @brief remet la partie au coup demandé : point de reprise le plus proche
+* avant lui, puis au plus REPRISE_PAS - 1 coups rejoués
+* @param jeu type : structure, entrée/sortie, partie préparée par preparer_reprises
+* @param coup type : entier, entrée, coup entre 0 et jeu->reprises.fin
+* @return résultat : plateau, joueur et nbDep au coup demandé
+*/
+
+void aller_au_coup(t_partie *jeu, int coup){
+	t_reprises *r = &jeu->reprises;
+	double debut = temps_us();
+	int k = coup / REPRISE_PAS;
+	t_bilan bilan; // coups rejoués depuis le point de reprise
+
+	// vers l'avant depuis la position courante si elle est dans le même
+	// tronçon : le journal suffit jusqu'au point suivant
+	if (coup < jeu->nbDep || k * REPRISE_PAS > jeu->nbDep) {
+		decoder_partie(jeu, &r->codage, &r->etats[(size_t)k * r->codage.octets]);
+		// le journal a déjà la place : le rejeu complet l'a agrandi
+		jour_charger(&jeu->journal, &r->annules[r->premiers[k]], r->premiers[k + 1] - r->premiers[k]);
+		jeu->nbDep = k * REPRISE_PAS;
+	}
+	rejouer_historique(jeu, coup, &bilan);
+	r->dureeSaut = temps_us() - debut;
+}
+
+/**
+* @brief libère les points de reprise
+* @param jeu type : structure, entrée/sortie, partie
+* @return résultat : mémoire libérée
+*/
+
+void liberer_reprises(t_partie *jeu){
+	etat_liberer(&jeu->reprises.codage);
+	free(jeu->reprises.etats);
+	free(jeu->reprises.annules);
+	free(jeu->reprises.premiers);
+	jeu->reprises.etats = NULL;
+	jeu->reprises.annules = NULL;
+	jeu->reprises.premiers = NULL;
+}
+
+
+/**
+* @brief vérifie si il n'y a plus de caisses à déplacer sur les cibles. Le
+* nombre de caisses restantes est tenu à jour à chaque déplacement.
+* @param jeu type : structure, entrée, partie en cours
 * @return résultat : retourne le statut de la partie (fini/non fini)
 */
 
 bool gagner (t_partie *jeu) {
-	bool win = false; // statut de la partie
-	int nbCaisses = 0;
-	// compte le nombre de caisses restantes
-	for (int lig=0; lig < MAXLIG; lig++) {
-		for (int col=0; col < MAXLIG; col++) {
-			if (jeu->plateau[lig][col] == CAISSE) {
-				nbCaisses++;
-			}
+	return jeu->nbCaisses == 0; // toutes les caisses sont sur les cibles
+}
+
+/**
+* @brief donne l'heure courante d'une horloge monotone
+* @return résultat : temps en microsecondes
+*/
+
+double temps_us(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+/**
+* @brief rejoue un fichier de déplacements sur un niveau, sans affichage
+* ni pause, en suivant les mêmes règles que l'analyse animée.
+* @param fichier type : chaine, entrée, fichier de la partie
+* @param deplacements type : chaine, entrée, fichier des déplacements
+* @param res type : structure, sortie, résultat de l'analyse
+* @param arene type : structure, entrée/sortie, mémoire du plateau (une par thread)
+* @param paquet type : structure, entrée/sortie, dernier recueil ouvert (un par thread)
+* @return résultat : faux si un des deux fichiers n'a pas pu être lu ou si la
+* mémoire du rejeu manque
+*/
+
+bool analyser_couple(char fichier[], char deplacements[], t_resultat *res, t_arene *arene, t_paquet *paquet){
+	t_partie jeu;
+	int maxTaille; // nombre de caractères dans le tableau des déplacements
+	t_bilan bilan; // bilan du rejeu
+	double debut = temps_us();
+
+	jeu.posx = 0;
+	jeu.posy = 0;
+	jeu.nbDep = 0;
+	jeu.animation = 1;
+	jeu.arene = arene;
+	jeu.paquet = paquet;
+	hist_init(&jeu.historiqueDep);
+	jour_init(&jeu.journal);
+	res->valide = false;
+	res->nbCoups = 0;
+	res->nbPoussees = 0;
+	res->nbAnnulations = 0;
+	res->premierIllegal = -1;
+	res->premiereImpasse = -1;
+	res->nbLus = 0;
+	res->duree = 0;
+
+	if (!chargerPartie(&jeu, fichier) ||
+		!chargerDeplacements(&jeu.historiqueDep, deplacements, &maxTaille, jeu.empreinte)) {
+		hist_liberer(&jeu.historiqueDep);
+		return false;
+	}
+	chercher_joueur(&jeu);
+
+	// sans retour en arrière, les plans de bits suffisent
+	if (!hist_contient(&jeu.historiqueDep, RETOUR)) {
+		if (!rejouer_bits(&jeu, maxTaille, res)) {
+			hist_liberer(&jeu.historiqueDep);
+			return false;
 		}
+		hist_liberer(&jeu.historiqueDep);
+		res->duree = temps_us() - debut;
+		cpt_ajouter(CPT_REJEUX, 1);
+		cpt_duree(CPT_REJEUX, (uint64_t)(res->duree * 1e3));
+		return true;
 	}
-	if (nbCaisses == 0) {
-		win = true; // toutes les caisses sont sur les cibles
+
+	// mêmes règles que l'analyse animée, par blocs sans pause ni affichage
+	rejouer_historique(&jeu, maxTaille, &bilan);
+	res->nbCoups = bilan.nbCoups;
+	res->nbPoussees = bilan.nbPoussees;
+	res->nbAnnulations = bilan.nbAnnulations;
+	res->premierIllegal = bilan.illegal;
+	res->premiereImpasse = bilan.impasse;
+
+	res->valide = gagner(&jeu);
+	res->nbLus = jeu.nbDep;
+	hist_liberer(&jeu.historiqueDep);
+	jour_liberer(&jeu.journal);
+	res->duree = temps_us() - debut;
+	cpt_ajouter(CPT_REJEUX, 1);
+	cpt_duree(CPT_REJEUX, (uint64_t)(res->duree * 1e3));
+	return true;
+}
+
+/**
+* @brief fonctions de lecture du plateau de bits pour le test de gel
+* @param plateau type : structure, entrée, plateau de bits (t_plateau_bits)
+* @param c type : entier, entrée, indice de la case
+* @return résultat : vrai si la case est un mur, porte une caisse ou est une cible
+*/
+
+bool bits_lire_mur(const void *plateau, int c){
+	return bits_test(((const t_plateau_bits *)plateau)->murs, c);
+}
+
+bool bits_lire_caisse(const void *plateau, int c){
+	return bits_test(((const t_plateau_bits *)plateau)->caisses, c);
+}
+
+bool bits_lire_cible(const void *plateau, int c){
+	return bits_test(((const t_plateau_bits *)plateau)->cibles, c);
+}
+
+/**
+* @brief rejoue les déplacements sur le plateau de bits (sans retour en arrière).
+* La première poussée qui mène à une impasse (case morte ou caisse gelée hors
+* cible) est notée ; la relecture continue pour compter coups et poussées
+* comme rejouer_historique.
+* @param jeu type : structure, entrée/sortie, partie chargée, plateau final en sortie
+* @param maxTaille type : entier, entrée, nombre de caractères de déplacement
+* @param res type : structure, entrée/sortie, résultat de l'analyse
+* @return résultat : faux si la mémoire du plateau de bits manque (résultat non rempli)
+*/
+
+bool rejouer_bits(t_partie *jeu, int maxTaille, t_resultat *res){
+	t_plateau_bits b;
+	t_gel gel; // test de gel sur le plateau de bits
+	int decalage; // décalage de la case du joueur
+	int statut; // statut du dernier déplacement
+
+	if (!bits_allouer(&b, jeu->hauteur, jeu->largeur, jeu->arene)) {
+		return false;
 	}
-	return win;
-}
\ No newline at end of file
+	bits_depuis_plateau(&b, jeu->plateau);
+	gel.pas = b.pas;
+	gel.nbCases = b.nbCases;
+	gel.mortes = jeu->mortes;
+	gel.mur = bits_lire_mur;
+	gel.caisse = bits_lire_caisse;
+	gel.cible = bits_lire_cible;
+	gel.plateau = &b;
+	while (jeu->nbDep < maxTaille && !bits_gagner(&b)) {
+		decalage = bits_decalage(&b, hist_lire(&jeu->historiqueDep, jeu->nbDep));
+		if (decalage != 0) {
+			statut = bits_deplacer(&b, decalage);
+			if (statut == BITS_BLOQUE) {
+				if (res->premierIllegal < 0) {
+					res->premierIllegal = jeu->nbDep;
+				}
+			}
+			else {
+				res->nbCoups++;
+				res->nbPoussees += (statut == BITS_POUSSEE);
+				if (statut == BITS_POUSSEE && res->premiereImpasse < 0 &&
+					(jeu->mortes[b.joueur + decalage] || impasse_gel(&gel, b.joueur + decalage))) {
+					res->premiereImpasse = jeu->nbDep;
+				}
+			}
+		}
+		jeu->nbDep++;
+	}
+	res->valide = bits_gagner(&b);
+	res->nbLus = jeu->nbDep;
+	// compteurs ajoutés en une fois, pas à chaque coup
+	cpt_ajouter(CPT_COUPS, res->nbCoups);
+	cpt_ajouter(CPT_POUSSEES, res->nbPoussees);
+	bits_vers_plateau(&b, jeu->plateau);
+	jeu->nbCaisses = b.restantes;
+	jeu->posx = b.joueur / b.pas;
+	jeu->posy = b.joueur % b.pas;
+	return true;
+}
+
+/**
+* @brief compare le temps par déplacement du plateau de caractères et du
+* plateau de bits. Les retours 'u' sont retirés pour que les deux moteurs
+* jouent exactement la même suite.
+* Usage : sokoban -bench [niveau.sok niveau.dep ...] (niveau1 à niveau6 par défaut)
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return résultat : EXIT_FAILURE si les deux moteurs ne donnent pas le même plateau
+*/
+
+int banc_essai(int argc, char *argv[]){
+	char *defaut[] = {"niveau1.sok", "niveau1.dep", "niveau2.sok", "niveau2.dep",
+		"niveau3.sok", "niveau3.dep", "niveau4.sok", "niveau4.dep",
+		"niveau5.sok", "niveau5.dep", "niveau6.sok", "niveau6.dep"};
+	char **couples = (argc > 2) ? argv + 2 : defaut;
+	int nbCouples = (argc > 2) ? (argc - 2) / 2 : 6;
+	t_arene arene; // mémoire des plateaux
+	t_paquet paquet; // recueil de niveaux
+	t_partie initial; // partie telle que chargée
+	t_partie jeu; // partie rejouée
+	t_plateau_bits b;
+	t_plateau_bits final; // plateau final du moteur de caractères
+	t_historique brut; // caractères du fichier
+	t_historique coups; // caractères de déplacement conservés
+	int nbBrut;
+	int nbDep; // nombre de déplacements conservés
+	double debut;
+	double tempsCar;
+	double tempsBits;
+	bool identiques = true;
+
+	arene_init(&arene);
+	paquet_init(&paquet);
+	hist_init(&brut);
+	hist_init(&coups);
+	initial.arene = &arene;
+	initial.paquet = &paquet;
+	printf("%-14s %8s %12s %12s %8s\n", "niveau", "coups", "car ns/coup", "bits ns/coup", "gain");
+	for (int c = 0; c < nbCouples; c++) {
+		if (!chargerPartie(&initial, couples[2*c]) ||
+			!chargerDeplacements(&brut, couples[2*c+1], &nbBrut, initial.empreinte)) {
+			printf("%-14s ERREUR fichier illisible\n", couples[2*c]);
+			continue;
+		}
+		// plateaux de travail pris dans l'arène après le plateau chargé
+		jeu = initial;
+		jour_init(&jeu.journal);
+		jeu.plateau = niveau_allouer(&arene, initial.hauteur, initial.largeur);
+		if (jeu.plateau == NULL ||
+			!bits_allouer(&b, initial.hauteur, initial.largeur, &arene) ||
+			!bits_allouer(&final, initial.hauteur, initial.largeur, &arene)) {
+			printf("%-14s ERREUR mémoire insuffisante\n", couples[2*c]);
+			continue;
+		}
+		hist_vider(&coups);
+		for (int i = 0; i < nbBrut; i++) {
+			if (bits_decalage(&b, hist_lire(&brut, i)) != 0) {
+				hist_ajouter(&coups, hist_lire(&brut, i));
+			}
+		}
+		nbDep = coups.nb;
+		initial.historiqueDep = coups;
+		jeu.historiqueDep = coups;
+		initial.nbDep = 0;
+		initial.animation = 1;
+		chercher_joueur(&initial);
+
+		// moteur actuel : plateau de caractères
+		debut = temps_us();
+		for (int r = 0; r < REPETITIONS_BANC; r++) {
+			niveau_copier(jeu.plateau, initial.plateau, initial.hauteur, initial.largeur);
+			jeu.nbCaisses = initial.nbCaisses;
+			jeu.posx = initial.posx;
+			jeu.posy = initial.posy;
+			jour_vider(&jeu.journal);
+			for (jeu.nbDep = 0; jeu.nbDep < nbDep && !gagner(&jeu); jeu.nbDep++) {
+				appliquer_deplacement(&jeu);
+			}
+		}
+		tempsCar = temps_us() - debut;
+		jour_liberer(&jeu.journal);
+
+		// plateau de bits
+		debut = temps_us();
+		for (int r = 0; r < REPETITIONS_BANC; r++) {
+			bits_depuis_plateau(&b, initial.plateau);
+			for (int i = 0; i < nbDep && !bits_gagner(&b); i++) {
+				bits_deplacer(&b, bits_decalage(&b, hist_lire(&coups, i)));
+			}
+		}
+		tempsBits = temps_us() - debut;
+
+		// comparaison sur les plans : les caractères inconnus deviennent des cases vides
+		bits_depuis_plateau(&final, jeu.plateau);
+		if (memcmp(final.caisses, b.caisses, b.nbMots * sizeof(uint64_t)) != 0 ||
+			final.joueur != b.joueur) {
+			identiques = false;
+			printf("%-14s ERREUR les deux moteurs divergent\n", couples[2*c]);
+		}
+		printf("%-14s %8d %12.1f %12.1f %7.1fx\n", couples[2*c], nbDep,
+			tempsCar * 1e3 / ((double)REPETITIONS_BANC * nbDep),
+			tempsBits * 1e3 / ((double)REPETITIONS_BANC * nbDep),
+			tempsCar / tempsBits);
+	}
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	hist_liberer(&brut);
+	hist_liberer(&coups);
+	return identiques ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief mesure les sauts du rejeu pas à pas : préparation des points de
+* reprise puis sauts vers des coups tirés au hasard, comparés à un rejeu
+* depuis le début
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, "-saut niveau.sok fichier.dep [sauts]"
+* @return résultat : EXIT_SUCCESS si les plateaux obtenus sont identiques
+*/
+
+int banc_saut(int argc, char *argv[]){
+	t_arene arene; // mémoire des plateaux
+	t_paquet paquet; // recueil de niveaux
+	t_partie jeu; // partie rejouée par sauts
+	t_partie lineaire; // même partie rejouée depuis le début
+	int maxTaille;
+	int nbSauts = (argc > 4) ? atoi(argv[4]) : 10000;
+	int coup;
+	uint64_t graine = 0x5A7; // même suite de sauts à chaque exécution
+	double debut;
+	double preparation;
+	double total = 0;
+	double pire = 0;
+	bool identiques = true;
+
+	if (argc < 4) {
+		fprintf(stderr, "Utilisation : %s -saut niveau.sok fichier.dep [sauts]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	arene_init(&arene);
+	paquet_init(&paquet);
+	memset(&jeu, 0, sizeof(t_partie));
+	jeu.arene = &arene;
+	jeu.paquet = &paquet;
+	hist_init(&jeu.historiqueDep);
+	if (!chargerPartie(&jeu, argv[2]) || !chargerDeplacements(&jeu.historiqueDep, argv[3], &maxTaille, jeu.empreinte)) {
+		printf("%s ERREUR SUR FICHIER\n", argv[2]);
+		arene_liberer(&arene);
+		paquet_fermer(&paquet);
+		hist_liberer(&jeu.historiqueDep);
+		return EXIT_FAILURE;
+	}
+	chercher_joueur(&jeu);
+	lineaire = jeu;
+	jour_init(&lineaire.journal); // chaque partie a son propre journal
+	lineaire.plateau = niveau_allouer(&arene, jeu.hauteur, jeu.largeur);
+	niveau_copier(lineaire.plateau, jeu.plateau, jeu.hauteur, jeu.largeur);
+
+	debut = temps_us();
+	if (lineaire.plateau == NULL || !preparer_reprises(&jeu, maxTaille)) {
+		printf("%s MEMOIRE INSUFFISANTE\n", argv[2]);
+		arene_liberer(&arene);
+		paquet_fermer(&paquet);
+		hist_liberer(&jeu.historiqueDep);
+		return EXIT_FAILURE;
+	}
+	preparation = temps_us() - debut;
+
+	for (int i = 0; i < nbSauts; i++) {
+		graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+		coup = (int)((graine >> 33) % (uint64_t)(jeu.reprises.fin + 1));
+		aller_au_coup(&jeu, coup);
+		total += jeu.reprises.dureeSaut;
+		if (jeu.reprises.dureeSaut > pire) {
+			pire = jeu.reprises.dureeSaut;
+		}
+	}
+	// le dernier saut doit donner le plateau du rejeu complet
+	for (lineaire.nbDep = 0; lineaire.nbDep < jeu.nbDep; lineaire.nbDep++) {
+		appliquer_deplacement(&lineaire);
+	}
+	for (int lig = 0; lig < jeu.hauteur; lig++) {
+		identiques = identiques && memcmp(jeu.plateau[lig], lineaire.plateau[lig], jeu.largeur) == 0;
+	}
+	identiques = identiques && jeu.nbCaisses == lineaire.nbCaisses;
+	jour_liberer(&lineaire.journal);
+
+	printf("%s : %d coups, %d points de reprise de %d octets, préparés en %.3f ms\n", argv[2],
+		jeu.reprises.fin, jeu.reprises.nb, jeu.reprises.codage.octets, preparation / 1e3);
+	printf("%d sauts : %.1f us en moyenne, %.1f us au plus, plateau %s\n", nbSauts,
+		nbSauts > 0 ? total / nbSauts : 0.0, pire, identiques ? "IDENTIQUE" : "DIFFERENT");
+	liberer_reprises(&jeu);
+	jour_liberer(&jeu.journal);
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	hist_liberer(&jeu.historiqueDep);
+	return identiques ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief écrit un niveau de test carré : murs au bord, une caisse toutes les
+* quatre cases, une cible entre elles, le joueur dans le coin haut gauche
+* @param fichier type : chaine, entrée, fichier à créer
+* @param taille type : entier, entrée, nombre de lignes et de colonnes
+* @return résultat : faux si le fichier n'a pas pu être écrit
+*/
+
+bool ecrire_niveau_test(char fichier[], int taille){
+	FILE * f = fopen(fichier, "w");
+	char car;
+
+	if (f == NULL) {
+		return false;
+	}
+	for (int lig = 0; lig < taille; lig++) {
+		for (int col = 0; col < taille; col++) {
+			car = CASE;
+			if (lig == 0 || col == 0 || lig == taille - 1 || col == taille - 1) {
+				car = MUR;
+			}
+			else if (lig == 1 && col == 1) {
+				car = JOUEUR;
+			}
+			else if (lig % 4 == 2 && col % 4 == 2) {
+				car = CAISSE;
+			}
+			else if (lig % 4 == 0 && col % 4 == 0) {
+				car = CIBLE;
+			}
+			fputc(car, f);
+		}
+		fputc('\n', f);
+	}
+	return fclose(f) == 0;
+}
+
+/**
+* @brief vérifie le journal dans un couloir : deux pas à droite, une
+* annulation, un pas bloqué par le mur du haut, puis refaire doit redonner
+* le plateau des deux pas (le coup bloqué ne touche pas le coup à refaire)
+* @return résultat : faux si le coup refait n'est pas le bon
+*/
+
+bool verifier_journal(){
+	char lignes[3][8] = {"#######", "#  @  #", "#######"};
+	char *plateau[3] = {lignes[0], lignes[1], lignes[2]};
+	t_partie jeu;
+	bool ok;
+
+	memset(&jeu, 0, sizeof(t_partie));
+	jeu.plateau = plateau;
+	jeu.hauteur = 3;
+	jeu.largeur = 7;
+	jeu.posx = 1;
+	jeu.posy = 3;
+	jour_init(&jeu.journal);
+	jouer_coup(&jeu, DEP_DROITE);
+	jouer_coup(&jeu, DEP_DROITE);
+	jouer_coup(&jeu, RETOUR);
+	ok = jouer_coup(&jeu, DEP_HAUT) == DEP_ILLEGAL;
+	ok = ok && jour_refaire(&jeu.journal, jeu.plateau, &jeu.posx, &jeu.posy, &jeu.nbCaisses) == DEP_DROITE;
+	ok = ok && strcmp(lignes[0], "#######") == 0 && strcmp(lignes[1], "#    @#") == 0 &&
+		jeu.posx == 1 && jeu.posy == 5;
+	jour_liberer(&jeu.journal);
+	return ok;
+}
+
+/**
+* @brief lance les vérifications de comportement, sans mesure : chacune
+* affiche une ligne, et le code de sortie dit si toutes ont réussi.
+* Usage : sokoban -verifier
+* @return résultat : EXIT_FAILURE si une vérification échoue
+*/
+
+int verifier(){
+	bool ok = true;
+
+	if (verifier_journal()) {
+		printf("journal : correct\n");
+	}
+	else {
+		printf("JOURNAL INCORRECT : coup refait après un coup bloqué\n");
+		ok = false;
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief ajoute une mesure à la série à partir d'une durée totale ; si elle y
+* est déjà (essai précédent), seul le temps le plus court est gardé
+* @param serie type : structure, entrée/sortie, série de mesures
+* @param nom type : chaine, entrée, nom de la mesure
+* @param nbOps type : réel, entrée, nombre d'opérations mesurées
+* @param duree type : réel, entrée, durée totale en microsecondes
+* @param allocations type : entier, entrée, allocations pendant la mesure
+* @return résultat : mesure ajoutée
+*/
+
+void noter_mesure(t_releve *serie, char nom[], double nbOps, double duree, long allocations){
+	t_mesure *m = (t_mesure *)banc_chercher(serie, nom);
+
+	if (m == NULL) {
+		banc_ajouter(serie, nom, duree * 1e3 / nbOps, nbOps * 1e6 / duree, (double)allocations / nbOps);
+	}
+	else if (duree * 1e3 / nbOps < m->nsOp) {
+		m->nsOp = duree * 1e3 / nbOps;
+		m->opsSeconde = nbOps * 1e6 / duree;
+	}
+}
+
+/**
+* @brief mesure les fonctions du jeu et le rejeu complet de chaque
+* niveauN.dep et de niveaux générés, puis compare à une référence.
+* Usage : sokoban -suite                      (mesures seules)
+*         sokoban -suite reference.tsv [tol]  (comparaison, tolérance en %)
+*         sokoban -suite -ecrire reference.tsv (enregistre la référence)
+* Les mesures sont écrites au format de banc.h, sur la sortie standard.
+* Les allocations ne sont comptées que dans la version compilée avec
+* -DBANC_ALLOCATIONS : sans elle, la référence n'est pas enregistrée.
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return résultat : EXIT_FAILURE si une mesure régresse ou si un fichier manque
+*/
+
+int banc_suite(int argc, char *argv[]){
+	char *couples[] = {"niveau1.sok", "niveau1.dep", "niveau2.sok", "niveau2.dep",
+		"niveau3.sok", "niveau3.dep", "niveau4.sok", "niveau4.dep",
+		"niveau5.sok", "niveau5.dep", "niveau6.sok", "niveau6.dep"};
+	const int tailles[] = {64, 512}; // niveaux générés
+	const int cotes[] = {64, 256, 1024}; // niveaux générés pour les cases atteintes
+	const char *calculs[] = {"vecteur", "mots", "file"}; // façons de les calculer
+	const char *changements[] = {"table", "branches"}; // façons de changer les cases
+	char cases[2][257]; // un couloir pour chaque façon
+	char *lignes[2];
+	char ** volatile ligne; // relue à chaque coup
+	int joueurx;
+	int joueury;
+	int pas; // direction tirée
+	int hors[2]; // caisses hors cible de chaque couloir
+	uint64_t tirage; // hasard du couloir et des pas
+	t_bilan bilan; // coups appliqués par blocs
+	t_plateau_bits b; // plateau de bits pour les cases atteintes
+	t_remplissage remplissage;
+	uint64_t *atteintes;
+	int nbAtteintes[3];
+	t_arene arene; // mémoire des plateaux
+	t_paquet paquet; // recueil de niveaux
+	t_partie jeu;
+	t_partie * volatile partie = &jeu; // relue à chaque appel de gagner
+	t_resultat res;
+	t_releve serie;
+	t_releve reference;
+	FILE * f;
+	char nom[BANC_NOM];
+	char niveauTest[] = "/tmp/sokoban_suite_XXXXXX";
+	char *ecrire = (argc > 3 && strcmp(argv[2], "-ecrire") == 0) ? argv[3] : NULL;
+	char *comparer = (argc > 2 && ecrire == NULL) ? argv[2] : NULL;
+	double tolerance = (argc > 3 && ecrire == NULL) ? atof(argv[3]) : BANC_TOLERANCE;
+	double debut;
+	double duree;
+	long allocations;
+	long nbCoups;
+	int nbOps;
+	int sortie; // sortie standard, mise de côté pendant la mesure des images
+	int vide; // /dev/null
+	int descripteur;
+	uint64_t graine = 0x5A7; // mêmes coups à chaque exécution
+	bool ok = true;
+	const char *erreur = "ERREUR SUR FICHIER"; // affiché si ok devient faux
+
+	// sans BANC_ALLOCATIONS, la colonne des allocations reste à 0
+	if (!BANC_COMPTE) {
+		printf("# allocations non comptées : compiler avec -DBANC_ALLOCATIONS\n");
+		if (ecrire != NULL) {
+			printf("%s non écrit : la référence doit compter les allocations\n", ecrire);
+			return EXIT_FAILURE;
+		}
+	}
+	arene_init(&arene);
+	paquet_init(&paquet);
+	banc_init(&serie);
+	memset(&jeu, 0, sizeof(t_partie));
+	jeu.arene = &arene;
+	jeu.paquet = &paquet;
+	hist_init(&jeu.historiqueDep);
+	jour_init(&jeu.journal);
+	ecran_init(&jeu.ecran);
+
+	// sans fichier temporaire, les niveaux générés manqueraient à la comparaison
+	descripteur = mkstemp(niveauTest);
+	if (descripteur >= 0) {
+		close(descripteur);
+	}
+	else {
+		erreur = "FICHIER TEMPORAIRE NON CREE : niveaux générés non mesurés";
+		ok = false;
+	}
+	// chaque mesure est faite BANC_ESSAIS fois, la plus rapide est gardée
+	for (int essai = 0; ok && essai < BANC_ESSAIS; essai++) {
+		// lecture d'un niveau : fichier, cases mortes, caisses
+		for (int c = 0; ok && c < 6; c++) {
+			nbOps = 2000;
+			allocations = banc_allocations();
+			debut = temps_us();
+			for (int r = 0; ok && r < nbOps; r++) {
+				ok = chargerPartie(&jeu, couples[2*c]);
+			}
+			duree = temps_us() - debut;
+			snprintf(nom, BANC_NOM, "chargement/%.*s", (int)(strlen(couples[2*c]) - 4), couples[2*c]);
+			noter_mesure(&serie, nom, nbOps, duree, banc_allocations() - allocations);
+		}
+
+		// un pas à droite puis un pas à gauche, dans niveau3
+		if (ok && chargerPartie(&jeu, "niveau3.sok")) {
+			chercher_joueur(&jeu);
+			nbOps = 10000000;
+			allocations = banc_allocations();
+			debut = temps_us();
+			for (int r = 0; r < nbOps; r++) {
+				conditions_dep(&jeu, jeu.posx, jeu.posy + ((r & 1) ? -1 : 1), DEP_DROITE);
+			}
+			duree = temps_us() - debut;
+			noter_mesure(&serie, "conditions_dep", nbOps, duree, banc_allocations() - allocations);
+
+			allocations = banc_allocations();
+			debut = temps_us();
+			for (int r = 0; r < nbOps; r++) {
+				partie->nbCaisses = r & 1;
+				banc_puits = gagner(partie);
+			}
+			duree = temps_us() - debut;
+			noter_mesure(&serie, "gagner", nbOps, duree, banc_allocations() - allocations);
+
+			// marche au hasard dans un couloir de cibles tirées au hasard, avec
+			// une caisse à pousser : cases changées par la table de
+			// transitions.h ou par les tests sur les caractères
+			for (int k = 0; k < 2; k++) {
+				tirage = 0x24;
+				for (int col = 0; col < 256; col++) {
+					tirage = tirage * 6364136223846793005ull + 1442695040888963407ull;
+					cases[k][col] = (tirage >> 63) ? CIBLE : CASE;
+				}
+				cases[k][0] = MUR;
+				cases[k][255] = MUR;
+				cases[k][256] = '\0';
+				cases[k][1] = (cases[k][1] == CIBLE) ? JOUEUR_CIBLE : JOUEUR;
+				cases[k][2] = (cases[k][2] == CIBLE) ? CAISSE_CIBLE : CAISSE;
+				hors[k] = (cases[k][2] == CAISSE);
+				lignes[k] = cases[k];
+				ligne = &lignes[k];
+				joueurx = 0;
+				joueury = 1;
+				allocations = banc_allocations();
+				debut = temps_us();
+				for (int r = 0; r < nbOps; r++) {
+					tirage = tirage * 6364136223846793005ull + 1442695040888963407ull;
+					pas = (tirage >> 63) ? 1 : -1;
+					if (ligne[0][joueury + pas] == MUR) {
+						continue;
+					}
+					if (trans_est_caisse(ligne[0][joueury + pas])) {
+						if (!trans_accueille(ligne[0][joueury + 2 * pas])) {
+							continue;
+						}
+						if (k == 0) {
+							trans_caisse(ligne, 0, joueury + pas, 0, joueury + 2 * pas, &hors[k]);
+						}
+						else {
+							trans_caisse_branches(ligne, 0, joueury + pas, 0, joueury + 2 * pas, &hors[k]);
+						}
+					}
+					if (k == 0) {
+						trans_joueur(ligne, &joueurx, &joueury, 0, joueury + pas);
+					}
+					else {
+						trans_joueur_branches(ligne, &joueurx, &joueury, 0, joueury + pas);
+					}
+				}
+				duree = temps_us() - debut;
+				snprintf(nom, BANC_NOM, "transitions/%s", changements[k]);
+				noter_mesure(&serie, nom, nbOps, duree, banc_allocations() - allocations);
+			}
+			if (strcmp(cases[0], cases[1]) != 0 || hors[0] != hors[1]) {
+				erreur = "TRANSITIONS INCORRECTES : la table et les branches donnent des couloirs différents";
+				ok = false;
+			}
+
+			// images envoyées à /dev/null : construction, différence et write
+			jeu.nbCaisses = 1;
+			fflush(stdout);
+			sortie = dup(STDOUT_FILENO);
+			vide = open("/dev/null", O_WRONLY);
+			if (sortie >= 0 && vide >= 0 && dup2(vide, STDOUT_FILENO) >= 0) {
+				nbOps = 20000;
+				allocations = banc_allocations();
+				debut = temps_us();
+				for (int r = 0; r < nbOps; r++) {
+					conditions_dep(&jeu, jeu.posx, jeu.posy + ((r & 1) ? -1 : 1), DEP_DROITE);
+					afficher_entete(&jeu, couples[4], couples[5]);
+					afficher_plateau(&jeu);
+				}
+				duree = temps_us() - debut;
+				fflush(stdout);
+				dup2(sortie, STDOUT_FILENO);
+				noter_mesure(&serie, "afficher_plateau", nbOps, duree, banc_allocations() - allocations);
+			}
+			if (sortie >= 0) {
+				close(sortie);
+			}
+			if (vide >= 0) {
+				close(vide);
+			}
+		}
+
+		// rejeu complet de chaque couple : lecture des deux fichiers et analyse
+		for (int c = 0; ok && c < 6; c++) {
+			nbOps = 2000;
+			allocations = banc_allocations();
+			debut = temps_us();
+			for (int r = 0; ok && r < nbOps; r++) {
+				ok = analyser_couple(couples[2*c], couples[2*c+1], &res, &arene, &paquet);
+			}
+			duree = temps_us() - debut;
+			snprintf(nom, BANC_NOM, "rejeu/%.*s", (int)(strlen(couples[2*c]) - 4), couples[2*c]);
+			noter_mesure(&serie, nom, nbOps, duree, banc_allocations() - allocations);
+			snprintf(nom, BANC_NOM, "rejeu_coups/%.*s", (int)(strlen(couples[2*c]) - 4), couples[2*c]);
+			noter_mesure(&serie, nom, (double)nbOps * res.nbLus, duree, banc_allocations() - allocations);
+		}
+
+		// niveaux générés : lecture puis marche au hasard avec le moteur de caractères
+		for (int t = 0; ok && t < 2; t++) {
+			ok = ecrire_niveau_test(niveauTest, tailles[t]);
+			nbOps = 200;
+			allocations = banc_allocations();
+			debut = temps_us();
+			for (int r = 0; ok && r < nbOps; r++) {
+				ok = chargerPartie(&jeu, niveauTest);
+			}
+			duree = temps_us() - debut;
+			snprintf(nom, BANC_NOM, "chargement/genere%d", tailles[t]);
+			noter_mesure(&serie, nom, nbOps, duree, banc_allocations() - allocations);
+
+			hist_vider(&jeu.historiqueDep);
+			for (int r = 0; ok && r < 1000000; r++) {
+				graine = graine * 6364136223846793005ull + 1442695040888963407ull;
+				ok = hist_ajouter(&jeu.historiqueDep, "gdhb"[graine >> 62]);
+			}
+			chercher_joueur(&jeu);
+			jour_vider(&jeu.journal);
+			nbCoups = jeu.historiqueDep.nb;
+			allocations = banc_allocations();
+			debut = temps_us();
+			for (jeu.nbDep = 0; jeu.nbDep < nbCoups; jeu.nbDep++) {
+				appliquer_deplacement(&jeu);
+			}
+			duree = temps_us() - debut;
+			snprintf(nom, BANC_NOM, "coups/genere%d", tailles[t]);
+			noter_mesure(&serie, nom, nbCoups, duree, banc_allocations() - allocations);
+			joueurx = jeu.posx;
+			joueury = jeu.posy;
+
+			// les mêmes coups appliqués par blocs, depuis le même plateau
+			ok = chargerPartie(&jeu, niveauTest);
+			chercher_joueur(&jeu);
+			jour_vider(&jeu.journal);
+			jeu.nbDep = 0;
+			allocations = banc_allocations();
+			debut = temps_us();
+			rejouer_historique(&jeu, nbCoups, &bilan);
+			duree = temps_us() - debut;
+			snprintf(nom, BANC_NOM, "lot/genere%d", tailles[t]);
+			noter_mesure(&serie, nom, nbCoups, duree, banc_allocations() - allocations);
+			if (ok && (jeu.posx != joueurx || jeu.posy != joueury || bilan.nbLus != nbCoups)) {
+				erreur = "REJEU PAR BLOCS INCORRECT : position différente du rejeu coup par coup";
+				ok = false;
+			}
+		}
+
+		// cases atteintes par le joueur : remplissage des plans de bits avec
+		// SSE2/AVX2, le même un mot à la fois, puis file de cases
+		for (int t = 0; ok && t < 3; t++) {
+			ok = ecrire_niveau_test(niveauTest, cotes[t]) && chargerPartie(&jeu, niveauTest) &&
+				bits_allouer(&b, jeu.hauteur, jeu.largeur, &arene) &&
+				rempl_allouer(&remplissage, &b, &arene) &&
+				(atteintes = arene_allouer(&arene, b.nbMots * sizeof(uint64_t))) != NULL;
+			if (!ok) {
+				break;
+			}
+			bits_depuis_plateau(&b, jeu.plateau);
+			nbOps = 1 + 20000000 / (cotes[t] * cotes[t]);
+			for (int k = 0; k < 3; k++) {
+				remplissage.vectoriel = (k == 0);
+				allocations = banc_allocations();
+				debut = temps_us();
+				for (int r = 0; r < nbOps; r++) {
+					nbAtteintes[k] = (k < 2) ? rempl_joueur(&remplissage, &b, atteintes) :
+						rempl_par_file(&remplissage, &b, atteintes);
+				}
+				duree = temps_us() - debut;
+				snprintf(nom, BANC_NOM, "atteintes/%s/genere%d", calculs[k], cotes[t]);
+				noter_mesure(&serie, nom, nbOps, duree, banc_allocations() - allocations);
+			}
+			if (nbAtteintes[0] != nbAtteintes[2] || nbAtteintes[1] != nbAtteintes[2]) {
+				erreur = "CASES ATTEINTES INCORRECTES : les trois calculs ne donnent pas le même nombre";
+				ok = false;
+			}
+		}
+	}
+	if (descripteur >= 0) {
+		remove(niveauTest);
+	}
+
+	if (!ok) {
+		printf("%s\n", erreur);
+	}
+	else if (ecrire != NULL) {
+		f = fopen(ecrire, "w");
+		ok = f != NULL;
+		if (ok) {
+			banc_ecrire(&serie, f);
+			ok = fclose(f) == 0;
+		}
+		printf("%s %s (%d mesures)\n", ecrire, ok ? "écrit" : "ERREUR D'ECRITURE", serie.nb);
+	}
+	else if (comparer != NULL) {
+		ok = banc_lire(&reference, comparer);
+		if (!ok) {
+			printf("%s ERREUR SUR FICHIER\n", comparer);
+		}
+		ok = ok && banc_comparer(&serie, &reference, tolerance, stdout) == 0;
+		banc_liberer(&reference);
+	}
+	else {
+		banc_ecrire(&serie, stdout);
+	}
+	banc_liberer(&serie);
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	hist_liberer(&jeu.historiqueDep);
+	jour_liberer(&jeu.journal);
+	ecran_liberer(&jeu.ecran);
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief convertit un fichier de déplacements entre le texte et le format
+* binaire (voir binaire.h), caractère par caractère
+* Usage : sokoban -binaire niveau.sok fichier.dep fichier.depb
+*         sokoban -texte fichier.depb fichier.dep
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return résultat : EXIT_SUCCESS si le fichier converti a été écrit
+*/
+
+int convertir_deplacements(int argc, char *argv[]){
+	t_arene arene; // mémoire du plateau
+	t_paquet paquet; // recueil de niveaux
+	t_partie jeu;
+	t_binaire b;
+	FILE * f;
+	int c;
+	long taille; // octets du fichier converti
+	struct stat infos; // taille du fichier binaire écrit
+	bool ok;
+
+	if (strcmp(argv[1], "-texte") == 0 && argc == 4) {
+		if (!bin_ouvrir(&b, argv[2])) {
+			printf("%s ERREUR SUR FICHIER\n", argv[2]);
+			return EXIT_FAILURE;
+		}
+		f = fopen(argv[3], "w");
+		ok = f != NULL;
+		while (ok && (c = bin_lire(&b)) != BIN_FIN) {
+			ok = fputc(c, f) != EOF;
+		}
+		ok = ok && b.lus == b.nbCoups;
+		printf("%s : %u coups dont %u poussées\n", argv[3], b.nbCoups, b.nbPoussees);
+		bin_fermer_lecture(&b);
+		ok = f != NULL && fclose(f) == 0 && ok;
+	}
+	else if (strcmp(argv[1], "-binaire") == 0 && argc == 5) {
+		arene_init(&arene);
+		paquet_init(&paquet);
+		jeu.arene = &arene;
+		jeu.paquet = &paquet;
+		f = fopen(argv[3], "r");
+		if (!chargerPartie(&jeu, argv[2]) || f == NULL || !bin_creer(&b, argv[4], jeu.empreinte)) {
+			printf("%s ERREUR SUR FICHIER\n", f == NULL ? argv[3] : argv[2]);
+			if (f != NULL) {
+				fclose(f);
+			}
+			arene_liberer(&arene);
+			paquet_fermer(&paquet);
+			return EXIT_FAILURE;
+		}
+		ok = true;
+		while (ok && (c = fgetc(f)) != EOF) {
+			ok = bin_ecrire(&b, (char)c);
+		}
+		taille = ftell(f);
+		fclose(f);
+		ok = bin_fermer_ecriture(&b) && ok && stat(argv[4], &infos) == 0;
+		printf("%s : %u coups dont %u poussées, %ld octets au lieu de %ld\n", argv[4],
+			b.nbCoups, b.nbPoussees, ok ? (long)infos.st_size : 0L, taille);
+		arene_liberer(&arene);
+		paquet_fermer(&paquet);
+	}
+	else {
+		fprintf(stderr, "Utilisation : %s -binaire niveau.sok fichier.dep fichier.depb\n", argv[0]);
+		fprintf(stderr, "              %s -texte fichier.depb fichier.dep\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (!ok) {
+		printf("ERREUR D'ECRITURE\n");
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief raccourcit une solution valide (voir optimiseur.h) : les coups
+* annulés par 'u' sont retirés, chaque marche entre deux poussées devient un
+* plus court chemin puis, avec une fenêtre, chaque suite de quelques poussées
+* est remplacée par la suite de coups la plus courte entre les mêmes états
+* Usage : sokoban -optimiser niveau.sok fichier.dep sortie.dep [fenetre]
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return résultat : EXIT_SUCCESS si la solution raccourcie a été écrite
+*/
+
+int optimiser_deplacements(int argc, char *argv[]){
+	t_arene arene; // mémoire des plateaux
+	t_paquet paquet; // recueil de niveaux
+	t_partie jeu; // partie rejouée avec le moteur de l'analyse
+	t_plateau initial; // plateau tel que chargé
+	t_optimiseur o;
+	FILE * f;
+	t_historique net; // coups qui restent une fois les annulations retirées
+	t_historique marches; // coups avec les plus courtes marches
+	t_historique sortie; // coups après les fenêtres
+	unsigned char *etapes = NULL; // état après chaque poussée (0 : départ)
+	int *fins = NULL; // coups de marches jusqu'à chaque étape
+	int fenetre = (argc > 5) ? atoi(argv[5]) : 0;
+	int maxTaille;
+	int statut;
+	int avantx; // case du joueur avant le coup
+	int avanty;
+	int nbCoups = 0; // coups joués par le fichier d'origine
+	int nbPoussees = 0;
+	int nbAnnulations = 0;
+	int nbEtapes = 1;
+	int joueur; // case du joueur dans l'optimiseur
+	int cible; // case d'où part la poussée
+	int d;
+	int fin;
+	char c;
+	bool ok = true;
+	double debut = temps_us();
+
+	if (argc < 5) {
+		fprintf(stderr, "Utilisation : %s -optimiser niveau.sok fichier.dep sortie.dep [fenetre]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	arene_init(&arene);
+	paquet_init(&paquet);
+	memset(&jeu, 0, sizeof(t_partie));
+	jeu.arene = &arene;
+	jeu.paquet = &paquet;
+	hist_init(&jeu.historiqueDep);
+	hist_init(&net);
+	hist_init(&marches);
+	hist_init(&sortie);
+	memset(&o, 0, sizeof(t_optimiseur));
+	if (!chargerPartie(&jeu, argv[2]) || !chargerDeplacements(&jeu.historiqueDep, argv[3], &maxTaille, jeu.empreinte)) {
+		printf("%s ERREUR SUR FICHIER\n", argv[2]);
+		ok = false;
+	}
+	initial = ok ? niveau_allouer(&arene, jeu.hauteur, jeu.largeur) : NULL;
+	if (ok && (initial == NULL ||
+		!opt_init(&o, jeu.plateau, jeu.hauteur, jeu.largeur, jeu.mortes, OPT_NOEUDS))) {
+		printf("%s MEMOIRE INSUFFISANTE\n", argv[2]);
+		ok = false;
+	}
+
+	// rejeu avec le moteur de l'analyse : une annulation retire le dernier coup
+	if (ok) {
+		niveau_copier(initial, jeu.plateau, jeu.hauteur, jeu.largeur);
+		chercher_joueur(&jeu);
+		joueur = jeu.posx * o.pas + jeu.posy;
+		while (ok && jeu.nbDep < maxTaille && !gagner(&jeu)) {
+			avantx = jeu.posx;
+			avanty = jeu.posy;
+			statut = appliquer_deplacement(&jeu);
+			d = (jeu.posx < avantx) ? 0 : (jeu.posx > avantx) ? 1 : (jeu.posy < avanty) ? 2 : 3;
+			if (statut == DEP_SIMPLE || statut == DEP_POUSSEE) {
+				nbCoups++;
+				nbPoussees += statut == DEP_POUSSEE;
+				ok = hist_ajouter(&net, statut == DEP_POUSSEE ? opt_poussees[d] : opt_marches[d]);
+			}
+			else if (statut == DEP_ANNULE) {
+				nbAnnulations++;
+				c = hist_retirer(&net);
+				// le joueur doit revenir d'où il était parti pour ce coup
+				ok = c != '\0' && (jeu.posx != avantx || jeu.posy != avanty) &&
+					tolower(c) == opt_marches[d ^ 1];
+			}
+			jeu.nbDep++;
+		}
+		if (!ok || !gagner(&jeu)) {
+			printf("%s : la suite de déplacements %s n'est pas une solution rejouable\n", argv[2], argv[3]);
+			ok = false;
+		}
+	}
+
+	// plus courtes marches : seules les poussées du rejeu sont gardées
+	if (ok) {
+		etapes = malloc(((size_t)net.nb + 1) * o.codage.octets);
+		fins = malloc((net.nb + 1) * sizeof(int));
+		ok = etapes != NULL && fins != NULL;
+		opt_coder(&o, joueur, etapes);
+		fins[0] = 0;
+		cible = joueur;
+		for (int i = 0; ok && i < net.nb; i++) {
+			c = hist_lire(&net, i);
+			d = strchr(opt_marches, tolower(c)) - opt_marches;
+			if (isupper((unsigned char)c)) {
+				ok = opt_marcher(&o, joueur, cible, &marches);
+				joueur = cible;
+				ok = ok && opt_pousser(&o, &joueur, d, &marches);
+				opt_coder(&o, joueur, &etapes[(size_t)nbEtapes * o.codage.octets]);
+				fins[nbEtapes++] = marches.nb;
+			}
+			cible += o.decalage[d];
+		}
+		if (!ok) {
+			printf("%s MEMOIRE INSUFFISANTE\n", argv[2]);
+		}
+	}
+
+	// fenêtres de quelques poussées, remplacées si une suite plus courte existe
+	for (int e = 0; ok && e + 1 < nbEtapes; e += (fenetre > 0) ? fenetre : nbEtapes) {
+		fin = (fenetre > 0 && e + fenetre < nbEtapes - 1) ? e + fenetre : nbEtapes - 1;
+		if (fenetre <= 0 || opt_fenetre(&o, &etapes[(size_t)e * o.codage.octets],
+			&etapes[(size_t)fin * o.codage.octets], fins[fin] - fins[e], &sortie) < 0) {
+			for (int i = fins[e]; ok && i < fins[fin]; i++) {
+				ok = hist_ajouter(&sortie, hist_lire(&marches, i));
+			}
+		}
+	}
+
+	if (ok) {
+		printf("%s : %d coups, %d poussées, %d annulations au départ\n", argv[3],
+			nbCoups, nbPoussees, nbAnnulations);
+		printf("  sans les coups annulés : %d coups, %d poussées\n", net.nb, nbEtapes - 1);
+		printf("  plus courtes marches   : %d coups, %d poussées\n", marches.nb, nbEtapes - 1);
+		if (fenetre > 0) {
+			nbPoussees = 0;
+			for (int i = 0; i < sortie.nb; i++) {
+				nbPoussees += isupper((unsigned char)hist_lire(&sortie, i)) != 0;
+			}
+			printf("  fenêtres de %d poussées : %d coups, %d poussées\n", fenetre, sortie.nb, nbPoussees);
+		}
+		// la solution raccourcie est rejouée par le même moteur avant d'être écrite
+		niveau_copier(jeu.plateau, initial, jeu.hauteur, jeu.largeur);
+		jeu.nbCaisses = 0;
+		for (int q = 0; q < jeu.hauteur * jeu.largeur; q++) {
+			jeu.nbCaisses += initial[q / jeu.largeur][q % jeu.largeur] == CAISSE;
+		}
+		chercher_joueur(&jeu);
+		jour_vider(&jeu.journal);
+		hist_liberer(&jeu.historiqueDep);
+		jeu.historiqueDep = sortie;
+		hist_init(&sortie);
+		for (jeu.nbDep = 0; jeu.nbDep < jeu.historiqueDep.nb && !gagner(&jeu); jeu.nbDep++) {
+			appliquer_deplacement(&jeu);
+		}
+		ok = gagner(&jeu);
+		if (ok && bin_extension(argv[4])) {
+			ok = bin_enregistrer(&jeu.historiqueDep, argv[4], jeu.empreinte);
+		}
+		else if (ok) {
+			f = fopen(argv[4], "w");
+			ok = f != NULL;
+			if (ok) {
+				hist_ecrire_fichier(&jeu.historiqueDep, f);
+				ok = fclose(f) == 0;
+			}
+		}
+		printf("%s %s en %.3f ms\n", argv[4], ok ? "écrit" : "ERREUR : solution non vérifiée ou non écrite",
+			(temps_us() - debut) / 1e3);
+	}
+	free(etapes);
+	free(fins);
+	opt_liberer(&o);
+	hist_liberer(&net);
+	hist_liberer(&marches);
+	hist_liberer(&sortie);
+	hist_liberer(&jeu.historiqueDep);
+	jour_liberer(&jeu.journal);
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief affiche le résultat d'une analyse sur une seule ligne
+* @param fichier type : chaine, entrée, fichier de la partie
+* @param deplacements type : chaine, entrée, fichier des déplacements
+* @param res type : structure, entrée, résultat de l'analyse
+* @return résultat : ligne de résultat affichée
+*/
+
+void afficher_resultat(char fichier[], char deplacements[], t_resultat *res){
+	printf("%s %s %s coups=%d poussees=%d annulations=%d lus=%d illegal=%d impasse=%d temps=%.1fus\n",
+		fichier, deplacements, res->valide ? "VALIDE" : "INVALIDE",
+		res->nbCoups, res->nbPoussees, res->nbAnnulations, res->nbLus,
+		res->premierIllegal, res->premiereImpasse, res->duree);
+}
+
+/**
+* @brief ajoute un couple niveau / déplacements à la fin du lot
+* @param lot type : structure, entrée/sortie, lot de tâches
+* @param fichier type : chaine, entrée, fichier de la partie
+* @param deplacements type : chaine, entrée, fichier des déplacements
+* @return résultat : tâche ajoutée
+*/
+
+void ajouter_tache(t_lot *lot, char fichier[], char deplacements[]){
+	if (lot->nb == lot->capacite) {
+		lot->capacite = (lot->capacite == 0) ? 64 : lot->capacite * 2;
+		lot->taches = realloc(lot->taches, lot->capacite * sizeof(t_tache));
+		if (lot->taches == NULL) {
+			fprintf(stderr, "MEMOIRE INSUFFISANTE\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	snprintf(lot->taches[lot->nb].fichier, TAILLE_LIGNE, "%s", fichier);
+	snprintf(lot->taches[lot->nb].deplacements, TAILLE_LIGNE, "%s", deplacements);
+	lot->taches[lot->nb].lu = false;
+	lot->nb++;
+}
+
+/**
+* @brief lit un manifeste contenant un couple "niveau.sok niveau.dep" par ligne
+* @param lot type : structure, entrée/sortie, lot de tâches
+* @param manifeste type : chaine, entrée, fichier manifeste
+* @return résultat : faux si le manifeste n'a pas pu être ouvert
+*/
+
+bool lire_manifeste(t_lot *lot, char manifeste[]){
+	FILE * f;
+	char ligne[TAILLE_LIGNE]; // ligne du manifeste
+	char fichier[TAILLE_LIGNE];
+	char deplacements[TAILLE_LIGNE];
+
+	f = fopen(manifeste, "r");
+	if (f == NULL) {
+		return false;
+	}
+	while (fgets(ligne, TAILLE_LIGNE, f) != NULL) {
+		// les lignes vides et les commentaires sont ignorés
+		if (ligne[0] != '#' &&
+			sscanf(ligne, "%255s %255s", fichier, deplacements) == 2) {
+			ajouter_tache(lot, fichier, deplacements);
+		}
+	}
+	fclose(f);
+	return true;
+}
+
+/**
+* @brief compare deux tâches selon le nom du fichier de la partie
+* @param a type : pointeur, entrée, première tâche
+* @param b type : pointeur, entrée, deuxième tâche
+* @return résultat : ordre alphabétique des fichiers
+*/
+
+int comparer_taches(const void *a, const void *b){
+	return strcmp(((const t_tache *)a)->fichier, ((const t_tache *)b)->fichier);
+}
+
+/**
+* @brief ajoute au lot chaque niveau .sok d'un dossier qui a un .dep du même nom
+* @param lot type : structure, entrée/sortie, lot de tâches
+* @param dossier type : chaine, entrée, dossier à parcourir
+* @return résultat : faux si le dossier n'a pas pu être ouvert
+*/
+
+bool lire_dossier(t_lot *lot, char dossier[]){
+	DIR * d;
+	struct dirent *entree;
+	char fichier[TAILLE_LIGNE];
+	char deplacements[TAILLE_LIGNE];
+	size_t longueur; // longueur du nom de l'entrée
+	int premier = lot->nb; // première tâche ajoutée par ce dossier
+
+	d = opendir(dossier);
+	if (d == NULL) {
+		return false;
+	}
+	while ((entree = readdir(d)) != NULL) {
+		longueur = strlen(entree->d_name);
+		// les chemins trop longs sont ignorés
+		if (longueur > 4 && strcmp(entree->d_name + longueur - 4, ".sok") == 0 &&
+			snprintf(fichier, TAILLE_LIGNE, "%s/%s", dossier, entree->d_name) < TAILLE_LIGNE) {
+			strcpy(deplacements, fichier);
+			strcpy(deplacements + strlen(deplacements) - 4, ".dep");
+			if (access(deplacements, R_OK) != 0 && strlen(fichier) + 1 < TAILLE_LIGNE) {
+				strcat(deplacements, "b"); // à défaut, la solution binaire .depb
+			}
+			if (access(deplacements, R_OK) == 0) {
+				ajouter_tache(lot, fichier, deplacements);
+			}
+		}
+	}
+	closedir(d);
+	// readdir ne garantit aucun ordre : tri pour un affichage reproductible
+	qsort(lot->taches + premier, lot->nb - premier, sizeof(t_tache), comparer_taches);
+	return true;
+}
+
+/**
+* @brief le propriétaire d'une file retire la tâche du bas
+* @param file type : structure, entrée/sortie, file du thread courant
+* @return résultat : indice de la tâche, -1 si la file est vide
+*/
+
+int retirer_tache(t_file_vol *file){
+	long bas = atomic_load(&file->bas) - 1;
+	long haut;
+	int tache = -1;
+
+	atomic_store(&file->bas, bas);
+	haut = atomic_load(&file->haut);
+	if (haut <= bas) {
+		tache = file->indices[bas];
+		if (haut == bas) {
+			// dernière tâche : course possible avec un voleur
+			if (!atomic_compare_exchange_strong(&file->haut, &haut, haut + 1)) {
+				tache = -1;
+			}
+			atomic_store(&file->bas, bas + 1);
+		}
+	}
+	else {
+		atomic_store(&file->bas, bas + 1);
+	}
+	return tache;
+}
+
+/**
+* @brief un autre thread vole la tâche du haut d'une file
+* @param file type : structure, entrée/sortie, file de la victime
+* @return résultat : indice de la tâche, -1 si la file est vide ou si le vol
+	a été perdu face à un autre thread
+*/
+
+int voler_tache(t_file_vol *file){
+	long haut = atomic_load(&file->haut);
+	long bas = atomic_load(&file->bas);
+	int tache = -1;
+
+	if (haut < bas) {
+		tache = file->indices[haut];
+		if (!atomic_compare_exchange_strong(&file->haut, &haut, haut + 1)) {
+			tache = -1;
+		}
+	}
+	return tache;
+}
+
+/**
+* @brief boucle d'un thread d'analyse : vide sa file puis vole les autres.
+* Le thread s'arrête dès que toutes les files sont vides, sans attendre la
+* fin des tâches prises par les autres ; un vol manqué laisse la main.
+* @param arg type : pointeur, entrée, arguments du thread (t_ouvrier)
+* @return résultat : NULL
+*/
+
+void *analyser_taches(void *arg){
+	t_ouvrier *ouvrier = arg;
+	t_pool *pool = ouvrier->pool;
+	t_tache *tache;
+	unsigned int graine = ouvrier->numero * 2654435761u + 1; // choix des victimes
+	int indice;
+	t_arene arene; // mémoire des plateaux du thread, réutilisée de tâche en tâche
+	t_paquet paquet; // recueil ouvert par le thread, gardé pour les tâches suivantes
+
+	arene_init(&arene);
+	paquet_init(&paquet);
+	while (atomic_load(&pool->aDistribuer) > 0) {
+		indice = retirer_tache(&pool->files[ouvrier->numero]);
+		if (indice < 0 && pool->nbThreads > 1) {
+			graine = graine * 1103515245u + 12345u;
+			indice = voler_tache(&pool->files[(graine >> 8) % pool->nbThreads]);
+		}
+		if (indice >= 0) {
+			atomic_fetch_sub(&pool->aDistribuer, 1);
+			tache = &pool->lot->taches[indice];
+			tache->lu = analyser_couple(tache->fichier, tache->deplacements, &tache->res, &arene, &paquet);
+		}
+		else {
+			sched_yield(); // file vide ou vol perdu : la victime avance
+		}
+	}
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	return NULL;
+}
+
+/**
+* @brief analyse toutes les tâches d'un lot sur plusieurs threads. Les tâches
+* sont réparties à tour de rôle dans les files puis rééquilibrées par vol.
+* @param lot type : structure, entrée/sortie, lot de tâches
+* @param nbThreads type : entier, entrée, nombre de threads
+* @return résultat : résultats rangés dans chaque tâche du lot, faux si la
+	mémoire des files manque (aucune tâche analysée)
+*/
+
+bool analyser_lot_parallele(t_lot *lot, int nbThreads){
+	t_pool pool;
+	t_ouvrier ouvriers[MAXTHREADS];
+	pthread_t threads[MAXTHREADS];
+	int taille = lot->nb / nbThreads + 1; // taille maximale d'une file
+
+	pool.lot = lot;
+	pool.nbThreads = nbThreads;
+	atomic_init(&pool.aDistribuer, lot->nb);
+	pool.files = malloc(nbThreads * sizeof(t_file_vol));
+	if (pool.files == NULL) {
+		return false;
+	}
+	for (int i = 0; i < nbThreads; i++) {
+		pool.files[i].indices = malloc(taille * sizeof(int));
+		if (pool.files[i].indices == NULL) {
+			while (--i >= 0) {
+				free(pool.files[i].indices);
+			}
+			free(pool.files);
+			return false;
+		}
+		atomic_init(&pool.files[i].haut, 0);
+		atomic_init(&pool.files[i].bas, 0);
+	}
+	// le propriétaire retire par le bas : on empile à l'envers pour
+	// que chaque thread commence par les premières tâches de sa file
+	for (int i = lot->nb - 1; i >= 0; i--) {
+		t_file_vol *file = &pool.files[i % nbThreads];
+		file->indices[atomic_load(&file->bas)] = i;
+		atomic_fetch_add(&file->bas, 1);
+	}
+
+	for (int i = 0; i < nbThreads; i++) {
+		ouvriers[i].pool = &pool;
+		ouvriers[i].numero = i;
+		pthread_create(&threads[i], NULL, analyser_taches, &ouvriers[i]);
+	}
+	for (int i = 0; i < nbThreads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	for (int i = 0; i < nbThreads; i++) {
+		free(pool.files[i].indices);
+	}
+	free(pool.files);
+	return true;
+}
+
+/**
+* @brief analyse sans affichage une liste de couples niveau / déplacements,
+* répartie sur tous les coeurs. Les résultats sont affichés dans l'ordre des
+* couples, quel que soit le nombre de threads.
+* Usage : sokoban [-j threads] niveau1.sok niveau1.dep [niveau2.sok niveau2.dep ...]
+*         sokoban [-j threads] -f manifeste.txt (un couple "niveau.sok niveau.dep" par ligne)
+*         sokoban [-j threads] -d dossier (chaque niveauN.sok avec son niveauN.dep ou niveauN.depb)
+* Un niveau peut aussi être pris dans un recueil : recueil.xsb#N (voir paquet.h).
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return résultat : EXIT_SUCCESS si toutes les solutions sont valides
+*/
+
+int analyse_lot(int argc, char *argv[]){
+	t_lot lot = {NULL, 0, 0};
+	t_tache *tache;
+	int nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	int nbValides = 0;
+	int arg = 1; // argument courant
+	bool correct = true; // la ligne de commande est correcte
+	double debut;
+	double duree;
+
+	if (argc > 2 && strcmp(argv[1], "-j") == 0) {
+		nbThreads = atoi(argv[2]);
+		arg = 3;
+	}
+	if (nbThreads < 1) {
+		nbThreads = 1;
+	}
+	if (nbThreads > MAXTHREADS) {
+		nbThreads = MAXTHREADS;
+	}
+
+	if (argc - arg == 2 && strcmp(argv[arg], "-f") == 0) {
+		if (!lire_manifeste(&lot, argv[arg+1])) {
+			fprintf(stderr, "MANIFESTE NON TROUVE : %s\n", argv[arg+1]);
+			return EXIT_FAILURE;
+		}
+	}
+	else if (argc - arg == 2 && strcmp(argv[arg], "-d") == 0) {
+		if (!lire_dossier(&lot, argv[arg+1])) {
+			fprintf(stderr, "DOSSIER NON TROUVE : %s\n", argv[arg+1]);
+			return EXIT_FAILURE;
+		}
+	}
+	else if (argc - arg > 0 && (argc - arg) % 2 == 0) {
+		for (int i = arg; i < argc; i += 2) {
+			ajouter_tache(&lot, argv[i], argv[i+1]);
+		}
+	}
+	else {
+		correct = false;
+	}
+	if (!correct) {
+		fprintf(stderr, "Usage : %s [-j threads] niveau.sok niveau.dep [niveau.sok niveau.dep ...]\n", argv[0]);
+		fprintf(stderr, "        %s [-j threads] -f manifeste.txt\n", argv[0]);
+		fprintf(stderr, "        %s [-j threads] -d dossier\n", argv[0]);
+		fprintf(stderr, "        (un niveau peut être recueil.xsb#N)\n");
+		return EXIT_FAILURE;
+	}
+
+	if (nbThreads > lot.nb && lot.nb > 0) {
+		nbThreads = lot.nb;
+	}
+	debut = temps_us();
+	if (!analyser_lot_parallele(&lot, nbThreads)) {
+		printf("MEMOIRE INSUFFISANTE\n");
+		free(lot.taches);
+		return EXIT_FAILURE;
+	}
+	duree = temps_us() - debut;
+
+	for (int i = 0; i < lot.nb; i++) {
+		tache = &lot.taches[i];
+		if (!tache->lu) {
+			printf("%s %s ERREUR fichier illisible ou mémoire insuffisante\n", tache->fichier, tache->deplacements);
+		}
+		else {
+			afficher_resultat(tache->fichier, tache->deplacements, &tache->res);
+			nbValides += tache->res.valide;
+		}
+	}
+
+	printf("%d couples analysés, %d valides, %d invalides en %.3f ms sur %d threads (%.0f couples/s)\n",
+		lot.nb, nbValides, lot.nb - nbValides, duree / 1e3, nbThreads,
+		(duree > 0) ? lot.nb / (duree / 1e6) : 0.0);
+	free(lot.taches);
+	return (nbValides == lot.nb) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,370 @@
+/**
+* @file solveur.c
+* @brief Programme qui cherche une solution d'un niveau de sokoban
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Ce programme lit un niveau (.sok), cherche une solution avec le moins de
+* poussées possible (voir solveur.h) et l'écrit dans un fichier de
+* déplacements (.dep) que sokoban.c peut rejouer. Un nom qui finit par .depb
+* donne le format binaire de binaire.h, trois fois plus petit.
+*
+* Utilisation : solveur niveau.sok solution.dep [-m Mo] [-n noeuds] [-j threads]
+*                       [-e affectation|manhattan]
+*               solveur -echelle [-j threads] niveau.sok...
+*               solveur -estimation niveau.sok...
+*
+* La recherche est celle de solveur_parallele.h, sur un thread par défaut ou
+* sur le nombre donné par -j : elle écrit le même fichier quel que soit ce
+* nombre. À nombre de poussées égal, elle garde le chemin qui compte le moins
+* de déplacements. -m ne sert qu'à la table de solv_resoudre (-estimation).
+* -echelle résout chaque niveau avec 1, 2, 4... threads et compare les durées.
+* -estimation compare l'affectation des caisses aux cibles (par défaut) et la
+* distance de Manhattan : coût de l'estimation par noeud et noeuds développés.
+* Un niveau peut être pris dans un recueil de plusieurs niveaux : recueil.xsb#N
+* (voir paquet.h).
+*
+* Compilation : gcc -O2 solveur.c -o solveur -lpthread
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TABLE_MO 64 // taille par défaut de la table de transposition
+#define MAXNOEUDS 20000000 // nombre maximal de noeuds par défaut
+
+#include "niveau.h"
+#include "paquet.h"
+#include "historique.h"
+#include "binaire.h"
+#include "solveur.h"
+#include "solveur_parallele.h"
+
+double temps_us();
+bool enregistrerSolution(t_historique *solution, char fichier[], uint64_t empreinte);
+int echelle(int argc, char *argv[]);
+int compter_poussees(t_historique *solution);
+int comparer_estimations(int argc, char *argv[]);
+
+/**
+* @brief coeur du programme
+* Lit le niveau, lance la recherche, écrit la solution et affiche les
+* statistiques de la recherche.
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, arguments de la commande
+* @return EXIT_SUCCESS si une solution a été écrite, EXIT_FAILURE sinon
+*/
+
+int main(int argc, char *argv[]){
+	t_arene arene; // mémoire du plateau
+	t_paquet paquet; // recueil de niveaux (fichier.xsb#N)
+	t_solveur solveur;
+	t_historique solution;
+	char **plateau;
+	int hauteur;
+	int largeur;
+	int megaOctets = TABLE_MO;
+	int maxNoeuds = MAXNOEUDS;
+	int nbThreads = 1;
+	int heuristique = SOLV_AFFECTATION;
+	int resultat;
+	int nbPoussees;
+	uint64_t empreinte; // empreinte du niveau, écrite dans les fichiers .depb
+	double debut;
+	double duree;
+
+	if (argc > 1 && strcmp(argv[1], "-echelle") == 0) {
+		return echelle(argc, argv);
+	}
+	if (argc > 1 && strcmp(argv[1], "-estimation") == 0) {
+		return comparer_estimations(argc, argv);
+	}
+	if (argc < 3) {
+		fprintf(stderr, "Utilisation : %s niveau.sok|recueil.xsb#N solution.dep [-m Mo] [-n noeuds] [-j threads]"
+			" [-e affectation|manhattan]\n", argv[0]);
+		fprintf(stderr, "              %s -echelle [-j threads] niveau.sok...\n", argv[0]);
+		fprintf(stderr, "              %s -estimation niveau.sok...\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	for (int arg = 3; arg + 1 < argc; arg += 2) {
+		if (strcmp(argv[arg], "-m") == 0) {
+			megaOctets = atoi(argv[arg+1]);
+		}
+		else if (strcmp(argv[arg], "-n") == 0) {
+			maxNoeuds = atoi(argv[arg+1]);
+		}
+		else if (strcmp(argv[arg], "-j") == 0) {
+			nbThreads = atoi(argv[arg+1]);
+		}
+		else if (strcmp(argv[arg], "-e") == 0) {
+			heuristique = strcmp(argv[arg+1], "manhattan") == 0 ? SOLV_MANHATTAN : SOLV_AFFECTATION;
+		}
+	}
+	if (megaOctets < 1) {
+		megaOctets = 1;
+	}
+	if (maxNoeuds < 1) {
+		maxNoeuds = 1;
+	}
+
+	arene_init(&arene);
+	paquet_init(&paquet);
+	hist_init(&solution);
+	if (!paquet_charger(&paquet, argv[1], &arene, &plateau, &hauteur, &largeur)) {
+		printf("ERREUR SUR FICHIER\n");
+		arene_liberer(&arene);
+		paquet_fermer(&paquet);
+		return EXIT_FAILURE;
+	}
+	empreinte = bin_empreinte(plateau, hauteur, largeur); // avant toute recherche
+	if (!solv_init(&solveur, plateau, hauteur, largeur, megaOctets, maxNoeuds)) {
+		printf("NIVEAU INCORRECT : %s\n", argv[1]);
+		solv_liberer(&solveur);
+		arene_liberer(&arene);
+		paquet_fermer(&paquet);
+		return EXIT_FAILURE;
+	}
+	solveur.heuristique = heuristique;
+
+	debut = temps_us();
+	resultat = solv_resoudre_parallele(&solveur, nbThreads, &solution);
+	duree = temps_us() - debut;
+
+	if (resultat == SOLV_TROUVE) {
+		nbPoussees = compter_poussees(&solution);
+		if (!enregistrerSolution(&solution, argv[2], empreinte)) {
+			printf("ERREUR SUR FICHIER : %s\n", argv[2]);
+			resultat = SOLV_LIMITE;
+		}
+		else {
+			printf("%s SOLUTION %s coups=%d poussees=%d\n", argv[1], argv[2], solution.nb, nbPoussees);
+		}
+	}
+	else if (resultat == SOLV_IMPOSSIBLE) {
+		printf("%s SANS SOLUTION\n", argv[1]);
+	}
+	else {
+		printf("%s LIMITE ATTEINTE (%d noeuds)\n", argv[1], maxNoeuds);
+	}
+	printf("%ld noeuds développés, %ld générés en %.3f ms (%.0f noeuds/s)\n",
+		solveur.developpes, solveur.generes, duree / 1e3,
+		duree > 0 ? solveur.developpes / (duree / 1e6) : 0.0);
+	printf("état codé sur %d octets au lieu de %d pour le plateau, %d octets par noeud\n",
+		solveur.codage.octets, hauteur * largeur,
+		(int)(solveur.codage.octets + sizeof(t_etat) + sizeof(t_ouvert)));
+
+	hist_liberer(&solution);
+	solv_liberer(&solveur);
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	return resultat == SOLV_TROUVE ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief donne l'heure courante d'une horloge monotone
+* @return résultat : temps en microsecondes
+*/
+
+double temps_us(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+/**
+* @brief écrit la solution dans un fichier de déplacements, en binaire si
+* le nom finit par .depb (voir binaire.h)
+* @param solution type : structure, entrée, déplacements trouvés
+* @param fichier type : chaine, entrée, nom du fichier .dep ou .depb
+* @param empreinte type : entier, entrée, empreinte du niveau résolu
+* @return résultat : faux si le fichier n'a pas pu être créé
+*/
+
+bool enregistrerSolution(t_historique *solution, char fichier[], uint64_t empreinte){
+	FILE * f;
+
+	if (bin_extension(fichier)) {
+		return bin_enregistrer(solution, fichier, empreinte);
+	}
+	f = fopen(fichier, "w");
+	if (f == NULL) {
+		return false;
+	}
+	hist_ecrire_fichier(solution, f);
+	fclose(f);
+	return true;
+}
+
+/**
+* @brief compte les poussées d'une suite de déplacements
+* @param solution type : structure, entrée, déplacements
+* @return résultat : nombre de lettres majuscules
+*/
+
+int compter_poussees(t_historique *solution){
+	int nb = 0;
+
+	for (int i = 0; i < solution->nb; i++) {
+		nb += (hist_lire(solution, i) < 'a'); // majuscule : poussée
+	}
+	return nb;
+}
+
+/**
+* @brief résout chaque niveau avec 1, 2, 4... threads jusqu'au nombre de
+* coeurs (ou à la valeur de -j), affiche la durée et l'accélération par
+* rapport à un thread et vérifie que la solution est toujours la même
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, "-echelle [-j N] niveaux..."
+* @return EXIT_SUCCESS si toutes les solutions sont identiques
+*/
+
+int echelle(int argc, char *argv[]){
+	t_arene arene;
+	t_paquet paquet; // recueil de niveaux (fichier.xsb#N)
+	t_solveur solveur;
+	t_historique reference; // solution avec un thread
+	t_historique solution;
+	char **plateau;
+	int hauteur;
+	int largeur;
+	int maxThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	int arg = 2;
+	int resultat;
+	bool identique;
+	bool correct = true;
+	double duree;
+	double dureeUn = 0; // durée avec un thread
+
+	if (argc > 3 && strcmp(argv[2], "-j") == 0) {
+		maxThreads = atoi(argv[3]);
+		arg = 4;
+	}
+	if (maxThreads < 1) {
+		maxThreads = 1;
+	}
+	if (maxThreads > PAR_MAXTHREADS) {
+		maxThreads = PAR_MAXTHREADS;
+	}
+	arene_init(&arene);
+	paquet_init(&paquet);
+	printf("%-20s %7s %10s %12s %12s %8s %s\n", "niveau", "threads", "poussees",
+		"temps(ms)", "noeuds/s", "accel", "solution");
+	for (; arg < argc; arg++) {
+		arene_vider(&arene);
+		hist_init(&reference);
+		if (!paquet_charger(&paquet, argv[arg], &arene, &plateau, &hauteur, &largeur)) {
+			printf("%-20s ERREUR SUR FICHIER\n", argv[arg]);
+			correct = false;
+			continue;
+		}
+		// 1, 2, 4... puis le maximum s'il n'est pas une puissance de 2
+		for (int nb = 1; nb <= maxThreads; nb = (2 * nb > maxThreads) ? maxThreads : 2 * nb) {
+			hist_init(&solution);
+			if (!solv_init(&solveur, plateau, hauteur, largeur, TABLE_MO, MAXNOEUDS)) {
+				printf("%-20s NIVEAU INCORRECT\n", argv[arg]);
+				solv_liberer(&solveur);
+				correct = false;
+				break;
+			}
+			duree = temps_us();
+			resultat = solv_resoudre_parallele(&solveur, nb, &solution);
+			duree = temps_us() - duree;
+			if (nb == 1) {
+				dureeUn = duree;
+				reference = solution;
+				hist_init(&solution);
+			}
+			identique = solution.nb == 0 || solution.nb == reference.nb;
+			for (int i = 0; identique && i < solution.nb; i++) {
+				identique = hist_lire(&solution, i) == hist_lire(&reference, i);
+			}
+			correct = correct && identique && resultat == SOLV_TROUVE;
+			printf("%-20s %7d %10d %12.3f %12.0f %7.2fx %s\n", argv[arg], nb,
+				resultat == SOLV_TROUVE ? compter_poussees(&reference) : -1,
+				duree / 1e3, duree > 0 ? solveur.developpes / (duree / 1e6) : 0.0,
+				duree > 0 ? dureeUn / duree : 0.0,
+				resultat != SOLV_TROUVE ? "ECHEC" : identique ? "identique" : "DIFFERENTE");
+			hist_liberer(&solution);
+			solv_liberer(&solveur);
+			if (nb == maxThreads) {
+				break;
+			}
+		}
+		hist_liberer(&reference);
+	}
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	return correct ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+* @brief résout chaque niveau avec les deux estimations et compare le nombre
+* de noeuds développés et le coût de l'estimation par noeud généré
+* @param argc type : entier, entrée, nombre d'arguments
+* @param argv type : tableau de chaines, entrée, "-estimation niveaux..."
+* @return EXIT_SUCCESS si les deux estimations donnent le même nombre de poussées
+*/
+
+int comparer_estimations(int argc, char *argv[]){
+	const char *noms[] = {"manhattan", "affectation"};
+	t_arene arene;
+	t_paquet paquet; // recueil de niveaux (fichier.xsb#N)
+	t_solveur solveur;
+	t_historique solution;
+	char **plateau;
+	int hauteur;
+	int largeur;
+	int resultat;
+	int poussees[2]; // poussées trouvées avec chaque estimation
+	long developpes[2]; // noeuds développés avec chaque estimation
+	bool correct = true;
+	double duree;
+
+	arene_init(&arene);
+	paquet_init(&paquet);
+	printf("%-20s %-12s %9s %10s %10s %12s %14s %9s\n", "niveau", "estimation", "poussees",
+		"developpes", "generes", "temps(ms)", "estim(ns/noeud)", "reduction");
+	for (int arg = 2; arg < argc; arg++) {
+		arene_vider(&arene);
+		if (!paquet_charger(&paquet, argv[arg], &arene, &plateau, &hauteur, &largeur)) {
+			printf("%-20s ERREUR SUR FICHIER\n", argv[arg]);
+			correct = false;
+			continue;
+		}
+		for (int e = SOLV_MANHATTAN; e <= SOLV_AFFECTATION; e++) {
+			hist_init(&solution);
+			if (!solv_init(&solveur, plateau, hauteur, largeur, TABLE_MO, MAXNOEUDS)) {
+				printf("%-20s NIVEAU INCORRECT\n", argv[arg]);
+				solv_liberer(&solveur);
+				correct = false;
+				break;
+			}
+			solveur.heuristique = e;
+			duree = temps_us();
+			resultat = solv_resoudre(&solveur, &solution);
+			duree = temps_us() - duree;
+			poussees[e] = resultat == SOLV_TROUVE ? compter_poussees(&solution) : -1;
+			developpes[e] = solveur.developpes;
+			printf("%-20s %-12s %9d %10ld %10ld %12.3f %14.1f", argv[arg], noms[e], poussees[e],
+				solveur.developpes, solveur.generes, duree / 1e3,
+				solveur.generes > 0 ? solveur.dureeEstimation * 1e3 / solveur.generes : 0.0);
+			if (e == SOLV_AFFECTATION && developpes[SOLV_MANHATTAN] > 0) {
+				printf(" %8.1f%%", 100.0 * (developpes[SOLV_MANHATTAN] - developpes[e]) / developpes[SOLV_MANHATTAN]);
+				correct = correct && poussees[SOLV_MANHATTAN] == poussees[e];
+			}
+			printf("\n");
+			hist_liberer(&solution);
+			solv_liberer(&solveur);
+		}
+	}
+	arene_liberer(&arene);
+	paquet_fermer(&paquet);
+	return correct ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,999 @@
+/**
+* @file solveur.h
+* @brief Recherche d'une solution optimale (en poussées) d'un niveau de sokoban
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Recherche A* dont chaque étape est une poussée de caisse. Un état est la
+* liste des cases des caisses plus la case du joueur. Les règles sont celles
+* de conditions_dep : une caisse se pousse si le joueur peut atteindre la case
+* derrière elle et si la case devant elle n'est ni un mur ni une autre caisse.
+* Le joueur est ramené au coin de la zone qu'il atteint sans pousser, et
+* chaque noeud garde son état codé en quelques octets (voir etat.h).
+*
+* Chaque état a une clé de Zobrist (ou exclusif d'un nombre aléatoire par
+* caisse et par case du joueur) mise à jour en quatre ou exclusifs à chaque
+* poussée. Les clés déjà vues sont rangées dans une table de transposition de
+* taille fixe. L'estimation est par défaut le coût minimal d'une affectation
+* des caisses aux cibles (voir heuristique.h) ; la somme des distances de
+* Manhattan à la cible la plus proche reste disponible. Les poussées qui mènent à une
+* impasse (case morte ou caisse gelée hors cible, voir impasses.h) ne sont
+* pas générées.
+*
+* La solution est donnée dans la notation des fichiers .dep : g/d/h/b pour
+* un pas du joueur, G/D/H/B pour une poussée, les pas entre deux poussées
+* étant les plus courts possibles.
+*/
+
+#ifndef SOLVEUR_H
+#define SOLVEUR_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "historique.h"
+#include "impasses.h"
+#include "heuristique.h"
+#include "etat.h"
+
+#define SOLV_HAUT 0
+#define SOLV_BAS 1
+#define SOLV_GAUCHE 2
+#define SOLV_DROITE 3
+
+// Résultat d'une recherche.
+#define SOLV_TROUVE 0 // solution trouvée
+#define SOLV_IMPOSSIBLE 1 // tous les états ont été vus, pas de solution
+#define SOLV_LIMITE 2 // limite de noeuds ou de mémoire atteinte
+
+// Estimation du nombre de poussées restantes.
+#define SOLV_MANHATTAN 0 // somme des distances à la cible la plus proche
+#define SOLV_AFFECTATION 1 // affectation optimale des caisses aux cibles
+
+static const char SOLV_PAS[] = "hbgd"; // lettre d'un pas dans chaque direction
+static const char SOLV_POUSSEES[] = "HBGD"; // lettre d'une poussée
+
+//Définition d'une entrée de la table de transposition
+typedef struct{
+	uint64_t cle; // clé de Zobrist de l'état (0 : entrée libre)
+	int g; // plus petit nombre de poussées connu pour cet état
+	int reserve; // alignement sur 16 octets
+} t_entree;
+
+//Définition d'un noeud de la recherche
+typedef struct{
+	uint64_t cle; // clé de Zobrist de l'état
+	int parent; // noeud précédent (-1 pour le départ)
+	int g; // nombre de poussées depuis le départ
+	int h; // estimation du nombre de poussées restantes (0 : état final)
+	int poussee; // 4 * case d'où la dernière caisse a été poussée + direction
+} t_noeud;
+
+//Définition d'un élément de la file de priorité
+typedef struct{
+	int f; // g + h
+	int g; // nombre de poussées
+	int noeud; // indice du noeud
+} t_ouvert;
+
+//Définition d'une poussée possible depuis un état
+typedef struct{
+	int caisse; // indice de la caisse dans la liste de l'état
+	int dir; // direction de la poussée
+} t_poussee;
+
+//Définition d'une poussée dans une solution
+typedef struct{
+	int caisse; // case d'où la caisse est poussée
+	int dir; // direction de la poussée
+} t_etape;
+
+//Définition de la mémoire de travail d'une expansion (une par thread)
+typedef struct{
+	unsigned int *marqueCaisse; // marqueCaisse[case] == tampon : caisse présente
+	unsigned int *marqueVu; // marqueVu[case] == tampon : case atteinte
+	int *file; // file du parcours en largeur
+	int *precedent; // case précédente sur le chemin le plus court
+	int *distance; // nombre de pas depuis le départ du parcours
+	unsigned int tampon; // valeur courante des marques
+	unsigned int *marqueZone; // marqueZone[case] == zone : atteinte par solv_coin
+	unsigned int zone; // valeur courante de marqueZone
+	int *caisses; // caisses de l'état développé, triées
+	int *fils; // caisses d'un état fils, triées
+	t_affectation affectation; // affectation de l'état développé
+} t_travail;
+
+//Définition du niveau vu par le solveur et de l'état de la recherche
+typedef struct{
+	int hauteur; // nombre de lignes
+	int largeur; // nombre de colonnes
+	int nbCases; // hauteur * largeur
+	int nbCaisses; // nombre de caisses
+	int (*voisin)[4]; // case voisine dans chaque direction, -1 si mur ou bord
+	bool *mur; // la case est un mur
+	bool *mortes; // une caisse sur cette case n'atteint plus aucune cible
+	bool *cible; // la case est une cible
+	int *distance; // distance de Manhattan à la cible la plus proche
+	int heuristique; // SOLV_MANHATTAN ou SOLV_AFFECTATION
+	t_heuristique poussees; // distances de poussée vers chaque cible
+	uint64_t *zCaisse; // clé de Zobrist d'une caisse sur chaque case
+	uint64_t *zJoueur; // clé de Zobrist du joueur sur chaque case
+	int *depart; // cases des caisses au départ, triées
+	int joueurDepart; // case du joueur au départ
+	t_codage codage; // codage compact des états
+
+	t_entree *table; // table de transposition
+	uint64_t masque; // nombre d'entrées - 1 (puissance de 2)
+
+	t_noeud *noeuds; // noeuds créés
+	unsigned char *etats; // état codé de chaque noeud (codage.octets par noeud)
+	int nbNoeuds; // nombre de noeuds créés
+	int capacite; // nombre de noeuds alloués
+	int maxNoeuds; // limite du nombre de noeuds
+	t_ouvert *ouverts; // file de priorité (tas binaire)
+	int nbOuverts; // nombre d'éléments de la file
+	int capaciteOuverts; // taille allouée de la file
+
+	t_travail travail; // mémoire de travail du thread principal
+	long developpes; // nombre de noeuds développés
+	long generes; // nombre de noeuds générés
+	double dureeEstimation; // temps passé dans l'estimation (microsecondes)
+} t_solveur;
+
+//Définition du plateau d'un état vu par le test de gel (voir impasses.h)
+typedef struct{
+	const t_solveur *s; // niveau
+	const t_travail *w; // caisses de l'état posées dans les marques
+} t_vue;
+
+/**
+* @brief générateur pseudo-aléatoire splitmix64, pour les clés de Zobrist
+* @param etat type : entier, entrée/sortie, état du générateur
+* @return résultat : nombre aléatoire sur 64 bits
+*/
+
+static inline uint64_t solv_aleatoire(uint64_t *etat){
+	uint64_t z = (*etat += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+/**
+* @brief donne la direction opposée
+* @param dir type : entier, entrée, direction
+* @return résultat : direction opposée
+*/
+
+static inline int solv_oppose(int dir){
+	return dir ^ 1;
+}
+
+/**
+* @brief prépare la mémoire de travail d'une expansion
+* @param w type : structure, sortie, mémoire de travail
+* @param nbCases type : entier, entrée, nombre de cases du niveau
+* @param nbCaisses type : entier, entrée, nombre de caisses
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool solv_travail_init(t_travail *w, int nbCases, int nbCaisses){
+	w->marqueCaisse = calloc(nbCases, sizeof(unsigned int));
+	w->marqueVu = calloc(nbCases, sizeof(unsigned int));
+	w->file = malloc(nbCases * sizeof(int));
+	w->precedent = malloc(nbCases * sizeof(int));
+	w->distance = malloc(nbCases * sizeof(int));
+	w->tampon = 0;
+	w->marqueZone = calloc(nbCases, sizeof(unsigned int));
+	w->zone = 0;
+	w->caisses = malloc((nbCaisses + 1) * sizeof(int));
+	w->fils = malloc((nbCaisses + 1) * sizeof(int));
+	return w->marqueCaisse != NULL && w->marqueVu != NULL && w->file != NULL && w->precedent != NULL &&
+		w->distance != NULL && w->marqueZone != NULL && w->caisses != NULL && w->fils != NULL;
+}
+
+/**
+* @brief libère la mémoire de travail
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @return résultat : mémoire libérée
+*/
+
+static inline void solv_travail_liberer(t_travail *w){
+	affect_liberer(&w->affectation);
+	free(w->marqueCaisse);
+	free(w->marqueVu);
+	free(w->file);
+	free(w->precedent);
+	free(w->distance);
+	free(w->marqueZone);
+	free(w->caisses);
+	free(w->fils);
+}
+
+/**
+* @brief prend une nouvelle valeur de marque : toutes les cases redeviennent
+* sans caisse et non atteintes sans rien effacer
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @param nbCases type : entier, entrée, nombre de cases du niveau
+* @return résultat : marques remises à zéro
+*/
+
+static inline void solv_nouvelle_marque(t_travail *w, int nbCases){
+	w->tampon += 2;
+	if (w->tampon < 2) {
+		// débordement : remise à zéro réelle, très rare
+		memset(w->marqueCaisse, 0, nbCases * sizeof(unsigned int));
+		memset(w->marqueVu, 0, nbCases * sizeof(unsigned int));
+		w->tampon = 2;
+	}
+}
+
+/**
+* @brief pose les caisses d'un état dans les marques
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @param caisses type : tableau, entrée, cases des caisses
+* @return résultat : marques des caisses posées
+*/
+
+static inline void solv_poser_caisses(const t_solveur *s, t_travail *w, const int caisses[]){
+	solv_nouvelle_marque(w, s->nbCases);
+	for (int i = 0; i < s->nbCaisses; i++) {
+		w->marqueCaisse[caisses[i]] = w->tampon;
+	}
+}
+
+/**
+* @brief vérifie qu'une case existe, n'est pas un mur et n'a pas de caisse
+* @param w type : structure, entrée, mémoire de travail (caisses posées)
+* @param c type : entier, entrée, case (-1 pour un mur ou le bord)
+* @return résultat : vrai si la case est libre
+*/
+
+static inline bool solv_libre(const t_travail *w, int c){
+	return c >= 0 && w->marqueCaisse[c] != w->tampon;
+}
+
+/**
+* @brief parcours en largeur des cases que le joueur atteint sans pousser
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail (caisses posées)
+* @param joueur type : entier, entrée, case du joueur
+* @param arrivee type : entier, entrée, case où s'arrêter (-1 : tout parcourir)
+* @return résultat : nombre de cases atteintes, marquées dans marqueVu, avec
+	leur distance au joueur dans distance
+*/
+
+static inline int solv_parcourir(const t_solveur *s, t_travail *w, int joueur, int arrivee){
+	int debut = 0;
+	int fin = 0;
+	int c;
+	int v;
+
+	w->file[fin++] = joueur;
+	w->marqueVu[joueur] = w->tampon;
+	w->precedent[joueur] = -1;
+	w->distance[joueur] = 0;
+	while (debut < fin && (arrivee < 0 || w->marqueVu[arrivee] != w->tampon)) {
+		c = w->file[debut++];
+		for (int d = 0; d < 4; d++) {
+			v = s->voisin[c][d];
+			if (solv_libre(w, v) && w->marqueVu[v] != w->tampon) {
+				w->marqueVu[v] = w->tampon;
+				w->precedent[v] = c;
+				w->distance[v] = w->distance[c] + 1;
+				w->file[fin++] = v;
+			}
+		}
+	}
+	return fin;
+}
+
+/**
+* @brief donne le coin de la zone que le joueur atteint sans pousser : la
+* plus petite case, qui représente toutes les positions de cette zone
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail (caisses posées)
+* @param joueur type : entier, entrée, case du joueur
+* @return résultat : plus petite case atteinte
+*/
+
+static inline int solv_coin(const t_solveur *s, t_travail *w, int joueur){
+	int debut = 0;
+	int fin = 0;
+	int coin = joueur;
+	int c;
+	int v;
+
+	if (++w->zone == 0) {
+		memset(w->marqueZone, 0, s->nbCases * sizeof(unsigned int));
+		w->zone = 1;
+	}
+	w->file[fin++] = joueur;
+	w->marqueZone[joueur] = w->zone;
+	while (debut < fin) {
+		c = w->file[debut++];
+		if (c < coin) {
+			coin = c;
+		}
+		for (int d = 0; d < 4; d++) {
+			v = s->voisin[c][d];
+			if (solv_libre(w, v) && w->marqueZone[v] != w->zone) {
+				w->marqueZone[v] = w->zone;
+				w->file[fin++] = v;
+			}
+		}
+	}
+	return coin;
+}
+
+/**
+* @brief prépare l'état fils d'une poussée depuis l'état posé dans les
+* marques : caisses triées et joueur ramené au coin de sa nouvelle zone
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail (w->caisses posées)
+* @param k type : entier, entrée, indice de la caisse poussée dans w->caisses
+* @param devant type : entier, entrée, case où elle arrive
+* @return résultat : coin de la zone du joueur, caisses du fils dans w->fils
+*/
+
+static inline int solv_fils(const t_solveur *s, t_travail *w, int k, int devant){
+	int caisse = w->caisses[k];
+	int coin;
+
+	memcpy(w->fils, w->caisses, s->nbCaisses * sizeof(int));
+	w->fils[k] = devant;
+	etat_trier(w->fils, s->nbCaisses);
+	// la caisse est déplacée le temps du parcours ; le joueur prend sa place
+	w->marqueCaisse[caisse] = 0;
+	w->marqueCaisse[devant] = w->tampon;
+	coin = solv_coin(s, w, caisse);
+	w->marqueCaisse[devant] = 0;
+	w->marqueCaisse[caisse] = w->tampon;
+	return coin;
+}
+
+/**
+* @brief fonctions de lecture du plateau pour le test de gel
+* @param plateau type : structure, entrée, vue de l'état (t_vue)
+* @param c type : entier, entrée, case
+* @return résultat : vrai si la case est un mur, porte une caisse ou est une cible
+*/
+
+static inline bool solv_vue_mur(const void *plateau, int c){
+	return ((const t_vue *)plateau)->s->mur[c];
+}
+
+static inline bool solv_vue_caisse(const void *plateau, int c){
+	const t_vue *v = plateau;
+	return v->w->marqueCaisse[c] == v->w->tampon;
+}
+
+static inline bool solv_vue_cible(const void *plateau, int c){
+	return ((const t_vue *)plateau)->s->cible[c];
+}
+
+/**
+* @brief vérifie qu'une poussée mène à une impasse : caisse sur une case morte
+* ou gelée hors cible. Les caisses de l'état doivent être posées dans les marques.
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @param caisse type : entier, entrée, case de la caisse poussée
+* @param devant type : entier, entrée, case où elle arrive
+* @return résultat : vrai si la position obtenue est sans issue
+*/
+
+static inline bool solv_impasse(const t_solveur *s, t_travail *w, int caisse, int devant){
+	t_vue vue = {s, w};
+	t_gel gel = {s->largeur, s->nbCases, s->mortes, solv_vue_mur, solv_vue_caisse,
+		solv_vue_cible, &vue, {0}, 0};
+	bool impasse;
+
+	if (s->mortes[devant]) {
+		return true;
+	}
+	// la caisse est déplacée le temps du test
+	w->marqueCaisse[caisse] = 0;
+	w->marqueCaisse[devant] = w->tampon;
+	impasse = impasse_gel(&gel, devant);
+	w->marqueCaisse[devant] = 0;
+	w->marqueCaisse[caisse] = w->tampon;
+	return impasse;
+}
+
+/**
+* @brief vérifie qu'une caisse du départ est déjà sur une case morte
+* @param s type : structure, entrée, solveur
+* @return résultat : vrai si le niveau n'a pas de solution
+*/
+
+static inline bool solv_depart_mort(const t_solveur *s){
+	for (int i = 0; i < s->nbCaisses; i++) {
+		if (s->mortes[s->depart[i]]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+* @brief liste les poussées possibles depuis un état, sans celles qui mènent
+* à une impasse
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @param caisses type : tableau, entrée, cases des caisses de l'état
+* @param joueur type : entier, entrée, case du joueur (n'importe quelle case
+	de sa zone ; w->distance donne ensuite le nombre de pas depuis celle-ci)
+* @param poussees type : tableau, sortie, au plus 4 * nbCaisses poussées
+* @return résultat : nombre de poussées
+*/
+
+static inline int solv_poussees(const t_solveur *s, t_travail *w, const int caisses[],
+	int joueur, t_poussee poussees[]){
+	int nb = 0;
+	int derriere; // case où doit se trouver le joueur
+	int devant; // case où arrive la caisse
+
+	solv_poser_caisses(s, w, caisses);
+	solv_parcourir(s, w, joueur, -1);
+	for (int i = 0; i < s->nbCaisses; i++) {
+		for (int d = 0; d < 4; d++) {
+			derriere = s->voisin[caisses[i]][solv_oppose(d)];
+			devant = s->voisin[caisses[i]][d];
+			if (derriere >= 0 && w->marqueVu[derriere] == w->tampon && solv_libre(w, devant) &&
+				!solv_impasse(s, w, caisses[i], devant)) {
+				poussees[nb].caisse = i;
+				poussees[nb].dir = d;
+				nb++;
+			}
+		}
+	}
+	return nb;
+}
+
+/**
+* @brief prépare le solveur pour un plateau de caractères
+* @param s type : structure, sortie, solveur
+* @param plateau type : tableau, entrée, plateau de caractères
+* @param hauteur type : entier, entrée, nombre de lignes
+* @param largeur type : entier, entrée, nombre de colonnes
+* @param megaOctets type : entier, entrée, taille de la table de transposition
+* @param maxNoeuds type : entier, entrée, nombre maximal de noeuds
+* @return résultat : faux si la mémoire manque ou si le niveau est incohérent
+	(pas de joueur, moins de cibles que de caisses)
+*/
+
+static inline bool solv_init(t_solveur *s, char **plateau, int hauteur, int largeur,
+	int megaOctets, int maxNoeuds){
+	uint64_t graine = 0x5EED50C0BA4ull; // même clés à chaque exécution
+	uint64_t nbEntrees = 1;
+	int nbCibles = 0;
+	int c;
+	int lig2;
+	int col2;
+	int d;
+	char car;
+
+	memset(s, 0, sizeof(t_solveur));
+	s->hauteur = hauteur;
+	s->largeur = largeur;
+	s->nbCases = hauteur * largeur;
+	s->joueurDepart = -1;
+	s->maxNoeuds = maxNoeuds;
+	s->voisin = malloc(s->nbCases * sizeof(*s->voisin));
+	s->mur = calloc(s->nbCases, sizeof(bool));
+	s->mortes = malloc(s->nbCases * sizeof(bool));
+	s->cible = calloc(s->nbCases, sizeof(bool));
+	s->distance = malloc(s->nbCases * sizeof(int));
+	s->zCaisse = malloc(s->nbCases * sizeof(uint64_t));
+	s->zJoueur = malloc(s->nbCases * sizeof(uint64_t));
+	s->depart = malloc(s->nbCases * sizeof(int));
+	if (s->voisin == NULL || s->mur == NULL || s->mortes == NULL || s->cible == NULL || s->distance == NULL ||
+		s->zCaisse == NULL || s->zJoueur == NULL || s->depart == NULL) {
+		return false;
+	}
+
+	for (int lig = 0; lig < hauteur; lig++) {
+		for (int col = 0; col < largeur; col++) {
+			c = lig * largeur + col;
+			car = plateau[lig][col];
+			s->zCaisse[c] = solv_aleatoire(&graine);
+			s->zJoueur[c] = solv_aleatoire(&graine);
+			s->mur[c] = (car == '#');
+			s->cible[c] = (car == '.' || car == '*' || car == '+');
+			nbCibles += s->cible[c];
+			if (car == '$' || car == '*') {
+				s->depart[s->nbCaisses++] = c;
+			}
+			if (car == '@' || car == '+') {
+				s->joueurDepart = c;
+			}
+			for (d = 0; d < 4; d++) {
+				lig2 = lig + (d == SOLV_BAS) - (d == SOLV_HAUT);
+				col2 = col + (d == SOLV_DROITE) - (d == SOLV_GAUCHE);
+				s->voisin[c][d] = -1;
+				if (lig2 >= 0 && lig2 < hauteur && col2 >= 0 && col2 < largeur &&
+					plateau[lig2][col2] != '#') {
+					s->voisin[c][d] = lig2 * largeur + col2;
+				}
+			}
+		}
+	}
+	if (s->joueurDepart < 0 || nbCibles < s->nbCaisses ||
+		!impasse_cases_mortes(plateau, hauteur, largeur, largeur, s->mortes) ||
+		!etat_init(&s->codage, plateau, hauteur, largeur) ||
+		!solv_travail_init(&s->travail, s->nbCases, s->nbCaisses)) {
+		return false;
+	}
+
+	// distance de Manhattan de chaque case à la cible la plus proche, en deux
+	// passes (haut-gauche puis bas-droite) au lieu de comparer toutes les paires
+	for (c = 0; c < s->nbCases; c++) {
+		s->distance[c] = s->cible[c] ? 0 : INT_MAX / 4;
+		if (c >= largeur && s->distance[c - largeur] + 1 < s->distance[c]) {
+			s->distance[c] = s->distance[c - largeur] + 1;
+		}
+		if (c % largeur > 0 && s->distance[c - 1] + 1 < s->distance[c]) {
+			s->distance[c] = s->distance[c - 1] + 1;
+		}
+	}
+	for (c = s->nbCases - 1; c >= 0; c--) {
+		if (c + largeur < s->nbCases && s->distance[c + largeur] + 1 < s->distance[c]) {
+			s->distance[c] = s->distance[c + largeur] + 1;
+		}
+		if (c % largeur < largeur - 1 && s->distance[c + 1] + 1 < s->distance[c]) {
+			s->distance[c] = s->distance[c + 1] + 1;
+		}
+	}
+
+	// table de transposition : la plus grande puissance de 2 qui tient
+	while (nbEntrees * 2 * sizeof(t_entree) <= (uint64_t)megaOctets << 20) {
+		nbEntrees *= 2;
+	}
+	s->masque = nbEntrees - 1;
+	s->table = calloc(nbEntrees, sizeof(t_entree));
+	s->heuristique = SOLV_AFFECTATION;
+	return s->table != NULL && heur_init(&s->poussees, plateau, hauteur, largeur, largeur) &&
+		affect_init(&s->travail.affectation, &s->poussees, s->nbCaisses);
+}
+
+/**
+* @brief libère la mémoire du solveur
+* @param s type : structure, entrée/sortie, solveur
+* @return résultat : mémoire libérée
+*/
+
+static inline void solv_liberer(t_solveur *s){
+	free(s->voisin);
+	free(s->mur);
+	free(s->mortes);
+	free(s->cible);
+	free(s->distance);
+	free(s->zCaisse);
+	free(s->zJoueur);
+	free(s->depart);
+	free(s->table);
+	free(s->noeuds);
+	free(s->etats);
+	free(s->ouverts);
+	heur_liberer(&s->poussees);
+	etat_liberer(&s->codage);
+	solv_travail_liberer(&s->travail);
+}
+
+/**
+* @brief calcule entièrement l'estimation d'un état ; avec l'affectation,
+* celle-ci est gardée pour estimer ensuite chaque poussée depuis cet état
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @param caisses type : tableau, entrée, cases des caisses
+* @return résultat : nombre de poussées estimé, HEUR_INFINI si sans issue
+*/
+
+static inline int solv_estimer(const t_solveur *s, t_travail *w, const int caisses[]){
+	int h = 0;
+
+	if (s->heuristique == SOLV_AFFECTATION) {
+		h = affect_calculer(&w->affectation, caisses);
+		affect_sauver(&w->affectation);
+	}
+	else {
+		for (int i = 0; i < s->nbCaisses; i++) {
+			h += s->distance[caisses[i]];
+		}
+	}
+	return h;
+}
+
+/**
+* @brief estime l'état obtenu par une poussée depuis l'état passé à solv_estimer
+* @param s type : structure, entrée, solveur
+* @param w type : structure, entrée/sortie, mémoire de travail
+* @param hParent type : entier, entrée, estimation de l'état de départ
+* @param k type : entier, entrée, indice de la caisse poussée
+* @param caisse type : entier, entrée, case de la caisse
+* @param devant type : entier, entrée, case où elle arrive
+* @return résultat : nombre de poussées estimé, HEUR_INFINI si sans issue
+*/
+
+static inline int solv_estimer_poussee(const t_solveur *s, t_travail *w, int hParent,
+	int k, int caisse, int devant){
+	int h;
+
+	if (s->heuristique == SOLV_AFFECTATION) {
+		affect_restaurer(&w->affectation);
+		h = affect_deplacer(&w->affectation, k, devant);
+	}
+	else {
+		h = hParent - s->distance[caisse] + s->distance[devant];
+	}
+	return h;
+}
+
+/**
+* @brief donne l'heure courante d'une horloge monotone
+* @return résultat : temps en microsecondes
+*/
+
+static inline double solv_horloge(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+/**
+* @brief consulte et met à jour la table de transposition
+* @param s type : structure, entrée/sortie, solveur
+* @param cle type : entier, entrée, clé de l'état
+* @param g type : entier, entrée, nombre de poussées pour atteindre l'état
+* @return résultat : vrai si l'état est nouveau ou atteint en moins de poussées
+*/
+
+static inline bool solv_table_nouveau(t_solveur *s, uint64_t cle, int g){
+	t_entree *e;
+	t_entree *remplace = NULL; // entrée sacrifiée si les 4 places sont prises
+
+	cle |= 1; // la clé 0 marque une entrée libre
+	for (int essai = 0; essai < 4; essai++) {
+		e = &s->table[(cle + essai) & s->masque];
+		if (e->cle == cle) {
+			if (e->g <= g) {
+				return false;
+			}
+			e->g = g;
+			return true;
+		}
+		if (e->cle == 0) {
+			e->cle = cle;
+			e->g = g;
+			return true;
+		}
+		if (remplace == NULL || e->g > remplace->g) {
+			remplace = e;
+		}
+	}
+	// table pleine à cet endroit : on oublie l'état le plus profond
+	remplace->cle = cle;
+	remplace->g = g;
+	return true;
+}
+
+/**
+* @brief donne le nombre de poussées connu pour un état
+* @param s type : structure, entrée, solveur
+* @param cle type : entier, entrée, clé de l'état
+* @return résultat : nombre de poussées, INT_MAX si l'état a été oublié
+*/
+
+static inline int solv_table_g(const t_solveur *s, uint64_t cle){
+	cle |= 1;
+	for (int essai = 0; essai < 4; essai++) {
+		if (s->table[(cle + essai) & s->masque].cle == cle) {
+			return s->table[(cle + essai) & s->masque].g;
+		}
+	}
+	return INT_MAX;
+}
+
+/**
+* @brief compare deux éléments de la file : plus petit f, puis plus grand g,
+* puis plus ancien noeud (ordre total : la recherche est reproductible)
+* @param a type : structure, entrée, premier élément
+* @param b type : structure, entrée, deuxième élément
+* @return résultat : vrai si a passe avant b
+*/
+
+static inline bool solv_avant(const t_ouvert *a, const t_ouvert *b){
+	if (a->f != b->f) {
+		return a->f < b->f;
+	}
+	if (a->g != b->g) {
+		return a->g > b->g;
+	}
+	return a->noeud < b->noeud;
+}
+
+/**
+* @brief ajoute un élément à la file de priorité
+* @param s type : structure, entrée/sortie, solveur
+* @param o type : structure, entrée, élément
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool solv_empiler(t_solveur *s, t_ouvert o){
+	t_ouvert *ouverts;
+	int i;
+
+	if (s->nbOuverts == s->capaciteOuverts) {
+		s->capaciteOuverts = s->capaciteOuverts ? 2 * s->capaciteOuverts : 1024;
+		ouverts = realloc(s->ouverts, s->capaciteOuverts * sizeof(t_ouvert));
+		if (ouverts == NULL) {
+			return false;
+		}
+		s->ouverts = ouverts;
+	}
+	i = s->nbOuverts++;
+	while (i > 0 && solv_avant(&o, &s->ouverts[(i - 1) / 2])) {
+		s->ouverts[i] = s->ouverts[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	s->ouverts[i] = o;
+	return true;
+}
+
+/**
+* @brief retire le premier élément de la file de priorité
+* @param s type : structure, entrée/sortie, solveur (file non vide)
+* @return résultat : élément retiré
+*/
+
+static inline t_ouvert solv_depiler(t_solveur *s){
+	t_ouvert premier = s->ouverts[0];
+	t_ouvert dernier = s->ouverts[--s->nbOuverts];
+	int i = 0;
+	int enfant;
+
+	while ((enfant = 2 * i + 1) < s->nbOuverts) {
+		if (enfant + 1 < s->nbOuverts && solv_avant(&s->ouverts[enfant + 1], &s->ouverts[enfant])) {
+			enfant++;
+		}
+		if (!solv_avant(&s->ouverts[enfant], &dernier)) {
+			break;
+		}
+		s->ouverts[i] = s->ouverts[enfant];
+		i = enfant;
+	}
+	s->ouverts[i] = dernier;
+	return premier;
+}
+
+/**
+* @brief crée un noeud et réserve la place de son état codé
+* @param s type : structure, entrée/sortie, solveur
+* @return résultat : indice du noeud, -1 si la limite ou la mémoire est atteinte
+*/
+
+static inline int solv_nouveau_noeud(t_solveur *s){
+	t_noeud *noeuds;
+	unsigned char *etats;
+	int capacite;
+
+	if (s->nbNoeuds >= s->maxNoeuds) {
+		return -1;
+	}
+	if (s->nbNoeuds == s->capacite) {
+		capacite = s->capacite ? 2 * s->capacite : 4096;
+		if (capacite > s->maxNoeuds) {
+			capacite = s->maxNoeuds;
+		}
+		noeuds = realloc(s->noeuds, capacite * sizeof(t_noeud));
+		if (noeuds == NULL) {
+			return -1;
+		}
+		s->noeuds = noeuds;
+		etats = realloc(s->etats, (size_t)capacite * s->codage.octets + 1);
+		if (etats == NULL) {
+			return -1;
+		}
+		s->etats = etats;
+		s->capacite = capacite;
+	}
+	return s->nbNoeuds++;
+}
+
+/**
+* @brief écrit les déplacements d'une suite de poussées : pour chaque poussée,
+* le plus court chemin du joueur jusque derrière la caisse puis la poussée
+* @param s type : structure, entrée/sortie, solveur
+* @param etapes type : tableau, entrée, poussées depuis le départ
+* @param nbEtapes type : entier, entrée, nombre de poussées
+* @param solution type : structure, sortie, déplacements (g/d/h/b/G/D/H/B)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool solv_ecrire_etapes(t_solveur *s, const t_etape etapes[], int nbEtapes,
+	t_historique *solution){
+	t_travail *w = &s->travail;
+	int *caisses = malloc((s->nbCaisses + 1) * sizeof(int));
+	char *pas = malloc(s->nbCases + 1); // pas du joueur, à l'envers
+	int nbPas;
+	int joueur = s->joueurDepart;
+	int derriere;
+	int c;
+	bool ok = caisses != NULL && pas != NULL;
+
+	if (ok) {
+		memcpy(caisses, s->depart, s->nbCaisses * sizeof(int));
+	}
+	for (int i = 0; ok && i < nbEtapes; i++) {
+		derriere = s->voisin[etapes[i].caisse][solv_oppose(etapes[i].dir)];
+		solv_poser_caisses(s, w, caisses);
+		solv_parcourir(s, w, joueur, derriere);
+		nbPas = 0;
+		for (c = derriere; w->precedent[c] >= 0; c = w->precedent[c]) {
+			for (int d = 0; d < 4; d++) {
+				if (s->voisin[w->precedent[c]][d] == c) {
+					pas[nbPas++] = SOLV_PAS[d];
+				}
+			}
+		}
+		while (nbPas > 0) {
+			ok = ok && hist_ajouter(solution, pas[--nbPas]);
+		}
+		ok = ok && hist_ajouter(solution, SOLV_POUSSEES[etapes[i].dir]);
+		// la caisse avance, le joueur prend sa place
+		for (int k = 0; k < s->nbCaisses; k++) {
+			if (caisses[k] == etapes[i].caisse) {
+				caisses[k] = s->voisin[etapes[i].caisse][etapes[i].dir];
+			}
+		}
+		joueur = etapes[i].caisse;
+	}
+	free(caisses);
+	free(pas);
+	return ok;
+}
+
+/**
+* @brief écrit les déplacements qui mènent du départ au noeud final
+* @param s type : structure, entrée/sortie, solveur
+* @param final type : entier, entrée, noeud final
+* @param solution type : structure, sortie, déplacements (g/d/h/b/G/D/H/B)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool solv_solution(t_solveur *s, int final, t_historique *solution){
+	int nbEtapes = s->noeuds[final].g;
+	t_etape *etapes = malloc((nbEtapes + 1) * sizeof(t_etape));
+	bool ok = etapes != NULL;
+
+	for (int n = final, i = nbEtapes - 1; ok && i >= 0; n = s->noeuds[n].parent, i--) {
+		etapes[i].caisse = s->noeuds[n].poussee / 4;
+		etapes[i].dir = s->noeuds[n].poussee % 4;
+	}
+	ok = ok && solv_ecrire_etapes(s, etapes, nbEtapes, solution);
+	free(etapes);
+	return ok;
+}
+
+/**
+* @brief recherche A* d'une solution avec le moins de poussées possible
+* @param s type : structure, entrée/sortie, solveur préparé par solv_init
+* @param solution type : structure, sortie, déplacements de la solution
+* @return résultat : SOLV_TROUVE, SOLV_IMPOSSIBLE ou SOLV_LIMITE
+*/
+
+static inline int solv_resoudre(t_solveur *s, t_historique *solution){
+	t_poussee *poussees = malloc((4 * s->nbCaisses + 1) * sizeof(t_poussee));
+	t_travail *w = &s->travail;
+	t_noeud parent;
+	t_noeud *fils;
+	t_ouvert o;
+	uint64_t cle;
+	int nbPoussees;
+	int n;
+	int courant; // noeud développé
+	int joueur; // coin de la zone du joueur dans l'état développé
+	int coin; // coin de la zone du joueur dans un fils
+	int caisse; // case de la caisse poussée
+	int devant; // case où arrive la caisse
+	int h; // estimation d'un fils
+	int resultat = SOLV_IMPOSSIBLE;
+	double debut;
+
+	if (solv_depart_mort(s)) {
+		free(poussees);
+		return SOLV_IMPOSSIBLE;
+	}
+	n = solv_nouveau_noeud(s);
+	if (poussees == NULL || n < 0) {
+		free(poussees);
+		return SOLV_LIMITE;
+	}
+	solv_poser_caisses(s, w, s->depart);
+	joueur = solv_coin(s, w, s->joueurDepart);
+	etat_coder(&s->codage, s->depart, joueur, s->etats);
+	fils = &s->noeuds[n];
+	fils->parent = -1;
+	fils->g = 0;
+	fils->poussee = -1;
+	fils->cle = s->zJoueur[joueur];
+	for (int i = 0; i < s->nbCaisses; i++) {
+		fils->cle ^= s->zCaisse[s->depart[i]];
+	}
+	fils->h = solv_estimer(s, w, s->depart);
+	if (fils->h >= HEUR_INFINI) {
+		free(poussees);
+		return SOLV_IMPOSSIBLE;
+	}
+	solv_table_nouveau(s, fils->cle, 0);
+	o.f = fils->h;
+	o.g = 0;
+	o.noeud = n;
+	solv_empiler(s, o);
+
+	while (s->nbOuverts > 0 && resultat == SOLV_IMPOSSIBLE) {
+		courant = solv_depiler(s).noeud;
+		parent = s->noeuds[courant];
+		// état retrouvé depuis avec moins de poussées : déjà développé
+		if (solv_table_g(s, parent.cle) < parent.g) {
+			continue;
+		}
+		// l'estimation n'est nulle que si toutes les caisses sont sur une cible
+		if (parent.h == 0) {
+			resultat = solv_solution(s, courant, solution) ? SOLV_TROUVE : SOLV_LIMITE;
+			continue;
+		}
+		s->developpes++;
+		etat_decoder(&s->codage, &s->etats[(size_t)courant * s->codage.octets], w->caisses, &joueur);
+		nbPoussees = solv_poussees(s, w, w->caisses, joueur, poussees);
+		debut = solv_horloge();
+		if (nbPoussees > 0) {
+			solv_estimer(s, w, w->caisses);
+		}
+		s->dureeEstimation += solv_horloge() - debut;
+		for (int p = 0; p < nbPoussees && resultat == SOLV_IMPOSSIBLE; p++) {
+			caisse = w->caisses[poussees[p].caisse];
+			devant = s->voisin[caisse][poussees[p].dir];
+			coin = solv_fils(s, w, poussees[p].caisse, devant);
+			cle = parent.cle ^ s->zCaisse[caisse] ^ s->zCaisse[devant] ^
+				s->zJoueur[joueur] ^ s->zJoueur[coin];
+			if (!solv_table_nouveau(s, cle, parent.g + 1)) {
+				continue;
+			}
+			debut = solv_horloge();
+			h = solv_estimer_poussee(s, w, parent.h, poussees[p].caisse, caisse, devant);
+			s->dureeEstimation += solv_horloge() - debut;
+			if (h >= HEUR_INFINI) {
+				continue; // aucune affectation possible : impasse
+			}
+			n = solv_nouveau_noeud(s);
+			if (n < 0) {
+				resultat = SOLV_LIMITE;
+				continue;
+			}
+			s->generes++;
+			fils = &s->noeuds[n];
+			fils->cle = cle;
+			fils->parent = courant;
+			fils->g = parent.g + 1;
+			fils->h = h;
+			fils->poussee = 4 * caisse + poussees[p].dir;
+			etat_coder(&s->codage, w->fils, coin, &s->etats[(size_t)n * s->codage.octets]);
+			o.f = fils->g + fils->h;
+			o.g = fils->g;
+			o.noeud = n;
+			if (!solv_empiler(s, o)) {
+				resultat = SOLV_LIMITE;
+			}
+		}
+	}
+	free(poussees);
+	return resultat;
+}
+
+#endif
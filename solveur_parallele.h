@@ -0,0 +1,847 @@
+/**
+* @file solveur_parallele.h
+* @brief Recherche d'une solution optimale sur plusieurs threads
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Chaque thread possède une tranche des états, choisie par la clé de Zobrist
+* (voir solveur.h). La recherche avance par seaux (f, g), f croissant puis g
+* décroissant comme solv_avant. Un tour compte deux barrières : chaque thread
+* publie le premier seau de sa tranche et ses états triés, puis, après la
+* première, tous développent les états du plus petit de ces seaux et envoient
+* chaque état fils au thread qui le possède par une boîte aux lettres sans
+* verrou (pile de Treiber). Après la seconde, chaque thread range les fils
+* reçus dans sa tranche.
+*
+* L'estimation est cohérente (une poussée la fait baisser d'un au plus), donc le
+* premier seau qui contient un état final donne le plus petit nombre de
+* poussées. À f égal, les états les plus avancés passent d'abord : un état
+* final (h = 0) est dans le seau (f, f), le premier de sa couche, et la
+* recherche plonge vers lui au lieu de développer toute la couche f avant.
+*
+* Chaque état garde le nombre de déplacements (pas et poussées) du chemin qui
+* l'a atteint. Un tour ne développe qu'au plus PAR_LARGEUR états du seau, ceux
+* qui en comptent le moins (puis de plus petites clés) sur l'ensemble des
+* tranches ; les autres restent à développer. Sinon chaque seau d'une couche
+* contiendrait tous les ordres possibles des mêmes poussées, et la recherche
+* serait un parcours en largeur de la couche là où solv_resoudre n'en suit
+* qu'un chemin. PAR_LARGEUR ne dépend pas du nombre de threads, sinon la
+* solution en dépendrait ; il est assez grand pour que chaque thread ait des
+* dizaines d'états à développer entre deux barrières, au prix de plus d'états
+* développés qu'avec un tour étroit. Quand un état est atteint par plusieurs parents avec le même
+* nombre de poussées, on garde celui qui compte le moins de déplacements, puis
+* le parent de plus petite clé. L'état final retenu suit le même ordre. Le
+* résultat ne dépend donc ni du nombre de threads ni de l'ordre d'arrivée des
+* messages.
+*
+* Les barrières sont faites avec un verrou et une condition, car
+* pthread_barrier_t n'existe pas sous macOS.
+*/
+
+#ifndef SOLVEUR_PARALLELE_H
+#define SOLVEUR_PARALLELE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "niveau.h"
+#include "solveur.h"
+
+#define PAR_MAXTHREADS 256
+#define PAR_LARGEUR 256 // états développés au plus par tour, tous threads compris
+
+//Définition d'une barrière réutilisable
+typedef struct{
+	pthread_mutex_t verrou;
+	pthread_cond_t condition;
+	int nb; // nombre de threads attendus
+	int arrives; // threads arrivés au tour courant
+	unsigned long generation; // numéro du tour
+} t_barriere;
+
+//Définition d'un état envoyé au thread qui le possède
+typedef struct t_message{
+	struct t_message *suivant; // message suivant dans la boîte
+	uint64_t cle; // clé de l'état
+	uint64_t cleParent; // clé de l'état précédent
+	int g; // nombre de poussées
+	int h; // estimation
+	int coups; // déplacements depuis le départ, pas et poussées
+	int poussee; // 4 * case d'où la caisse a été poussée + direction
+	unsigned char etat[]; // état codé (voir etat.h)
+} t_message;
+
+//Définition d'un état rangé dans une tranche
+typedef struct{
+	uint64_t cle; // clé de l'état
+	uint64_t cleParent; // clé de l'état précédent
+	int g; // plus petit nombre de poussées connu
+	int h; // estimation (0 : état final)
+	int coups; // déplacements depuis le départ par le parent retenu
+	int poussee; // 4 * case d'où la dernière caisse a été poussée + direction
+} t_etat;
+
+//Définition de la tranche d'états d'un thread
+typedef struct{
+	t_etat *etats; // états de la tranche
+	unsigned char *codes; // état codé de chaque état (voir etat.h)
+	int nb; // nombre d'états
+	int capacite; // nombre d'états alloués
+	int *table; // indices des états par clé (-1 : place libre)
+	uint64_t masque; // taille de la table - 1
+	t_ouvert *ouverts; // états à développer, par seau (f croissant, g décroissant)
+	int nbOuverts; // nombre d'états à développer
+	int capaciteOuverts; // taille allouée
+	_Atomic(t_message *) boite; // états reçus des autres threads
+} t_tranche;
+
+//Définition d'un état du seau courant
+typedef struct{
+	uint64_t cle; // clé de l'état
+	int coups; // déplacements depuis le départ
+	int noeud; // indice dans la tranche
+} t_candidat;
+
+//Définition d'un seau de la recherche
+typedef struct{
+	int f; // g + h
+	int g; // nombre de poussées
+} t_seau;
+
+//Définition de la recherche partagée par les threads
+typedef struct{
+	t_solveur *s; // niveau, en lecture seule pendant la recherche
+	int nbThreads; // nombre de threads
+	t_tranche tranches[PAR_MAXTHREADS]; // une tranche par thread
+	t_seau seaux[PAR_MAXTHREADS]; // premier seau de chaque tranche
+	t_candidat *candidats[PAR_MAXTHREADS]; // états du seau de chaque tranche, dans l'ordre de par_candidat_avant
+	int nbCandidats[PAR_MAXTHREADS]; // nombre d'états du seau de chaque tranche
+	bool manques[PAR_MAXTHREADS]; // la mémoire a manqué à ce thread
+	t_barriere barriere;
+	atomic_long nbEtats; // nombre total d'états rangés
+	atomic_long developpes; // états développés
+	atomic_long generes; // états envoyés
+	int resultat; // SOLV_TROUVE, SOLV_IMPOSSIBLE ou SOLV_LIMITE
+	uint64_t cleBut; // clé de l'état final retenu
+} t_recherche;
+
+//Définition d'un thread de la recherche
+typedef struct{
+	t_recherche *r; // recherche partagée
+	int id; // numéro du thread et de sa tranche
+	t_travail travail; // mémoire de travail des expansions
+	t_arene arene; // messages envoyés pendant le tour
+	t_poussee *poussees; // poussées d'un état
+	t_candidat *seau; // états du seau courant, dans l'ordre de par_candidat_avant
+	int capaciteSeau; // taille allouée
+	long generes; // états envoyés par ce thread
+} t_chercheur;
+
+/**
+* @brief prépare une barrière
+* @param b type : structure, sortie, barrière
+* @param nb type : entier, entrée, nombre de threads attendus
+* @return résultat : barrière prête
+*/
+
+static inline void barriere_init(t_barriere *b, int nb){
+	pthread_mutex_init(&b->verrou, NULL);
+	pthread_cond_init(&b->condition, NULL);
+	b->nb = nb;
+	b->arrives = 0;
+	b->generation = 0;
+}
+
+/**
+* @brief détruit une barrière
+* @param b type : structure, entrée/sortie, barrière
+* @return résultat : barrière détruite
+*/
+
+static inline void barriere_detruire(t_barriere *b){
+	pthread_mutex_destroy(&b->verrou);
+	pthread_cond_destroy(&b->condition);
+}
+
+/**
+* @brief attend que tous les threads soient arrivés à la barrière
+* @param b type : structure, entrée/sortie, barrière
+* @return résultat : tous les threads sont passés
+*/
+
+static inline void barriere_attendre(t_barriere *b){
+	unsigned long generation;
+
+	pthread_mutex_lock(&b->verrou);
+	generation = b->generation;
+	if (++b->arrives == b->nb) {
+		b->arrives = 0;
+		b->generation++;
+		pthread_cond_broadcast(&b->condition);
+	}
+	else {
+		while (generation == b->generation) {
+			pthread_cond_wait(&b->condition, &b->verrou);
+		}
+	}
+	pthread_mutex_unlock(&b->verrou);
+}
+
+/**
+* @brief donne le thread qui possède un état
+* @param cle type : entier, entrée, clé de l'état
+* @param nbThreads type : entier, entrée, nombre de threads
+* @return résultat : numéro du thread
+*/
+
+static inline int par_proprietaire(uint64_t cle, int nbThreads){
+	// bits de poids fort : les bits de poids faible servent aux tables
+	return (int)((cle >> 32) % (uint64_t)nbThreads);
+}
+
+/**
+* @brief compare deux seaux
+* @param a type : structure, entrée, premier seau
+* @param b type : structure, entrée, deuxième seau
+* @return résultat : vrai si a passe avant b
+*/
+
+static inline bool par_seau_avant(t_seau a, t_seau b){
+	return a.f < b.f || (a.f == b.f && a.g > b.g);
+}
+
+/**
+* @brief compare deux éléments de la file d'une tranche : plus petit f, puis
+* plus grand g
+* @param a type : structure, entrée, premier élément
+* @param b type : structure, entrée, deuxième élément
+* @return résultat : vrai si a passe avant b
+*/
+
+static inline bool par_avant(const t_ouvert *a, const t_ouvert *b){
+	return a->f < b->f || (a->f == b->f && a->g > b->g);
+}
+
+/**
+* @brief ajoute un état à la file d'une tranche
+* @param t type : structure, entrée/sortie, tranche
+* @param o type : structure, entrée, élément
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool par_empiler(t_tranche *t, t_ouvert o){
+	t_ouvert *ouverts;
+	int i;
+
+	if (t->nbOuverts == t->capaciteOuverts) {
+		t->capaciteOuverts = t->capaciteOuverts ? 2 * t->capaciteOuverts : 1024;
+		ouverts = realloc(t->ouverts, t->capaciteOuverts * sizeof(t_ouvert));
+		if (ouverts == NULL) {
+			return false;
+		}
+		t->ouverts = ouverts;
+	}
+	i = t->nbOuverts++;
+	while (i > 0 && par_avant(&o, &t->ouverts[(i - 1) / 2])) {
+		t->ouverts[i] = t->ouverts[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	t->ouverts[i] = o;
+	return true;
+}
+
+/**
+* @brief retire le premier élément de la file d'une tranche
+* @param t type : structure, entrée/sortie, tranche (file non vide)
+* @return résultat : élément retiré
+*/
+
+static inline t_ouvert par_depiler(t_tranche *t){
+	t_ouvert premier = t->ouverts[0];
+	t_ouvert dernier = t->ouverts[--t->nbOuverts];
+	int i = 0;
+	int enfant;
+
+	while ((enfant = 2 * i + 1) < t->nbOuverts) {
+		if (enfant + 1 < t->nbOuverts && par_avant(&t->ouverts[enfant + 1], &t->ouverts[enfant])) {
+			enfant++;
+		}
+		if (!par_avant(&t->ouverts[enfant], &dernier)) {
+			break;
+		}
+		t->ouverts[i] = t->ouverts[enfant];
+		i = enfant;
+	}
+	t->ouverts[i] = dernier;
+	return premier;
+}
+
+/**
+* @brief cherche un état dans une tranche
+* @param t type : structure, entrée, tranche
+* @param cle type : entier, entrée, clé de l'état
+* @return résultat : indice de l'état, -1 s'il n'y est pas
+*/
+
+static inline int par_chercher(const t_tranche *t, uint64_t cle){
+	uint64_t i;
+
+	if (t->table == NULL) {
+		return -1;
+	}
+	for (i = cle & t->masque; t->table[i] >= 0; i = (i + 1) & t->masque) {
+		if (t->etats[t->table[i]].cle == cle) {
+			return t->table[i];
+		}
+	}
+	return -1;
+}
+
+/**
+* @brief range l'indice d'un état dans la table, en la doublant si elle est
+* à moitié pleine
+* @param t type : structure, entrée/sortie, tranche
+* @param e type : entier, entrée, indice de l'état (déjà dans t->etats)
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool par_indexer(t_tranche *t, int e){
+	uint64_t taille = t->table ? t->masque + 1 : 0;
+	uint64_t i;
+	int *table;
+
+	if (2 * (uint64_t)t->nb > taille) {
+		taille = taille ? 2 * taille : 4096;
+		table = malloc(taille * sizeof(int));
+		if (table == NULL) {
+			return false;
+		}
+		memset(table, 0xFF, taille * sizeof(int));
+		free(t->table);
+		t->table = table;
+		t->masque = taille - 1;
+		// les états déjà rangés, sauf le nouveau qui est ajouté plus bas
+		for (int k = 0; k < t->nb; k++) {
+			if (k != e) {
+				for (i = t->etats[k].cle & t->masque; t->table[i] >= 0; i = (i + 1) & t->masque);
+				t->table[i] = k;
+			}
+		}
+	}
+	for (i = t->etats[e].cle & t->masque; t->table[i] >= 0; i = (i + 1) & t->masque);
+	t->table[i] = e;
+	return true;
+}
+
+/**
+* @brief compare deux façons d'atteindre un état : moins de poussées, puis
+* moins de déplacements, puis parent de plus petite clé, puis plus petite
+* poussée (ordre total : le parent retenu ne dépend pas de l'ordre d'arrivée)
+* @param g type : entier, entrée, poussées de la première
+* @param coups type : entier, entrée, déplacements de la première
+* @param cleParent type : entier, entrée, parent de la première
+* @param poussee type : entier, entrée, dernière poussée de la première
+* @param e type : structure, entrée, état rangé (la seconde)
+* @return résultat : vrai si la première passe avant celle de l'état rangé
+*/
+
+static inline bool par_parent_avant(int g, int coups, uint64_t cleParent, int poussee, const t_etat *e){
+	if (g != e->g) {
+		return g < e->g;
+	}
+	if (coups != e->coups) {
+		return coups < e->coups;
+	}
+	if (cleParent != e->cleParent) {
+		return cleParent < e->cleParent;
+	}
+	return poussee < e->poussee;
+}
+
+/**
+* @brief range un état reçu dans une tranche : nouvel état, ou meilleure façon
+* de l'atteindre au sens de par_parent_avant
+* @param t type : structure, entrée/sortie, tranche
+* @param m type : structure, entrée, état reçu
+* @param octets type : entier, entrée, taille d'un état codé
+* @param nbEtats type : entier, entrée/sortie, compteur global des états
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool par_recevoir(t_tranche *t, const t_message *m, int octets, atomic_long *nbEtats){
+	t_etat *etats;
+	unsigned char *codes;
+	t_etat *e;
+	t_ouvert o;
+	int i = par_chercher(t, m->cle);
+
+	if (i >= 0) {
+		e = &t->etats[i];
+		if (!par_parent_avant(m->g, m->coups, m->cleParent, m->poussee, e)) {
+			return true;
+		}
+		e->cleParent = m->cleParent;
+		e->coups = m->coups;
+		e->poussee = m->poussee;
+		if (m->g == e->g) {
+			return true; // déjà dans la file avec ce nombre de poussées
+		}
+		e->g = m->g;
+	}
+	else {
+		if (t->nb == t->capacite) {
+			t->capacite = t->capacite ? 2 * t->capacite : 1024;
+			etats = realloc(t->etats, t->capacite * sizeof(t_etat));
+			if (etats == NULL) {
+				return false;
+			}
+			t->etats = etats;
+			codes = realloc(t->codes, (size_t)t->capacite * octets + 1);
+			if (codes == NULL) {
+				return false;
+			}
+			t->codes = codes;
+		}
+		i = t->nb++;
+		e = &t->etats[i];
+		e->cle = m->cle;
+		e->cleParent = m->cleParent;
+		e->g = m->g;
+		e->h = m->h;
+		e->coups = m->coups;
+		e->poussee = m->poussee;
+		memcpy(&t->codes[(size_t)i * octets], m->etat, octets);
+		if (!par_indexer(t, i)) {
+			return false;
+		}
+		atomic_fetch_add(nbEtats, 1);
+	}
+	o.f = e->g + e->h;
+	o.g = e->g;
+	o.noeud = i;
+	return par_empiler(t, o);
+}
+
+/**
+* @brief vérifie qu'un état fils mérite d'être envoyé : pendant les expansions
+* aucune tranche n'est modifiée, donc tous les threads peuvent les lire
+* @param r type : structure, entrée, recherche
+* @param cle type : entier, entrée, clé du fils
+* @param g type : entier, entrée, nombre de poussées du fils
+* @param coups type : entier, entrée, déplacements du fils
+* @param cleParent type : entier, entrée, clé du parent
+* @param poussee type : entier, entrée, poussée qui mène au fils
+* @return résultat : faux si le fils est déjà connu avec un aussi bon parent
+*/
+
+static inline bool par_utile(const t_recherche *r, uint64_t cle, int g, int coups, uint64_t cleParent, int poussee){
+	const t_tranche *t = &r->tranches[par_proprietaire(cle, r->nbThreads)];
+	int i = par_chercher(t, cle);
+
+	return i < 0 || par_parent_avant(g, coups, cleParent, poussee, &t->etats[i]);
+}
+
+/**
+* @brief développe un état : chaque fils est envoyé à la boîte de son thread.
+* Le joueur est sur la case d'où il a poussé la dernière caisse : les pas
+* jusqu'à chaque poussée se comptent depuis cette case.
+* @param c type : structure, entrée/sortie, thread de recherche
+* @param i type : entier, entrée, indice de l'état dans la tranche du thread
+* @return résultat : faux si la mémoire manque
+*/
+
+static inline bool par_developper(t_chercheur *c, int i){
+	t_recherche *r = c->r;
+	const t_solveur *s = r->s;
+	const t_etat *e = &r->tranches[c->id].etats[i];
+	t_travail *w = &c->travail;
+	_Atomic(t_message *) *boite;
+	t_message *m;
+	uint64_t cle;
+	int nbPoussees;
+	int joueur = -1;
+	int coin;
+	int caisse;
+	int devant;
+	int h;
+	int coups; // déplacements du fils
+	int poussee;
+
+	etat_decoder(&s->codage, &r->tranches[c->id].codes[(size_t)i * s->codage.octets], w->caisses, &joueur);
+	nbPoussees = solv_poussees(s, w, w->caisses, e->poussee >= 0 ? e->poussee / 4 : s->joueurDepart,
+		c->poussees);
+	if (nbPoussees > 0) {
+		solv_estimer(s, w, w->caisses);
+	}
+	for (int p = 0; p < nbPoussees; p++) {
+		caisse = w->caisses[c->poussees[p].caisse];
+		devant = s->voisin[caisse][c->poussees[p].dir];
+		coin = solv_fils(s, w, c->poussees[p].caisse, devant);
+		cle = e->cle ^ s->zCaisse[caisse] ^ s->zCaisse[devant] ^
+			s->zJoueur[joueur] ^ s->zJoueur[coin];
+		coups = e->coups + w->distance[s->voisin[caisse][solv_oppose(c->poussees[p].dir)]] + 1;
+		poussee = 4 * caisse + c->poussees[p].dir;
+		if (!par_utile(r, cle, e->g + 1, coups, e->cle, poussee)) {
+			continue;
+		}
+		h = solv_estimer_poussee(s, w, e->h, c->poussees[p].caisse, caisse, devant);
+		if (h >= HEUR_INFINI) {
+			continue;
+		}
+		m = arene_allouer(&c->arene, sizeof(t_message) + s->codage.octets);
+		if (m == NULL) {
+			return false;
+		}
+		m->cle = cle;
+		m->cleParent = e->cle;
+		m->g = e->g + 1;
+		m->h = h;
+		m->coups = coups;
+		m->poussee = poussee;
+		etat_coder(&s->codage, w->fils, coin, m->etat);
+		// pile de Treiber : seuls des ajouts ont lieu pendant les expansions
+		boite = &r->tranches[par_proprietaire(cle, r->nbThreads)].boite;
+		m->suivant = atomic_load(boite);
+		while (!atomic_compare_exchange_weak(boite, &m->suivant, m));
+		c->generes++;
+	}
+	return true;
+}
+
+/**
+* @brief compare deux états d'un seau : moins de déplacements, puis plus
+* petite clé (une clé n'est que dans une tranche : ordre total)
+* @param a type : structure, entrée, premier état
+* @param b type : structure, entrée, deuxième état
+* @return résultat : vrai si a passe avant b
+*/
+
+static inline bool par_candidat_avant(const t_candidat *a, const t_candidat *b){
+	return a->coups < b->coups || (a->coups == b->coups && a->cle < b->cle);
+}
+
+/**
+* @brief compare deux états du seau, pour qsort
+* @param a type : pointeur, entrée, premier état (t_candidat)
+* @param b type : pointeur, entrée, deuxième état (t_candidat)
+* @return résultat : négatif, nul ou positif
+*/
+
+static inline int par_comparer(const void *a, const void *b){
+	return par_candidat_avant(b, a) - par_candidat_avant(a, b);
+}
+
+/**
+* @brief donne le dernier des PAR_LARGEUR premiers états du seau, toutes
+* tranches comprises. Chaque thread fait le même calcul sur les mêmes listes
+* et trouve le même état.
+* @param r type : structure, entrée, recherche (listes triées publiées)
+* @param seau type : structure, entrée, seau du tour (les tranches dont le
+* premier seau est plus loin n'y ont aucun état)
+* @param seuil type : structure, sortie, dernier état développé pendant le tour
+* @return résultat : faux si le seau tient dans un tour
+*/
+
+static inline bool par_seuil(const t_recherche *r, t_seau seau, t_candidat *seuil){
+	int positions[PAR_MAXTHREADS] = {0};
+	int choisi;
+
+	for (int n = 0; n < PAR_LARGEUR; n++) {
+		choisi = -1;
+		for (int k = 0; k < r->nbThreads; k++) {
+			if (r->seaux[k].f != seau.f || r->seaux[k].g != seau.g) {
+				continue;
+			}
+			if (positions[k] < r->nbCandidats[k] && (choisi < 0 ||
+				par_candidat_avant(&r->candidats[k][positions[k]], &r->candidats[choisi][positions[choisi]]))) {
+				choisi = k;
+			}
+		}
+		if (choisi < 0) {
+			return false; // moins de PAR_LARGEUR états : tout le seau
+		}
+		*seuil = r->candidats[choisi][positions[choisi]++];
+	}
+	return true;
+}
+
+/**
+* @brief boucle d'un thread de recherche
+* @param arg type : structure, entrée/sortie, thread de recherche (t_chercheur)
+* @return résultat : NULL
+*/
+
+static inline void *par_chercher_seaux(void *arg){
+	t_chercheur *c = arg;
+	t_recherche *r = c->r;
+	t_tranche *t = &r->tranches[c->id];
+	t_seau vide = {INT_MAX, INT_MAX};
+	t_seau seau; // seau du tour, le même pour tous les threads
+	t_seau local; // premier seau de la tranche
+	t_ouvert o;
+	t_message *m;
+	t_candidat *agrandi;
+	t_candidat seuil; // dernier état développé pendant le tour
+	t_candidat but; // état final retenu
+	t_candidat aucun = {UINT64_MAX, INT_MAX, -1};
+	bool limite; // le seau ne tient pas dans le tour
+	int nbSeau;
+	int nbDeveloppes;
+	int resultat;
+	long developpes = 0;
+	bool manque = false; // publié au tour suivant avec le premier seau
+
+	// Chaque valeur partagée est écrite avant une barrière et lue après par
+	// tous les threads, qui prennent donc tous les mêmes décisions.
+	while (true) {
+		// états du premier seau de la tranche, sans ceux retrouvés depuis avec
+		// moins de poussées ; publiés avec ce seau avant la même barrière
+		seau = t->nbOuverts > 0 ? (t_seau){t->ouverts[0].f, t->ouverts[0].g} : vide;
+		nbSeau = 0;
+		while (t->nbOuverts > 0 && t->ouverts[0].f == seau.f && t->ouverts[0].g == seau.g) {
+			o = par_depiler(t);
+			if (t->etats[o.noeud].g != o.g) {
+				continue;
+			}
+			if (nbSeau == c->capaciteSeau) {
+				c->capaciteSeau = c->capaciteSeau ? 2 * c->capaciteSeau : 1024;
+				agrandi = realloc(c->seau, c->capaciteSeau * sizeof(t_candidat));
+				if (agrandi == NULL) {
+					manque = true;
+					break;
+				}
+				c->seau = agrandi;
+			}
+			c->seau[nbSeau].cle = t->etats[o.noeud].cle;
+			c->seau[nbSeau].coups = t->etats[o.noeud].coups;
+			c->seau[nbSeau++].noeud = o.noeud;
+		}
+		if (nbSeau > 1) {
+			qsort(c->seau, nbSeau, sizeof(t_candidat), par_comparer);
+		}
+		r->seaux[c->id] = seau;
+		r->candidats[c->id] = c->seau;
+		r->nbCandidats[c->id] = nbSeau;
+		r->manques[c->id] = manque;
+		barriere_attendre(&r->barriere);
+
+		// plus petit seau de toutes les tranches : le même pour tous les threads
+		local = seau;
+		seau = vide;
+		for (int k = 0; k < r->nbThreads; k++) {
+			if (par_seau_avant(r->seaux[k], seau)) {
+				seau = r->seaux[k];
+			}
+		}
+		resultat = seau.f == INT_MAX ? SOLV_IMPOSSIBLE : -1;
+		for (int k = 0; k < r->nbThreads; k++) {
+			if (r->manques[k]) {
+				resultat = SOLV_LIMITE;
+			}
+		}
+		if (atomic_load(&r->nbEtats) > r->s->maxNoeuds) {
+			resultat = SOLV_LIMITE;
+		}
+		if (resultat >= 0) {
+			break;
+		}
+
+		// seau (f, f) : des états finaux, le premier de l'ordre de par_candidat_avant
+		but = aucun;
+		for (int k = 0; seau.f == seau.g && k < r->nbThreads; k++) {
+			if (r->seaux[k].f == seau.f && r->seaux[k].g == seau.g && r->nbCandidats[k] > 0 &&
+				par_candidat_avant(&r->candidats[k][0], &but)) {
+				but = r->candidats[k][0];
+			}
+		}
+		if (but.cle != UINT64_MAX) {
+			resultat = SOLV_TROUVE;
+			break;
+		}
+
+		// les PAR_LARGEUR premiers états du seau, toutes tranches comprises ;
+		// une tranche dont le premier seau est plus loin n'en développe aucun
+		nbDeveloppes = 0;
+		if (local.f == seau.f && local.g == seau.g) {
+			limite = par_seuil(r, seau, &seuil);
+			while (nbDeveloppes < nbSeau && (!limite || !par_candidat_avant(&seuil, &c->seau[nbDeveloppes]))) {
+				nbDeveloppes++;
+			}
+		}
+		// les autres reviennent dans la file pour un tour suivant
+		for (int k = nbDeveloppes; k < nbSeau; k++) {
+			o.f = local.f;
+			o.g = local.g;
+			o.noeud = c->seau[k].noeud;
+			if (!par_empiler(t, o)) {
+				manque = true;
+			}
+		}
+
+		// expansions : les tranches ne sont que lues
+		arene_vider(&c->arene);
+		for (int k = 0; k < nbDeveloppes; k++) {
+			if (!par_developper(c, c->seau[k].noeud)) {
+				manque = true;
+				break;
+			}
+		}
+		developpes += nbDeveloppes;
+		barriere_attendre(&r->barriere);
+
+		// chaque thread range les états reçus dans sa tranche
+		for (m = atomic_exchange(&t->boite, NULL); m != NULL; m = m->suivant) {
+			if (!par_recevoir(t, m, r->s->codage.octets, &r->nbEtats)) {
+				manque = true;
+				break;
+			}
+		}
+	}
+	if (c->id == 0) {
+		r->resultat = resultat;
+		r->cleBut = but.cle;
+	}
+	atomic_fetch_add(&r->developpes, developpes);
+	atomic_fetch_add(&r->generes, c->generes);
+	return NULL;
+}
+
+/**
+* @brief recherche une solution avec le moins de poussées possible sur
+* plusieurs threads ; la solution est la même quel que soit leur nombre
+* @param s type : structure, entrée/sortie, solveur préparé par solv_init
+* @param nbThreads type : entier, entrée, nombre de threads
+* @param solution type : structure, sortie, déplacements de la solution
+* @return résultat : SOLV_TROUVE, SOLV_IMPOSSIBLE ou SOLV_LIMITE
+*/
+
+static inline int solv_resoudre_parallele(t_solveur *s, int nbThreads, t_historique *solution){
+	t_recherche *r;
+	t_chercheur *chercheurs;
+	pthread_t *threads;
+	t_message *depart;
+	t_etape *etapes = NULL;
+	t_tranche *t;
+	uint64_t cle;
+	int resultat = SOLV_LIMITE;
+	int joueur;
+	int i;
+	bool ok;
+	bool barriere = false; // barrière initialisée, à détruire
+
+	if (nbThreads < 1) {
+		nbThreads = 1;
+	}
+	if (nbThreads > PAR_MAXTHREADS) {
+		nbThreads = PAR_MAXTHREADS;
+	}
+	r = calloc(1, sizeof(t_recherche));
+	chercheurs = calloc(nbThreads, sizeof(t_chercheur));
+	threads = calloc(nbThreads, sizeof(pthread_t));
+	depart = malloc(sizeof(t_message) + s->codage.octets);
+	ok = r != NULL && chercheurs != NULL && threads != NULL && depart != NULL;
+	if (ok && solv_depart_mort(s)) {
+		free(r);
+		free(chercheurs);
+		free(threads);
+		free(depart);
+		return SOLV_IMPOSSIBLE;
+	}
+	if (ok) {
+		r->s = s;
+		r->nbThreads = nbThreads;
+		barriere_init(&r->barriere, nbThreads);
+		barriere = true;
+		for (int k = 0; k < nbThreads; k++) {
+			atomic_init(&r->tranches[k].boite, NULL);
+		}
+		atomic_init(&r->nbEtats, 0);
+		atomic_init(&r->developpes, 0);
+		atomic_init(&r->generes, 0);
+
+		// état de départ, rangé dans la tranche qui le possède
+		solv_poser_caisses(s, &s->travail, s->depart);
+		joueur = solv_coin(s, &s->travail, s->joueurDepart);
+		depart->cle = s->zJoueur[joueur];
+		depart->cleParent = 0;
+		depart->g = 0;
+		depart->coups = 0;
+		depart->poussee = -1;
+		for (int k = 0; k < s->nbCaisses; k++) {
+			depart->cle ^= s->zCaisse[s->depart[k]];
+		}
+		etat_coder(&s->codage, s->depart, joueur, depart->etat);
+		depart->h = solv_estimer(s, &s->travail, s->depart);
+		if (depart->h >= HEUR_INFINI) {
+			resultat = SOLV_IMPOSSIBLE; // aucune affectation possible dès le départ
+			ok = false;
+		}
+		ok = ok && par_recevoir(&r->tranches[par_proprietaire(depart->cle, nbThreads)], depart,
+			s->codage.octets, &r->nbEtats);
+	}
+
+	for (i = 0; ok && i < nbThreads; i++) {
+		chercheurs[i].r = r;
+		chercheurs[i].id = i;
+		arene_init(&chercheurs[i].arene);
+		chercheurs[i].poussees = malloc((4 * s->nbCaisses + 1) * sizeof(t_poussee));
+		ok = chercheurs[i].poussees != NULL && solv_travail_init(&chercheurs[i].travail, s->nbCases, s->nbCaisses) &&
+			affect_init(&chercheurs[i].travail.affectation, &s->poussees, s->nbCaisses);
+	}
+	if (ok) {
+		for (i = 0; i < nbThreads; i++) {
+			pthread_create(&threads[i], NULL, par_chercher_seaux, &chercheurs[i]);
+		}
+		for (i = 0; i < nbThreads; i++) {
+			pthread_join(threads[i], NULL);
+		}
+		resultat = r->resultat;
+		s->developpes = atomic_load(&r->developpes);
+		s->generes = atomic_load(&r->generes);
+	}
+
+	// remontée des parents depuis l'état final retenu
+	if (resultat == SOLV_TROUVE) {
+		t = &r->tranches[par_proprietaire(r->cleBut, nbThreads)];
+		i = par_chercher(t, r->cleBut);
+		etapes = malloc((t->etats[i].g + 1) * sizeof(t_etape));
+		resultat = SOLV_LIMITE;
+		if (etapes != NULL) {
+			int nbEtapes = t->etats[i].g;
+			for (int k = nbEtapes - 1; k >= 0; k--) {
+				etapes[k].caisse = t->etats[i].poussee / 4;
+				etapes[k].dir = t->etats[i].poussee % 4;
+				cle = t->etats[i].cleParent;
+				t = &r->tranches[par_proprietaire(cle, nbThreads)];
+				i = par_chercher(t, cle);
+			}
+			if (solv_ecrire_etapes(s, etapes, nbEtapes, solution)) {
+				resultat = SOLV_TROUVE;
+			}
+		}
+	}
+
+	free(etapes);
+	for (i = 0; chercheurs != NULL && i < nbThreads; i++) {
+		arene_liberer(&chercheurs[i].arene);
+		free(chercheurs[i].poussees);
+		free(chercheurs[i].seau);
+		solv_travail_liberer(&chercheurs[i].travail);
+	}
+	for (i = 0; r != NULL && i < nbThreads; i++) {
+		free(r->tranches[i].etats);
+		free(r->tranches[i].codes);
+		free(r->tranches[i].table);
+		free(r->tranches[i].ouverts);
+	}
+	if (barriere) {
+		barriere_detruire(&r->barriere);
+	}
+	free(r);
+	free(chercheurs);
+	free(threads);
+	free(depart);
+	return resultat;
+}
+
+#endif
@@ -0,0 +1,260 @@
+/**
+* @file transitions.h
+* @brief Table des changements de case d'un coup, commune à sokoban et jeuv2
+* @author Guillaume ANTOINES, Yanis RAULO
+* @version 1.0
+* @date 17/10/2026
+*
+* Un coup change au plus trois cases, et chaque changement ne dépend que du
+* caractère de la case et de ce qui s'y passe : le joueur part ou arrive, une
+* caisse part ou arrive. Le caractère est ramené à un type de case par
+* trans_types (un caractère inconnu compte comme une case vide), puis
+* trans_glyphes donne le nouveau caractère et trans_caisses ce que devient
+* le nombre de caisses hors cible. Un déplacement ou une poussée n'a ainsi
+* aucun test sur les caractères : deux lectures de table par case.
+*
+* Les tables sont des constantes initialisées à la compilation. Les lignes
+* des cases que l'action ne peut pas toucher (le joueur ne part pas d'une
+* caisse, rien n'arrive sur un mur) gardent le caractère du sol dessous, ou
+* le mur. L'annulation n'en a pas besoin : journal.h réécrit les caractères
+* gardés avant le coup.
+*
+* t_bilan compte ce qu'a fait une suite de coups appliquée d'un bloc
+* (appliquer_coups de sokoban.c, jouer_coups de jeuv2.c), sans affichage.
+*
+* trans_joueur_branches et trans_caisse_branches font le même travail par
+* des tests sur les caractères, comme avant la table : ce sont la référence
+* des mesures (sokoban -suite).
+*/
+
+#ifndef TRANSITIONS_H
+#define TRANSITIONS_H
+
+#include <stdbool.h>
+
+// Types de case : le bit 0 est la cible
+#define TRANS_VIDE 0 // ' '
+#define TRANS_CIBLE 1 // '.'
+#define TRANS_JOUEUR 2 // '@'
+#define TRANS_JOUEUR_CIBLE 3 // '+'
+#define TRANS_CAISSE 4 // '$'
+#define TRANS_CAISSE_CIBLE 5 // '*'
+#define TRANS_MUR 6 // '#'
+#define TRANS_TYPES 7
+
+// Actions sur une case
+#define TRANS_JOUEUR_PART 0 // le joueur quitte la case
+#define TRANS_JOUEUR_ARRIVE 1 // le joueur entre dans la case
+#define TRANS_CAISSE_PART 2 // la caisse quitte la case
+#define TRANS_CAISSE_ARRIVE 3 // la caisse entre dans la case
+#define TRANS_ACTIONS 4
+
+// type de chaque caractère, TRANS_VIDE pour les autres
+static const unsigned char trans_types[256] = {
+	[' '] = TRANS_VIDE,
+	['.'] = TRANS_CIBLE,
+	['@'] = TRANS_JOUEUR,
+	['+'] = TRANS_JOUEUR_CIBLE,
+	['$'] = TRANS_CAISSE,
+	['*'] = TRANS_CAISSE_CIBLE,
+	['#'] = TRANS_MUR,
+};
+
+// caractère de la case après l'action
+static const char trans_glyphes[TRANS_TYPES][TRANS_ACTIONS] = {
+	//                  joueur part, arrive, caisse part, arrive
+	[TRANS_VIDE]         = {' ', '@', ' ', '$'},
+	[TRANS_CIBLE]        = {'.', '+', '.', '*'},
+	[TRANS_JOUEUR]       = {' ', '@', ' ', '$'},
+	[TRANS_JOUEUR_CIBLE] = {'.', '+', '.', '*'},
+	[TRANS_CAISSE]       = {' ', '@', ' ', '$'},
+	[TRANS_CAISSE_CIBLE] = {'.', '+', '.', '*'},
+	[TRANS_MUR]          = {'#', '#', '#', '#'},
+};
+
+// changement du nombre de caisses hors cible après l'action
+static const signed char trans_caisses[TRANS_TYPES][TRANS_ACTIONS] = {
+	[TRANS_VIDE]         = {0, 0, 0, 1},
+	[TRANS_CIBLE]        = {0, 0, 0, 0},
+	[TRANS_JOUEUR]       = {0, 0, 0, 1},
+	[TRANS_JOUEUR_CIBLE] = {0, 0, 0, 0},
+	[TRANS_CAISSE]       = {0, 0, -1, 1},
+	[TRANS_CAISSE_CIBLE] = {0, 0, 0, 0},
+	[TRANS_MUR]          = {0, 0, 0, 0},
+};
+
+// la case contient une caisse
+static const bool trans_occupee[TRANS_TYPES] = {
+	[TRANS_CAISSE] = true,
+	[TRANS_CAISSE_CIBLE] = true,
+};
+
+// une caisse poussée peut entrer dans la case (ni mur ni caisse)
+static const bool trans_libre[TRANS_TYPES] = {
+	[TRANS_VIDE] = true,
+	[TRANS_CIBLE] = true,
+	[TRANS_JOUEUR] = true,
+	[TRANS_JOUEUR_CIBLE] = true,
+};
+
+//Définition du bilan d'une suite de coups appliquée d'un bloc
+typedef struct{
+	int nbLus; // caractères appliqués (arrêt au coup illégal ou à la victoire)
+	int nbCoups; // déplacements effectués, poussées comprises
+	int nbPoussees; // caisses poussées
+	int nbAnnulations; // retours 'u' effectués
+	int illegal; // indice du premier coup illégal (-1 si aucun)
+	int impasse; // indice de la première poussée vers une impasse (-1 si aucune)
+} t_bilan;
+
+/**
+* @brief remet un bilan à zéro
+* @param bilan type : structure, sortie, bilan
+* @return résultat : bilan vide, sans coup illégal ni impasse
+*/
+
+static inline void trans_bilan_init(t_bilan *bilan){
+	bilan->nbLus = 0;
+	bilan->nbCoups = 0;
+	bilan->nbPoussees = 0;
+	bilan->nbAnnulations = 0;
+	bilan->illegal = -1;
+	bilan->impasse = -1;
+}
+
+/**
+* @brief donne le type d'un caractère du plateau
+* @param c type : caractère, entrée, caractère de la case
+* @return résultat : type de case (TRANS_VIDE pour un caractère inconnu)
+*/
+
+static inline int trans_type(char c){
+	return trans_types[(unsigned char)c];
+}
+
+/**
+* @brief indique si la case contient une caisse ('$' ou '*')
+* @param c type : caractère, entrée, caractère de la case
+* @return résultat : vrai pour une caisse
+*/
+
+static inline bool trans_est_caisse(char c){
+	return trans_occupee[trans_type(c)];
+}
+
+/**
+* @brief indique si une caisse peut être poussée dans la case
+* @param c type : caractère, entrée, caractère de la case
+* @return résultat : faux pour un mur ou une caisse
+*/
+
+static inline bool trans_accueille(char c){
+	return trans_libre[trans_type(c)];
+}
+
+/**
+* @brief déplace le joueur d'une case à une case voisine, sans contrôle
+* @param plateau type : tableau, entrée/sortie, lignes du plateau
+* @param posx type : entier, entrée/sortie, ligne du joueur
+* @param posy type : entier, entrée/sortie, colonne du joueur
+* @param depx type : entier, entrée, ligne d'arrivée
+* @param depy type : entier, entrée, colonne d'arrivée
+* @return résultat : joueur sur la case d'arrivée
+*/
+
+static inline void trans_joueur(char **plateau, int *posx, int *posy, int depx, int depy){
+	char *depart = &plateau[*posx][*posy];
+	char *arrivee = &plateau[depx][depy];
+
+	*depart = trans_glyphes[trans_type(*depart)][TRANS_JOUEUR_PART];
+	*arrivee = trans_glyphes[trans_type(*arrivee)][TRANS_JOUEUR_ARRIVE];
+	*posx = depx;
+	*posy = depy;
+}
+
+/**
+* @brief déplace une caisse d'une case à une autre, sans contrôle
+* @param plateau type : tableau, entrée/sortie, lignes du plateau
+* @param depx type : entier, entrée, ligne de la caisse
+* @param depy type : entier, entrée, colonne de la caisse
+* @param casx type : entier, entrée, ligne d'arrivée de la caisse
+* @param casy type : entier, entrée, colonne d'arrivée de la caisse
+* @param nbCaisses type : entier, entrée/sortie, caisses hors cible
+* @return résultat : caisse sur la case d'arrivée
+*/
+
+static inline void trans_caisse(char **plateau, int depx, int depy, int casx, int casy, int *nbCaisses){
+	char *depart = &plateau[depx][depy];
+	char *arrivee = &plateau[casx][casy];
+	int typeDepart = trans_type(*depart);
+	int typeArrivee = trans_type(*arrivee);
+
+	*depart = trans_glyphes[typeDepart][TRANS_CAISSE_PART];
+	*arrivee = trans_glyphes[typeArrivee][TRANS_CAISSE_ARRIVE];
+	*nbCaisses += trans_caisses[typeDepart][TRANS_CAISSE_PART] +
+		trans_caisses[typeArrivee][TRANS_CAISSE_ARRIVE];
+}
+
+/**
+* @brief trans_joueur par des tests sur les caractères (référence)
+* @param plateau type : tableau, entrée/sortie, lignes du plateau
+* @param posx type : entier, entrée/sortie, ligne du joueur
+* @param posy type : entier, entrée/sortie, colonne du joueur
+* @param depx type : entier, entrée, ligne d'arrivée
+* @param depy type : entier, entrée, colonne d'arrivée
+* @return résultat : joueur sur la case d'arrivée
+*/
+
+static inline void trans_joueur_branches(char **plateau, int *posx, int *posy, int depx, int depy){
+	// si le joueur est déplacé depuis une cible
+	if (plateau[*posx][*posy] == '+') {
+		plateau[*posx][*posy] = '.';
+	}
+	else {
+		plateau[*posx][*posy] = ' ';
+	}
+	*posx = depx;
+	*posy = depy;
+	// si le joueur est déplacé sur une cible
+	if (plateau[depx][depy] == '.') {
+		plateau[depx][depy] = '+';
+	}
+	else {
+		plateau[depx][depy] = '@';
+	}
+}
+
+/**
+* @brief trans_caisse par des tests sur les caractères (référence)
+* @param plateau type : tableau, entrée/sortie, lignes du plateau
+* @param depx type : entier, entrée, ligne de la caisse
+* @param depy type : entier, entrée, colonne de la caisse
+* @param casx type : entier, entrée, ligne d'arrivée de la caisse
+* @param casy type : entier, entrée, colonne d'arrivée de la caisse
+* @param nbCaisses type : entier, entrée/sortie, caisses hors cible
+* @return résultat : caisse sur la case d'arrivée
+*/
+
+static inline void trans_caisse_branches(char **plateau, int depx, int depy, int casx, int casy, int *nbCaisses){
+	// la caisse quitte une case hors cible
+	if (plateau[depx][depy] == '$') {
+		(*nbCaisses)--;
+	}
+	// si la caisse est déplacée depuis une cible
+	if (plateau[depx][depy] == '*') {
+		plateau[depx][depy] = '.';
+	}
+	else {
+		plateau[depx][depy] = ' ';
+	}
+	// si la caisse est déplacée sur une cible
+	if (plateau[casx][casy] == '.') {
+		plateau[casx][casy] = '*';
+	}
+	else {
+		plateau[casx][casy] = '$';
+		(*nbCaisses)++;
+	}
+}
+
+#endif